@@ -0,0 +1,837 @@
+#include "AsyncHttpServer.h"
+
+static_assert(ASYNC_HTTP_MAX_CONNECTIONS + SSE_MAX_CLIENTS <= MEMP_NUM_TCP_PCB, "more connections than lwIP has pcbs");
+static_assert(ASYNC_HTTP_MAX_BODY <= 0xFFFF, "a part must fit the 4 digit chunk size of _nextPart()");
+
+// Prints into the body queue of a connection, for the parts of sendParts()
+class AsyncHttpPart : public Print {
+public:
+  AsyncHttpPart(AsyncHttpServer *server, AsyncHttpConnection *c) : _server(server), _c(c) {}
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size) { return _server->_queue(_c, (PGM_P)buffer, size) ? size : 0; }
+protected:
+  AsyncHttpServer *_server;
+  AsyncHttpConnection *_c;
+};
+
+/***
+ * AsyncHttpServer class implementation
+ */
+
+AsyncHttpServer::AsyncHttpServer(uint16_t port) {
+  _port = port;
+  _listen = NULL;
+  _routes = 0;
+  _notFound = NULL;
+  _headerCount = 0;
+  _current = NULL;
+  _sent = false;
+  _aborted = false;
+  _contentLength = 0;
+  _extra[0] = 0;
+  _extraLen = 0;
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_CONNECTIONS; i++) {
+    _connections[i].server = this;
+    _connections[i].pcb = NULL;
+    _connections[i].rx = NULL;
+    _connections[i].heap = NULL;
+    _connections[i].heapSize = 0;
+    _connections[i].state = ASYNC_HTTP_FREE;
+  }
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_PENDING; i++) {
+    _pending[i].server = this;
+    _pending[i].pcb = NULL;
+  }
+}
+
+void AsyncHttpServer::begin() {
+  tcp_pcb *pcb = tcp_new();
+
+  if (!pcb)
+    return;
+  if (tcp_bind(pcb, IP_ADDR_ANY, _port) != ERR_OK) {
+    tcp_close(pcb);
+    return;
+  }
+  _listen = tcp_listen(pcb);
+  if (!_listen) {
+    tcp_close(pcb);
+    return;
+  }
+  // A new client does not kill a connection being served, see _onAccept()
+  tcp_setprio(_listen, TCP_PRIO_MIN);
+  tcp_arg(_listen, this);
+  tcp_accept(_listen, &_onAccept);
+}
+
+void AsyncHttpServer::on(const char *uri, THandlerFunction handler) {
+  if (_routes >= ASYNC_HTTP_MAX_ROUTES)
+    return;
+  _uris[_routes] = uri;
+  _handlers[_routes] = handler;
+  _routes++;
+}
+
+void AsyncHttpServer::collectHeaders(const char **names, size_t count) {
+  _headerCount = 0;
+  while ((_headerCount < ASYNC_HTTP_MAX_HEADERS) && (_headerCount < count)) {
+    _headerNames[_headerCount] = names[_headerCount];
+    _headerCount++;
+  }
+}
+
+void AsyncHttpServer::handleClient() {
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_CONNECTIONS; i++) {
+    AsyncHttpConnection *c = &_connections[i];
+    // One request per connection and pass
+    if (c->state == ASYNC_HTTP_READY) {
+      _dispatch(c);
+    } else if (c->state == ASYNC_HTTP_SEND) {
+      // The next part once the one before is in the send buffer
+      if (c->content && (c->txSent == c->txLen) && (!c->body || (c->bodySent == c->bodyLen)))
+        _nextPart(c);
+      if (c->state == ASYNC_HTTP_SEND)
+        _pump(c);
+    }
+  }
+  if (!pending())
+    return;
+  // Idle keep-alive connections make room for the parked clients. Not
+  // at once, the client may be sending its next request just now; a new
+  // connection that has not sent its request yet is left alone.
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_CONNECTIONS; i++) {
+    AsyncHttpConnection *c = &_connections[i];
+    if (c->requests && _idle(c) && (millis() - c->since >= ASYNC_HTTP_IDLE_PARKED))
+      _close(c);
+  }
+}
+
+uint8_t AsyncHttpServer::count() {
+  uint8_t n = 0;
+
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_CONNECTIONS; i++) {
+    if (_connections[i].state != ASYNC_HTTP_FREE)
+      n++;
+  }
+
+  return n;
+}
+
+uint8_t AsyncHttpServer::pending() {
+  uint8_t n = 0;
+
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_PENDING; i++) {
+    if (_pending[i].pcb)
+      n++;
+  }
+
+  return n;
+}
+
+const char *AsyncHttpServer::uri() {
+  uint8_t i = 0;
+
+  if (!_current)
+    return "";
+  while (_current->target[i] && (_current->target[i] != '?')) {
+    _path[i] = _current->target[i];
+    i++;
+  }
+  _path[i] = 0;
+
+  return _path;
+}
+
+const char *AsyncHttpServer::arg(const char *name) {
+  uint8_t len, n = 0;
+  const char *p = _find(name, &len);
+
+  // Percent-decoded into _arg
+  while (p && len && (n < ASYNC_HTTP_ARG_SIZE - 1)) {
+    if ((*p == '%') && (len >= 3) && isxdigit(p[1]) && isxdigit(p[2])) {
+      char hex[3] = { p[1], p[2], 0 };
+      _arg[n++] = strtol(hex, NULL, 16);
+      p += 3;
+      len -= 3;
+    } else {
+      _arg[n++] = (*p == '+') ? ' ' : *p;
+      p++;
+      len--;
+    }
+  }
+  _arg[n] = 0;
+
+  return _arg;
+}
+
+bool AsyncHttpServer::hasArg(const char *name) {
+  uint8_t len;
+
+  return _find(name, &len) != NULL;
+}
+
+const char *AsyncHttpServer::header(const char *name) {
+  if (!_current)
+    return "";
+  for (uint8_t i = 0; i < _headerCount; i++) {
+    if (!strcasecmp(name, _headerNames[i]))
+      return _current->headers[i];
+  }
+
+  return "";
+}
+
+void AsyncHttpServer::sendHeader(const char *name, const char *value) {
+  int n = snprintf(_extra + _extraLen, sizeof(_extra) - _extraLen, "%s: %s\r\n", name, value);
+
+  // A header that does not fit is dropped whole
+  if ((n > 0) && (_extraLen + n < (int)sizeof(_extra)))
+    _extraLen += n;
+  else
+    _extra[_extraLen] = 0;
+}
+
+void AsyncHttpServer::send(int code, const char *type, const char *content) {
+  send(code, type, content, content ? strlen(content) : 0);
+}
+
+void AsyncHttpServer::send(int code, const char *type, const char *content, size_t length) {
+  AsyncHttpConnection *c = _current;
+
+  if (!c || _sent)
+    return;
+  _sent = true;
+  if (_contentLength == CONTENT_LENGTH_UNKNOWN) {
+    // Chunked on a kept connection, else the close ends the body
+    c->chunked = c->keepAlive;
+    if (!_header(c, code, type, CONTENT_LENGTH_UNKNOWN))
+      _fail(c);
+    else if (length)
+      sendContent_P(content, length);
+    return;
+  }
+  if (!_header(c, code, type, length) || (c->txLen + length > ASYNC_HTTP_TX_SIZE)) {
+    _fail(c);
+  } else if (length) {
+    memcpy(c->tx + c->txLen, content, length);
+    c->txLen += length;
+  }
+}
+
+void AsyncHttpServer::send_P(int code, PGM_P type, PGM_P content, size_t length) {
+  AsyncHttpConnection *c = _current;
+
+  if (!c || _sent)
+    return;
+  _sent = true;
+  if (!_header(c, code, type, length)) {
+    _fail(c);
+    return;
+  }
+  c->body = content;
+  c->bodyLen = length;
+}
+
+// An empty piece ends the body, as the last chunk does with ESP8266WebServer
+void AsyncHttpServer::sendContent_P(PGM_P content, size_t length) {
+  AsyncHttpConnection *c = _current;
+  char size[8];
+
+  if (!c || !_sent || (_contentLength != CONTENT_LENGTH_UNKNOWN) || c->ended)
+    return;
+  // Nothing has gone out during the handler, a body that does not fit
+  // is answered with 500 rather than cut
+  if (!length) {
+    if (!_end(c))
+      _fail(c);
+    return;
+  }
+  sprintf(size, "%x\r\n", (unsigned)length);
+  if (c->chunked)
+    _queue(c, size, strlen(size));
+  _queue(c, content, length);
+  if (c->chunked)
+    _queue(c, "\r\n", 2);
+  if (c->overflow)
+    _fail(c);
+}
+
+void AsyncHttpServer::sendParts(int code, const char *type, AsyncHttpContentFunction content) {
+  AsyncHttpConnection *c = _current;
+
+  if (!c || _sent)
+    return;
+  _sent = true;
+  c->chunked = c->keepAlive;
+  if (!_header(c, code, type, CONTENT_LENGTH_UNKNOWN)) {
+    _fail(c);
+    return;
+  }
+  c->content = content;
+  c->part = 0;
+}
+
+void AsyncHttpServer::_dispatch(AsyncHttpConnection *c) {
+  const char *path;
+  uint8_t i;
+
+  // A parked client gets the connection after this response
+  if ((++c->requests >= ASYNC_HTTP_MAX_REQUESTS) || pending())
+    c->keepAlive = false;
+  _current = c;
+  _sent = false;
+  _contentLength = 0;
+  _extra[0] = 0;
+  _extraLen = 0;
+  if (c->status) {
+    // A body that was not read would be taken for the next request
+    c->keepAlive = false;
+    send(c->status);
+  } else {
+    path = uri();
+    for (i = 0; i < _routes; i++) {
+      if (!strcmp(path, _uris[i]))
+        break;
+    }
+    if (i < _routes)
+      _handlers[i]();
+    else if (_notFound)
+      _notFound();
+    else
+      send(404);
+  }
+  if (!_sent)
+    send(500);
+  // Pieces without the empty one at the end
+  if ((_contentLength == CONTENT_LENGTH_UNKNOWN) && !c->ended && !_end(c))
+    _fail(c);
+  _current = NULL;
+  c->state = ASYNC_HTTP_SEND;
+  c->since = millis();
+  if (c->content)
+    _nextPart(c);
+  if (c->state == ASYNC_HTTP_SEND)
+    _pump(c);
+}
+
+// Consumes the received data up to the end of a request.
+// Returns true once the request is complete.
+bool AsyncHttpServer::_parse(AsyncHttpConnection *c) {
+  while (c->rx && (c->state == ASYNC_HTTP_READ)) {
+    uint16_t offset = c->rxOffset;
+    pbuf *q = c->rx;
+    while (q && (offset >= q->len)) {
+      offset -= q->len;
+      q = q->next;
+    }
+    if (!q) {
+      // All parsed, the window opens again
+      tcp_recved(c->pcb, c->rx->tot_len);
+      pbuf_free(c->rx);
+      c->rx = NULL;
+      c->rxOffset = 0;
+      break;
+    }
+    char ch = ((const char *)q->payload)[offset];
+    c->rxOffset++;
+    if (ch == '\n') {
+      c->line[c->lineLen] = 0;
+      _parseLine(c);
+      c->lineLen = 0;
+    } else if (ch != '\r') {
+      if (c->lineLen < ASYNC_HTTP_LINE_SIZE - 1)
+        c->line[c->lineLen++] = ch;
+      else if (c->requestLine)
+        c->status = 414;
+    }
+  }
+
+  return c->state == ASYNC_HTTP_READY;
+}
+
+void AsyncHttpServer::_parseLine(AsyncHttpConnection *c) {
+  char *line = c->line;
+  char *p;
+
+  if (c->requestLine) {
+    // Empty lines before the request are allowed
+    if (!c->lineLen)
+      return;
+    c->requestLine = false;
+    p = strchr(line, ' ');
+    if (!p) {
+      c->status = 400;
+      return;
+    }
+    *p++ = 0;
+    if (strcmp(line, "GET") && !c->status)
+      c->status = 405;
+    line = p;
+    p = strchr(line, ' ');
+    if (p)
+      *p++ = 0;
+    strcpy(c->target, line);
+    // HTTP/1.1 keeps the connection, HTTP/1.0 closes it
+    c->keepAlive = p && !strcmp(p, "HTTP/1.1");
+    return;
+  }
+  if (!c->lineLen) {
+    c->state = ASYNC_HTTP_READY;
+    return;
+  }
+  p = strchr(line, ':');
+  if (!p)
+    return;
+  *p++ = 0;
+  while (*p == ' ')
+    p++;
+  if (!strcasecmp(line, "Connection")) {
+    if (!strcasecmp(p, "close"))
+      c->keepAlive = false;
+    else if (!strcasecmp(p, "keep-alive"))
+      c->keepAlive = true;
+  }
+  for (uint8_t i = 0; i < _headerCount; i++) {
+    if (!strcasecmp(line, _headerNames[i])) {
+      strncpy(c->headers[i], p, ASYNC_HTTP_HEADER_SIZE - 1);
+      c->headers[i][ASYNC_HTTP_HEADER_SIZE - 1] = 0;
+    }
+  }
+}
+
+bool AsyncHttpServer::_header(AsyncHttpConnection *c, int code, const char *type, size_t length) {
+  char framing[32] = "";
+  int n;
+
+  if (length != CONTENT_LENGTH_UNKNOWN)
+    sprintf(framing, "Content-Length: %u\r\n", (unsigned)length);
+  else if (c->chunked)
+    strcpy(framing, "Transfer-Encoding: chunked\r\n");
+  n = snprintf(c->tx, ASYNC_HTTP_TX_SIZE,
+    "HTTP/1.1 %d %s\r\n%s%s%s%sConnection: %s\r\n%s\r\n",
+    code, _reason(code),
+    type ? "Content-Type: " : "", type ? type : "", type ? "\r\n" : "",
+    framing, c->keepAlive ? "keep-alive" : "close", _extra);
+
+  c->txLen = 0;
+  c->txSent = 0;
+  c->body = NULL;
+  c->bodyLen = 0;
+  c->bodySent = 0;
+  c->ended = false;
+  c->overflow = false;
+  c->content = NULL;
+  if ((n <= 0) || (n >= ASYNC_HTTP_TX_SIZE))
+    return false;
+  c->txLen = n;
+
+  return true;
+}
+
+// The response becomes an empty 500, before any of it has gone out
+void AsyncHttpServer::_fail(AsyncHttpConnection *c) {
+  _extra[0] = 0;
+  _contentLength = 0;
+  _header(c, 500, NULL, 0);
+}
+
+// Appends to the body on the heap. False once the body passed
+// ASYNC_HTTP_MAX_BODY or the heap ran out, then overflow stays set.
+bool AsyncHttpServer::_queue(AsyncHttpConnection *c, PGM_P data, size_t length) {
+  uint16_t size;
+  char *p;
+
+  if (c->overflow || (c->bodyLen + length > ASYNC_HTTP_MAX_BODY)) {
+    c->overflow = true;
+    return false;
+  }
+  if (c->bodyLen + length > c->heapSize) {
+    // Doubled, many small pieces cost only a few reallocations
+    size = c->heapSize ? c->heapSize : 256;
+    while (size < c->bodyLen + length)
+      size *= 2;
+    p = (char *)realloc(c->heap, size);
+    if (!p) {
+      c->overflow = true;
+      return false;
+    }
+    c->heap = p;
+    c->heapSize = size;
+  }
+  memcpy_P(c->heap + c->bodyLen, data, length);
+  c->bodyLen += length;
+  c->body = c->heap;
+
+  return true;
+}
+
+// Queues the last chunk, false if it did not fit
+bool AsyncHttpServer::_end(AsyncHttpConnection *c) {
+  c->ended = true;
+
+  return !c->chunked || _queue(c, "0\r\n\r\n", 5);
+}
+
+// Prints the next part of a sendParts() body as one chunk, into the
+// drained queue. The status line is out already: a part that does not
+// fit resets the connection, so the client sees a broken body rather
+// than a short one.
+void AsyncHttpServer::_nextPart(AsyncHttpConnection *c) {
+  AsyncHttpPart out(this, c);
+  uint16_t length;
+  char size[8];
+  bool more;
+
+  c->body = NULL;
+  c->bodyLen = 0;
+  c->bodySent = 0;
+  // The chunk size is filled in once the part is printed
+  if (c->chunked)
+    _queue(c, "0000\r\n", 6);
+  more = c->content(out, c->part++);
+  length = c->overflow ? 0 : c->bodyLen - (c->chunked ? 6 : 0);
+  if (!length) {
+    // An empty chunk would end the body
+    c->bodyLen = 0;
+  } else if (c->chunked) {
+    sprintf(size, "%04x", length);
+    memcpy(c->heap, size, 4);
+    _queue(c, "\r\n", 2);
+  }
+  if (!more) {
+    c->content = NULL;
+    _end(c);
+  }
+  if (!c->overflow)
+    return;
+  tcp_arg(c->pcb, NULL);
+  tcp_recv(c->pcb, NULL);
+  tcp_sent(c->pcb, NULL);
+  tcp_err(c->pcb, NULL);
+  tcp_poll(c->pcb, NULL, 0);
+  tcp_abort(c->pcb);
+  _free(c);
+}
+
+// Queues as much of the response as the send buffer takes
+void AsyncHttpServer::_pump(AsyncHttpConnection *c) {
+  char chunk[256];
+  bool progress = false;
+
+  for (;;) {
+    uint16_t room = tcp_sndbuf(c->pcb);
+    uint16_t n;
+    if (c->txSent < c->txLen) {
+      n = min((int)room, c->txLen - c->txSent);
+      if (!n || (tcp_write(c->pcb, c->tx + c->txSent, n, TCP_WRITE_FLAG_COPY) != ERR_OK))
+        break;
+      c->txSent += n;
+    } else if (c->body && (c->bodySent < c->bodyLen)) {
+      n = min((int)room, min((int)sizeof(chunk), c->bodyLen - c->bodySent));
+      // Flash is read in words, the body goes through a buffer in RAM
+      memcpy_P(chunk, c->body + c->bodySent, n);
+      if (!n || (tcp_write(c->pcb, chunk, n, TCP_WRITE_FLAG_COPY) != ERR_OK))
+        break;
+      c->bodySent += n;
+    } else {
+      break;
+    }
+    progress = true;
+  }
+  if (progress) {
+    tcp_output(c->pcb);
+    c->since = millis();
+  }
+  if ((c->txSent == c->txLen) && (!c->body || (c->bodySent == c->bodyLen)) && !c->content)
+    _finish(c);
+}
+
+void AsyncHttpServer::_finish(AsyncHttpConnection *c) {
+  c->since = millis();
+  if (!c->keepAlive) {
+    _close(c);
+    return;
+  }
+  _reset(c);
+  // A pipelined request may be waiting already
+  if (!_parse(c) && c->peerClosed)
+    _close(c);
+}
+
+void AsyncHttpServer::_reset(AsyncHttpConnection *c) {
+  c->state = ASYNC_HTTP_READ;
+  c->requestLine = true;
+  c->lineLen = 0;
+  c->target[0] = 0;
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_HEADERS; i++)
+    c->headers[i][0] = 0;
+  c->status = 0;
+  c->keepAlive = false;
+  c->txLen = 0;
+  c->txSent = 0;
+  c->body = NULL;
+  c->chunked = false;
+  c->ended = false;
+  c->overflow = false;
+  c->content = NULL;
+  free(c->heap);
+  c->heap = NULL;
+  c->heapSize = 0;
+}
+
+void AsyncHttpServer::_close(AsyncHttpConnection *c) {
+  tcp_pcb *pcb = c->pcb;
+
+  tcp_arg(pcb, NULL);
+  tcp_recv(pcb, NULL);
+  tcp_sent(pcb, NULL);
+  tcp_err(pcb, NULL);
+  tcp_poll(pcb, NULL, 0);
+  if (tcp_close(pcb) != ERR_OK) {
+    tcp_abort(pcb);
+    _aborted = true;
+  }
+  _free(c);
+}
+
+void AsyncHttpServer::_free(AsyncHttpConnection *c) {
+  if (c->rx)
+    pbuf_free(c->rx);
+  c->rx = NULL;
+  free(c->heap);
+  c->heap = NULL;
+  c->heapSize = 0;
+  c->pcb = NULL;
+  c->state = ASYNC_HTTP_FREE;
+  _promote();
+}
+
+void AsyncHttpServer::_attach(AsyncHttpConnection *c, tcp_pcb *pcb) {
+  c->pcb = pcb;
+  c->rx = NULL;
+  c->rxOffset = 0;
+  c->requests = 0;
+  c->peerClosed = false;
+  c->since = millis();
+  _reset(c);
+  tcp_arg(pcb, c);
+  tcp_recv(pcb, &_onRecv);
+  tcp_sent(pcb, &_onSent);
+  tcp_err(pcb, &_onError);
+  tcp_poll(pcb, &_onPoll, 2); // every second
+  tcp_nagle_disable(pcb);
+}
+
+// Keeps the pcb without taking its data. False if the queue is full.
+bool AsyncHttpServer::_park(tcp_pcb *pcb) {
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_PENDING; i++) {
+    AsyncHttpPending *q = &_pending[i];
+    if (q->pcb)
+      continue;
+    q->pcb = pcb;
+    q->since = millis();
+    tcp_arg(pcb, q);
+    tcp_recv(pcb, &_onPendingRecv);
+    tcp_err(pcb, &_onPendingError);
+    return true;
+  }
+
+  return false;
+}
+
+void AsyncHttpServer::_unpark(AsyncHttpPending *q) {
+  tcp_arg(q->pcb, NULL);
+  tcp_recv(q->pcb, NULL);
+  tcp_err(q->pcb, NULL);
+  q->pcb = NULL;
+}
+
+// The longest parked client takes a free connection. lwIP offers the
+// request it held back again to the new recv callback.
+void AsyncHttpServer::_promote() {
+  AsyncHttpPending *oldest = NULL;
+  tcp_pcb *pcb;
+
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_PENDING; i++) {
+    AsyncHttpPending *q = &_pending[i];
+    if (q->pcb && (!oldest || ((int32_t)(q->since - oldest->since) < 0)))
+      oldest = q;
+  }
+  if (!oldest)
+    return;
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_CONNECTIONS; i++) {
+    AsyncHttpConnection *c = &_connections[i];
+    if (c->state != ASYNC_HTTP_FREE)
+      continue;
+    pcb = oldest->pcb;
+    _unpark(oldest);
+    _attach(c, pcb);
+    return;
+  }
+}
+
+bool AsyncHttpServer::_idle(const AsyncHttpConnection *c) {
+  return (c->state == ASYNC_HTTP_READ) && c->requestLine && !c->lineLen && !c->rx;
+}
+
+// Value of an argument in the query, not decoded
+const char *AsyncHttpServer::_find(const char *name, uint8_t *len) {
+  size_t nameLen = strlen(name);
+  const char *p;
+
+  if (!_current)
+    return NULL;
+  p = strchr(_current->target, '?');
+  while (p) {
+    p++;
+    const char *end = strchr(p, '&');
+    if (!end)
+      end = p + strlen(p);
+    if (!strncmp(p, name, nameLen) && ((p[nameLen] == '=') || (p + nameLen == end))) {
+      p += nameLen;
+      if (*p == '=')
+        p++;
+      *len = end - p;
+      return p;
+    }
+    p = *end ? end : NULL;
+  }
+
+  return NULL;
+}
+
+const char *AsyncHttpServer::_reason(int code) {
+  switch (code) {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 414: return "URI Too Long";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    case 507: return "Insufficient Storage";
+    default: return "";
+  }
+}
+
+err_t AsyncHttpServer::_onAccept(void *arg, tcp_pcb *pcb, err_t err) {
+  AsyncHttpServer *server = (AsyncHttpServer *)arg;
+
+  tcp_accepted(server->_listen);
+  if ((err != ERR_OK) || !pcb)
+    return ERR_VAL;
+  // Above the listener, the next SYN can not take this pcb
+  tcp_setprio(pcb, TCP_PRIO_NORMAL);
+  for (uint8_t i = 0; i < ASYNC_HTTP_MAX_CONNECTIONS; i++) {
+    AsyncHttpConnection *c = &server->_connections[i];
+    if (c->state != ASYNC_HTTP_FREE)
+      continue;
+    server->_attach(c, pcb);
+    return ERR_OK;
+  }
+  if (server->_park(pcb))
+    return ERR_OK;
+  tcp_abort(pcb);
+
+  return ERR_ABRT;
+}
+
+err_t AsyncHttpServer::_onRecv(void *arg, tcp_pcb *pcb, pbuf *p, err_t err) {
+  AsyncHttpConnection *c = (AsyncHttpConnection *)arg;
+  AsyncHttpServer *server = c->server;
+
+  (void)pcb;
+  (void)err;
+  server->_aborted = false;
+  if (!p) {
+    // The client closed its side. A request it sent is still answered,
+    // _finish() closes after the response; a request cut short never
+    // completes.
+    c->peerClosed = true;
+    if (c->state == ASYNC_HTTP_READ)
+      server->_close(c);
+    return server->_aborted ? ERR_ABRT : ERR_OK;
+  }
+  if (c->rx) {
+    pbuf_cat(c->rx, p);
+  } else {
+    c->rx = p;
+    c->rxOffset = 0;
+  }
+  if (c->state == ASYNC_HTTP_READ)
+    server->_parse(c);
+
+  return ERR_OK;
+}
+
+err_t AsyncHttpServer::_onSent(void *arg, tcp_pcb *pcb, u16_t len) {
+  AsyncHttpConnection *c = (AsyncHttpConnection *)arg;
+  AsyncHttpServer *server = c->server;
+
+  (void)pcb;
+  (void)len;
+  server->_aborted = false;
+  if (c->state == ASYNC_HTTP_SEND)
+    server->_pump(c);
+
+  return server->_aborted ? ERR_ABRT : ERR_OK;
+}
+
+err_t AsyncHttpServer::_onPoll(void *arg, tcp_pcb *pcb) {
+  AsyncHttpConnection *c = (AsyncHttpConnection *)arg;
+  AsyncHttpServer *server = c->server;
+  uint32_t elapsed = millis() - c->since;
+  uint32_t limit;
+
+  (void)pcb;
+  if (c->state == ASYNC_HTTP_READY)
+    return ERR_OK;
+  // Idle between requests, or too slow receiving a request or taking the response
+  if (_idle(c))
+    limit = ASYNC_HTTP_IDLE;
+  else
+    limit = ASYNC_HTTP_TIMEOUT;
+  if (elapsed < limit)
+    return ERR_OK;
+  server->_aborted = false;
+  server->_close(c);
+
+  return server->_aborted ? ERR_ABRT : ERR_OK;
+}
+
+void AsyncHttpServer::_onError(void *arg, err_t err) {
+  AsyncHttpConnection *c = (AsyncHttpConnection *)arg;
+
+  (void)err;
+  // lwIP has freed the pcb already
+  if (c)
+    c->server->_free(c);
+}
+
+err_t AsyncHttpServer::_onPendingRecv(void *arg, tcp_pcb *pcb, pbuf *p, err_t err) {
+  AsyncHttpPending *q = (AsyncHttpPending *)arg;
+
+  (void)err;
+  if (p) {
+    // Not taken, lwIP keeps it and offers it again
+    return ERR_MEM;
+  }
+  // Gone before its turn
+  q->server->_unpark(q);
+  if (tcp_close(pcb) != ERR_OK) {
+    tcp_abort(pcb);
+    return ERR_ABRT;
+  }
+
+  return ERR_OK;
+}
+
+void AsyncHttpServer::_onPendingError(void *arg, err_t err) {
+  AsyncHttpPending *q = (AsyncHttpPending *)arg;
+
+  (void)err;
+  if (q)
+    q->pcb = NULL;
+}
@@ -0,0 +1,186 @@
+#ifndef __ASYNCHTTPSERVER_H
+#define __ASYNCHTTPSERVER_H
+
+#include <Arduino.h>
+#include "SseServer.h"
+
+extern "C" {
+#include "lwip/tcp.h"
+}
+
+// lwIP of the ESP8266 core has 5 TCP connections (MEMP_NUM_TCP_PCB) for
+// everything, the event streams keep theirs. A client that finds all
+// connections busy is parked without reading its request, up to
+// ASYNC_HTTP_MAX_PENDING, and served when a connection frees up; one
+// more is aborted. Once the pool is used up, lwIP has no pcb for a new
+// client and it waits in the listen backlog: the listener has the
+// lowest priority, so its SYN does not kill a connection being served.
+#define ASYNC_HTTP_MAX_CONNECTIONS (MEMP_NUM_TCP_PCB - SSE_MAX_CLIENTS)
+#define ASYNC_HTTP_MAX_PENDING     2
+#define ASYNC_HTTP_MAX_ROUTES      24
+#define ASYNC_HTTP_MAX_HEADERS     2       // Request headers kept, see collectHeaders()
+#define ASYNC_HTTP_LINE_SIZE       128     // Longest request line, longer header lines are cut
+#define ASYNC_HTTP_HEADER_SIZE     48      // Longest value of a collected header
+#define ASYNC_HTTP_TX_SIZE         384     // Status line, headers and a copied body
+#define ASYNC_HTTP_EXTRA_SIZE      96      // Headers added with sendHeader()
+#define ASYNC_HTTP_ARG_SIZE        32      // Longest decoded argument value
+#define ASYNC_HTTP_TIMEOUT         5000UL  // A request must be complete within this, ms
+#define ASYNC_HTTP_IDLE            10000UL // Idle keep-alive connections are closed after this, ms
+#define ASYNC_HTTP_IDLE_PARKED     1000UL  // The same while clients are parked, ms
+#define ASYNC_HTTP_MAX_REQUESTS    100     // Requests per connection, then it is closed
+#define ASYNC_HTTP_MAX_BODY        16384   // Longest body collected from sendContent(), or part of sendParts()
+
+#ifndef CONTENT_LENGTH_UNKNOWN
+#define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
+#endif
+
+#define ASYNC_HTTP_FREE    0
+#define ASYNC_HTTP_READ    1 // Reading the request line and headers
+#define ASYNC_HTTP_READY   2 // Request complete, waits for handleClient()
+#define ASYNC_HTTP_SEND    3 // Response goes out as the send buffer allows
+
+class AsyncHttpServer;
+
+// Prints part 'part' of a body for sendParts(), parts count from 0.
+// Returns false, without printing, when there is no such part.
+typedef bool (*AsyncHttpContentFunction)(Print& out, uint16_t part);
+
+struct AsyncHttpConnection {
+  AsyncHttpServer *server;
+  tcp_pcb *pcb;
+  pbuf *rx;          // Received and not yet parsed
+  uint16_t rxOffset; // Parsed bytes of the rx chain
+  uint8_t state;
+  uint8_t requests;
+  bool keepAlive;
+  bool peerClosed;   // The client closed its side, closed after the responses
+  bool requestLine;  // Next line is the request line
+  uint8_t lineLen;
+  char line[ASYNC_HTTP_LINE_SIZE];
+  char target[ASYNC_HTTP_LINE_SIZE]; // Path and query
+  char headers[ASYNC_HTTP_MAX_HEADERS][ASYNC_HTTP_HEADER_SIZE];
+  uint16_t status;   // Error found while parsing, 0 if none
+  char tx[ASYNC_HTTP_TX_SIZE];
+  uint16_t txLen;
+  uint16_t txSent;
+  PGM_P body;        // Flash body after tx, NULL if none
+  uint16_t bodyLen;
+  uint16_t bodySent;
+  char *heap;        // Body from sendContent() or the current part, NULL if none
+  uint16_t heapSize;
+  bool chunked;      // Body of unknown length with the chunk framing, else up to the close
+  bool ended;        // The last chunk is queued
+  bool overflow;     // The body did not fit in ASYNC_HTTP_MAX_BODY
+  AsyncHttpContentFunction content; // Prints the parts still to send, NULL if none
+  uint16_t part;     // Next part
+  uint32_t since;    // millis() at the accept, the last response or the last progress sending
+};
+
+// Accepted while every connection was busy, its data stays with lwIP
+struct AsyncHttpPending {
+  AsyncHttpServer *server;
+  tcp_pcb *pcb;      // NULL if the entry is free
+  uint32_t since;    // millis() at the accept, the oldest is served first
+};
+
+// HTTP/1.1 server over the raw lwIP TCP callbacks.
+// The callbacks only collect the request line and the collected
+// headers, the handlers run from handleClient() in loop(), one request
+// per connection and pass, so no client holds up the others.
+// The responses go out from handleClient() and from the sent
+// callback as fast as the send buffer frees up, nothing ever waits
+// for a client. Connections are kept alive unless the client says
+// otherwise or a parked client waits for one: then the connection is
+// closed after its response, or after ASYNC_HTTP_IDLE_PARKED if idle.
+// A client that closes its side still gets the responses to the
+// requests it sent, the connection is closed after the last one.
+// Routes and request accessors follow ESP8266WebServer, but arg()
+// and header() return plain strings that live until the next call.
+// Only GET is served, a request body is not read.
+// A handler that does not know the length up front calls
+// setContentLength(CONTENT_LENGTH_UNKNOWN), send() and then
+// sendContent() in pieces. The pieces are collected on the heap, a
+// body over ASYNC_HTTP_MAX_BODY answers 500 instead. A longer body
+// goes through sendParts(): its parts are printed from handleClient()
+// one at a time, each once the one before is in the send buffer, so
+// only one part is ever held. Both are chunked on a kept connection,
+// otherwise the connection is closed after the body.
+class AsyncHttpServer {
+public:
+  typedef void (*THandlerFunction)();
+
+  AsyncHttpServer(uint16_t port);
+  void begin();
+  void on(const char *uri, THandlerFunction handler);
+  void onNotFound(THandlerFunction handler) { _notFound = handler; }
+  void collectHeaders(const char **names, size_t count);
+  void handleClient();
+  uint8_t count();   // Open connections
+  uint8_t pending(); // Parked connections
+  // Current request, valid inside a handler
+  const char *uri();
+  const char *arg(const char *name);
+  bool hasArg(const char *name);
+  const char *header(const char *name);
+  // Response to the current request
+  void sendHeader(const char *name, const char *value);
+  void send(int code, const char *type = NULL, const char *content = NULL);
+  void send(int code, const char *type, const char *content, size_t length); // content is copied
+  void send_P(int code, PGM_P type, PGM_P content, size_t length); // content stays in flash
+  void setContentLength(size_t length) { _contentLength = length; } // Only CONTENT_LENGTH_UNKNOWN
+  void sendContent(const char *content) { sendContent_P(content, strlen(content)); }
+  void sendContent_P(PGM_P content, size_t length); // content is copied, from flash or RAM
+  void sendParts(int code, const char *type, AsyncHttpContentFunction content); // content must not use the server
+protected:
+  friend class AsyncHttpPart;
+
+  void _dispatch(AsyncHttpConnection *c);
+  bool _parse(AsyncHttpConnection *c);
+  void _parseLine(AsyncHttpConnection *c);
+  bool _header(AsyncHttpConnection *c, int code, const char *type, size_t length);
+  void _fail(AsyncHttpConnection *c);
+  bool _queue(AsyncHttpConnection *c, PGM_P data, size_t length);
+  bool _end(AsyncHttpConnection *c);
+  void _nextPart(AsyncHttpConnection *c);
+  void _pump(AsyncHttpConnection *c);
+  void _finish(AsyncHttpConnection *c);
+  void _reset(AsyncHttpConnection *c);
+  void _close(AsyncHttpConnection *c);
+  void _free(AsyncHttpConnection *c);
+  void _attach(AsyncHttpConnection *c, tcp_pcb *pcb);
+  bool _park(tcp_pcb *pcb);
+  void _unpark(AsyncHttpPending *q);
+  void _promote();
+  const char *_find(const char *name, uint8_t *len);
+  static bool _idle(const AsyncHttpConnection *c); // Between two requests
+  static const char *_reason(int code);
+
+  static err_t _onAccept(void *arg, tcp_pcb *pcb, err_t err);
+  static err_t _onRecv(void *arg, tcp_pcb *pcb, pbuf *p, err_t err);
+  static err_t _onSent(void *arg, tcp_pcb *pcb, u16_t len);
+  static err_t _onPoll(void *arg, tcp_pcb *pcb);
+  static void _onError(void *arg, err_t err);
+  static err_t _onPendingRecv(void *arg, tcp_pcb *pcb, pbuf *p, err_t err);
+  static void _onPendingError(void *arg, err_t err);
+
+  uint16_t _port;
+  tcp_pcb *_listen;
+  AsyncHttpConnection _connections[ASYNC_HTTP_MAX_CONNECTIONS];
+  AsyncHttpPending _pending[ASYNC_HTTP_MAX_PENDING];
+  const char *_uris[ASYNC_HTTP_MAX_ROUTES];
+  THandlerFunction _handlers[ASYNC_HTTP_MAX_ROUTES];
+  uint8_t _routes;
+  THandlerFunction _notFound;
+  const char *_headerNames[ASYNC_HTTP_MAX_HEADERS];
+  uint8_t _headerCount;
+  AsyncHttpConnection *_current; // Request in the handler
+  bool _sent;                    // The handler has answered
+  bool _aborted;                 // A callback aborted its pcb and must return ERR_ABRT
+  size_t _contentLength;         // CONTENT_LENGTH_UNKNOWN for a body sent in pieces
+  char _extra[ASYNC_HTTP_EXTRA_SIZE];
+  uint8_t _extraLen;
+  char _arg[ASYNC_HTTP_ARG_SIZE];
+  char _path[ASYNC_HTTP_LINE_SIZE];
+};
+
+#endif
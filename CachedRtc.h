@@ -0,0 +1,180 @@
+#ifndef __CACHEDRTC_H
+#define __CACHEDRTC_H
+
+#include "Rtc.h"
+
+#define CACHEDRTC_SYNC_INTERVAL 60000UL // Default resync period, ms
+#define CACHEDRTC_MIN_INTERVAL  5000UL  // Resync period never shrinks below this, ms
+#define CACHEDRTC_MAX_DRIFT     1       // Allowed difference between chip and extrapolated time, s
+
+// Software clock on top of any RTC driver.
+// The chip is read once with a burst read, after that the time
+// is extrapolated from millis(). The chip is read again when the
+// sync interval expires. If the extrapolated time has drifted away
+// from the chip, the interval is halved until the drift is gone,
+// then it grows back to the configured value.
+// Setters are written through to the chip and drop the cache.
+// With auto sync off, an expired interval only raises syncDue() and
+// the caller feeds a snapshot read in the background to sync().
+template <class Rtc>
+class CachedRtc : public RtcCore<CachedRtc<Rtc> > {
+public:
+  typedef RtcCore<CachedRtc<Rtc> > Core;
+  using Core::get;
+  using Core::getDate;
+  using Core::set;
+  using Core::setDate;
+  using Core::setTime;
+
+  CachedRtc(Rtc& rtc, uint32_t syncInterval = CACHEDRTC_SYNC_INTERVAL);
+  bool begin();
+  uint32_t getSecondsSince2000();
+  void now(DateTime& dt) { fromSecondsSince2000(getSecondsSince2000(), dt); }
+  void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
+  void getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
+  void getTime(uint8_t& hour, uint8_t& minute, uint8_t& second);
+  uint8_t getHour() { return getSecondsSince2000() % SECONDS_PER_DAY / 3600; }
+  uint8_t getMinute() { return getSecondsSince2000() / 60 % 60; }
+  uint8_t getSecond() { return getSecondsSince2000() % 60; }
+  uint16_t getYear() { return civilFromDays(getSecondsSince2000() / SECONDS_PER_DAY).year; }
+  uint8_t getMonth() { return civilFromDays(getSecondsSince2000() / SECONDS_PER_DAY).month; }
+  uint8_t getDay() { return civilFromDays(getSecondsSince2000() / SECONDS_PER_DAY).day; }
+  uint8_t getDow() { return (getSecondsSince2000() / SECONDS_PER_DAY + 6) % 7 + 1; }
+  void commit(const RtcUpdate& update) { _rtc.commit(update); _valid = false; }
+  void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow) { _rtc.set(hour, minute, second, year, month, day, dow); _valid = false; }
+  void setDate(uint16_t year, uint8_t month, uint8_t day, uint8_t dow) { _rtc.setDate(year, month, day, dow); _valid = false; }
+  void setTime(uint8_t hour, uint8_t minute, uint8_t second) { _rtc.setTime(hour, minute, second); _valid = false; }
+  void setHour(uint8_t hour) { _rtc.setHour(hour); _valid = false; }
+  void setMinute(uint8_t minute) { _rtc.setMinute(minute); _valid = false; }
+  void setSecond(uint8_t second) { _rtc.setSecond(second); _valid = false; }
+  void setYear(uint16_t year) { _rtc.setYear(year); _valid = false; }
+  void setMonth(uint8_t month) { _rtc.setMonth(month); _valid = false; }
+  void setDay(uint8_t day) { _rtc.setDay(day); _valid = false; }
+  void setDow(uint8_t dow) { _rtc.setDow(dow); _valid = false; }
+  void setSyncInterval(uint32_t syncInterval);
+  void setAutoSync(bool autoSync) { _autoSync = autoSync; }
+  bool syncDue() { return !_valid || (millis() - _syncMillis >= _interval); }
+  void sync(const DateTime& dt, uint32_t at); // Chip snapshot taken at millis() == at
+  void invalidate() { _valid = false; } // Next query reads the chip
+  uint32_t getSyncCount() { return _syncCount; } // Number of chip reads so far
+protected:
+  void _sync();
+
+  Rtc& _rtc;
+  uint32_t _syncInterval; // Configured resync period, ms
+  uint32_t _interval;     // Current resync period, ms
+  uint32_t _syncMillis;   // millis() at the last chip read
+  uint32_t _syncSeconds;  // Chip time at the last chip read
+  uint32_t _syncCount;
+  bool _valid;
+  bool _autoSync;
+};
+
+/***
+ * CachedRtc class implementation
+ */
+
+template <class Rtc>
+CachedRtc<Rtc>::CachedRtc(Rtc& rtc, uint32_t syncInterval) : _rtc(rtc) {
+  _syncInterval = syncInterval;
+  _interval = syncInterval;
+  _syncMillis = 0;
+  _syncSeconds = 0;
+  _syncCount = 0;
+  _valid = false;
+  _autoSync = true;
+}
+
+template <class Rtc>
+bool CachedRtc<Rtc>::begin() {
+  _valid = false;
+
+  return _rtc.begin();
+}
+
+template <class Rtc>
+void CachedRtc<Rtc>::setSyncInterval(uint32_t syncInterval) {
+  _syncInterval = syncInterval;
+  _interval = syncInterval;
+}
+
+template <class Rtc>
+uint32_t CachedRtc<Rtc>::getSecondsSince2000() {
+  uint32_t elapsed = millis() - _syncMillis;
+
+  if (!_valid || (_autoSync && (elapsed >= _interval))) {
+    _sync();
+    elapsed = millis() - _syncMillis;
+  }
+
+  return _syncSeconds + elapsed / 1000;
+}
+
+template <class Rtc>
+void CachedRtc<Rtc>::get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) {
+  DateTime dt;
+
+  now(dt);
+  hour = dt.hour;
+  minute = dt.minute;
+  second = dt.second;
+  year = dt.year;
+  month = dt.month;
+  day = dt.day;
+  dow = dt.dow;
+}
+
+template <class Rtc>
+void CachedRtc<Rtc>::getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) {
+  DateTime dt = civilFromDays(getSecondsSince2000() / SECONDS_PER_DAY);
+
+  year = dt.year;
+  month = dt.month;
+  day = dt.day;
+  dow = dt.dow;
+}
+
+template <class Rtc>
+void CachedRtc<Rtc>::getTime(uint8_t& hour, uint8_t& minute, uint8_t& second) {
+  uint32_t t = getSecondsSince2000() % SECONDS_PER_DAY;
+
+  hour = t / 3600;
+  minute = t / 60 % 60;
+  second = t % 60;
+}
+
+template <class Rtc>
+void CachedRtc<Rtc>::_sync() {
+  DateTime dt;
+  uint32_t now = millis();
+
+  // One burst read for the whole date and time
+  _rtc.now(dt);
+  sync(dt, now);
+}
+
+template <class Rtc>
+void CachedRtc<Rtc>::sync(const DateTime& dt, uint32_t at) {
+  uint32_t seconds = toSecondsSince2000(dt);
+
+  if (_valid) {
+    // The chip second boundary is not aligned with millis(),
+    // so a difference of one second is expected
+    uint32_t expected = _syncSeconds + (at - _syncMillis) / 1000;
+    uint32_t drift = seconds > expected ? seconds - expected : expected - seconds;
+    if (drift > CACHEDRTC_MAX_DRIFT) {
+      if (_interval / 2 >= CACHEDRTC_MIN_INTERVAL)
+        _interval /= 2;
+    } else if (_interval < _syncInterval) {
+      _interval *= 2;
+      if (_interval > _syncInterval)
+        _interval = _syncInterval;
+    }
+  }
+  _syncMillis = at;
+  _syncSeconds = seconds;
+  _valid = true;
+  ++_syncCount;
+}
+
+#endif
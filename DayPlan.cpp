@@ -0,0 +1,78 @@
+#include "DayPlan.h"
+
+/***
+ * DayPlan class implementation
+ */
+
+void DayPlan::setInterval(uint16_t from, uint16_t to) {
+  if ((from >= MINUTES_PER_DAY) || (to > MINUTES_PER_DAY))
+    return;
+  if (to >= from) {
+    _set(from, to);
+  } else {
+    // The window of the day before reaches into the morning
+    _set(from, MINUTES_PER_DAY);
+    _set(0, to);
+  }
+}
+
+void DayPlan::compile(const uint16_t intervals[][2], uint8_t count) {
+  clear();
+  for (uint8_t i = 0; i < count; i++)
+    setInterval(intervals[i][0], intervals[i][1]);
+}
+
+void DayPlan::compile(Schedule& schedule, uint8_t day) {
+  uint16_t start = day * MINUTES_PER_DAY;
+  uint16_t n = schedule.count();
+  int16_t i = schedule.find(start);
+  uint16_t from = 0;
+  bool on;
+
+  if (i < 0)
+    return;
+  // The entry in force at midnight, then the ones during the day.
+  // Before the first entry of the week that is the last entry, which
+  // may come again later today, so all n are looked at.
+  on = schedule[i] & SCHEDULE_ON;
+  for (uint16_t k = 1; k <= n; k++) {
+    uint16_t entry = schedule[(i + k) % n];
+    uint16_t m = entry & SCHEDULE_MINUTE;
+    if ((m <= start) || (m >= start + MINUTES_PER_DAY))
+      break;
+    if (on)
+      _set(from, m - start);
+    from = m - start;
+    on = entry & SCHEDULE_ON;
+  }
+  if (on)
+    _set(from, MINUTES_PER_DAY);
+}
+
+uint16_t DayPlan::next(uint16_t minute) {
+  bool state = get(minute);
+  uint8_t same = state ? 0xFF : 0x00;
+  uint16_t m = minute + 1;
+
+  while (m < MINUTES_PER_DAY) {
+    if (!(m & 7) && (_bits[m >> 3] == same)) {
+      m += 8;
+      continue;
+    }
+    if (get(m) != state)
+      return m;
+    m++;
+  }
+
+  return MINUTES_PER_DAY;
+}
+
+void DayPlan::_set(uint16_t from, uint16_t to) {
+  // Bits up to a byte boundary, whole bytes, the bits left
+  for (; (from < to) && (from & 7); from++)
+    _bits[from >> 3] |= 1 << (from & 7);
+  for (; from + 8 <= to; from += 8)
+    _bits[from >> 3] = 0xFF;
+  for (; from < to; from++)
+    _bits[from >> 3] |= 1 << (from & 7);
+}
@@ -0,0 +1,30 @@
+#ifndef __DAYPLAN_H
+#define __DAYPLAN_H
+
+#include "Schedule.h"
+
+#define MINUTES_PER_DAY 1440
+#define DAYPLAN_BYTES   (MINUTES_PER_DAY / 8)
+
+// Relay state for every minute of one day, one bit per minute.
+// It is compiled from on intervals and from a day of the weekly table,
+// after that the state at a minute is a single bit test and the next
+// change is a scan over at most 180 bytes, whole bytes at a time.
+// Several sources are or-ed, the relay is on while any of them says so.
+// Keep one plan for today, or seven for the whole week.
+class DayPlan {
+public:
+  DayPlan() { clear(); }
+  void clear() { memset(_bits, 0, sizeof(_bits)); }
+  void setInterval(uint16_t from, uint16_t to); // On from 'from' up to before 'to', over midnight if to < from
+  void compile(const uint16_t intervals[][2], uint8_t count); // Cleared and set from a list of intervals
+  void compile(Schedule& schedule, uint8_t day); // Or-s in the table on the given day, 0 is Sunday
+  bool get(uint16_t minute) { return _bits[minute >> 3] & (1 << (minute & 7)); }
+  uint16_t next(uint16_t minute); // First later minute with the other state, MINUTES_PER_DAY if none today
+protected:
+  void _set(uint16_t from, uint16_t to); // [from, to) within the day
+
+  uint8_t _bits[DAYPLAN_BYTES]; // Bit n & 7 of byte n >> 3 is minute n
+};
+
+#endif
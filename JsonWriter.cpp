@@ -0,0 +1,151 @@
+#include "JsonWriter.h"
+
+/***
+ * JsonWriter class implementation
+ */
+
+JsonWriter::JsonWriter(char *buf, size_t size, Print *sink) {
+  _buf = buf;
+  _size = size - 1;
+  _sink = sink;
+  reset();
+}
+
+JsonWriter& JsonWriter::beginObject() {
+  _open('{');
+  return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+  _close('}');
+  return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+  _open('[');
+  return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+  _close(']');
+  return *this;
+}
+
+JsonWriter& JsonWriter::key(const char *name) {
+  _separator();
+  _string(name);
+  write(':');
+  _afterKey = true;
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(long value) {
+  _separator();
+  print(value);
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(unsigned long value) {
+  _separator();
+  print(value);
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(bool value) {
+  _separator();
+  print(value ? "true" : "false");
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(const char *value) {
+  _separator();
+  if (value)
+    _string(value);
+  else
+    print("null");
+  return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+  _separator();
+  print("null");
+  return *this;
+}
+
+size_t JsonWriter::write(uint8_t c) {
+  if (_len >= _size) {
+    if (!_sink) {
+      _overflow = true;
+      return 0;
+    }
+    flush();
+  }
+  _buf[_len++] = c;
+
+  return 1;
+}
+
+size_t JsonWriter::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+
+  while (size--)
+    n += write(*buffer++);
+
+  return n;
+}
+
+void JsonWriter::flush() {
+  if (_sink && _len) {
+    _sink->write((const uint8_t *)_buf, _len);
+    _len = 0;
+  }
+}
+
+// Comma between the elements of an object or array, none after a key
+void JsonWriter::_separator() {
+  if (_afterKey) {
+    _afterKey = false;
+    return;
+  }
+  if (!_depth || (_depth > 32))
+    return;
+  if (_more & (1UL << (_depth - 1)))
+    write(',');
+  else
+    _more |= 1UL << (_depth - 1);
+}
+
+void JsonWriter::_open(char c) {
+  _separator();
+  write(c);
+  if (_depth < 32)
+    _more &= ~(1UL << _depth);
+  _depth++;
+}
+
+void JsonWriter::_close(char c) {
+  if (_depth)
+    _depth--;
+  write(c);
+}
+
+void JsonWriter::_string(const char *s) {
+  static const char hex[] = "0123456789abcdef";
+
+  write('"');
+  for (; *s; s++) {
+    uint8_t c = *s;
+    if ((c == '"') || (c == '\\')) {
+      write('\\');
+      write(c);
+    } else if (c < 0x20) {
+      // Control characters as \u00XX, UTF-8 passes as it is
+      print("\\u00");
+      write(hex[c >> 4]);
+      write(hex[c & 0x0F]);
+    } else {
+      write(c);
+    }
+  }
+  write('"');
+}
@@ -0,0 +1,54 @@
+#ifndef __JSONWRITER_H
+#define __JSONWRITER_H
+
+#include <Arduino.h>
+
+// JSON and text into a fixed buffer, without heap allocations.
+// The buffer is usually on the stack. With a sink, a full buffer is
+// written to the sink and reused, so the output may be longer than
+// the buffer, flush() sends the rest.
+// Without a sink, output beyond the buffer is dropped and overflow()
+// turns true.
+// Being a Print, it takes print() for text and numbers as well.
+// Nesting is limited to 32 levels.
+class JsonWriter : public Print {
+public:
+  JsonWriter(char *buf, size_t size, Print *sink = NULL);
+  JsonWriter& beginObject();
+  JsonWriter& endObject();
+  JsonWriter& beginArray();
+  JsonWriter& endArray();
+  JsonWriter& key(const char *name);
+  JsonWriter& value(long value);
+  JsonWriter& value(unsigned long value);
+  JsonWriter& value(int value) { return this->value((long)value); }
+  JsonWriter& value(unsigned int value) { return this->value((unsigned long)value); }
+  JsonWriter& value(bool value);
+  JsonWriter& value(const char *value);
+  JsonWriter& null();
+  template <class T> JsonWriter& field(const char *name, T v) { return key(name).value(v); }
+  size_t write(uint8_t c);
+  size_t write(const uint8_t *buffer, size_t size);
+  using Print::write;
+  void flush();
+  const char *c_str() { _buf[_len] = 0; return _buf; }
+  size_t length() { return _len; }
+  bool overflow() { return _overflow; }
+  void reset() { _len = 0; _depth = 0; _more = 0; _afterKey = false; _overflow = false; }
+protected:
+  void _separator();
+  void _open(char c);
+  void _close(char c);
+  void _string(const char *s);
+
+  char *_buf;
+  size_t _size;     // Usable size, one byte is kept for the terminating zero
+  size_t _len;
+  Print *_sink;
+  uint32_t _more;   // Bit n: level n already has an element
+  uint8_t _depth;
+  bool _afterKey;
+  bool _overflow;
+};
+
+#endif
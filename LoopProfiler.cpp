@@ -0,0 +1,103 @@
+#include "LoopProfiler.h"
+
+/***
+ * LoopProfiler class implementation
+ */
+
+LoopProfiler::LoopProfiler(uint32_t budget) {
+  _sections = 0;
+  _budget = budget;
+  _start = 0;
+  _mark = 0;
+  reset();
+}
+
+uint8_t LoopProfiler::add(const char *name) {
+  if (_sections >= LOOP_PROFILER_SECTIONS)
+    return LOOP_PROFILER_SECTIONS - 1;
+  _names[_sections] = name;
+
+  return _sections++;
+}
+
+void LoopProfiler::end() {
+  uint32_t pass = ESP.getCycleCount() - _start;
+
+  if (pass > _maxPass) {
+    _maxPass = pass;
+    memcpy(_worst, _current, sizeof(_worst));
+  }
+  _totalPass += pass;
+  _passes++;
+  if (_us(pass) > _budget)
+    _overBudget++;
+  _ring[_ringPos] = pass;
+  _ringPos = (_ringPos + 1) % LOOP_PROFILER_RING;
+  for (uint8_t i = 0; i < _sections; i++) {
+    if (_current[i] > _max[i])
+      _max[i] = _current[i];
+    _total[i] += _current[i];
+    _current[i] = 0;
+  }
+}
+
+void LoopProfiler::reset() {
+  memset(_current, 0, sizeof(_current));
+  memset(_max, 0, sizeof(_max));
+  memset(_total, 0, sizeof(_total));
+  memset(_worst, 0, sizeof(_worst));
+  memset(_ring, 0, sizeof(_ring));
+  _ringPos = 0;
+  _passes = 0;
+  _maxPass = 0;
+  _totalPass = 0;
+  _overBudget = 0;
+}
+
+void LoopProfiler::print(Print& out) {
+  char line[64];
+  uint32_t passes = _passes ? _passes : 1;
+
+  snprintf(line, sizeof(line), "passes %lu, max %lu us, mean %lu us\n",
+    (unsigned long)_passes, (unsigned long)_us(_maxPass), (unsigned long)_us(_totalPass / passes));
+  out.print(line);
+  snprintf(line, sizeof(line), "over %lu us: %lu\n", (unsigned long)_budget, (unsigned long)_overBudget);
+  out.print(line);
+  out.print("section      max us  mean us worst us\n");
+  for (uint8_t i = 0; i < _sections; i++) {
+    snprintf(line, sizeof(line), "%-10s %8lu %8lu %8lu\n", _names[i],
+      (unsigned long)_us(_max[i]), (unsigned long)_us(_total[i] / passes), (unsigned long)_us(_worst[i]));
+    out.print(line);
+  }
+  out.print("last us:");
+  // Oldest first
+  for (uint8_t i = 0; i < LOOP_PROFILER_RING; i++) {
+    out.print(' ');
+    out.print(_us(_ring[(_ringPos + i) % LOOP_PROFILER_RING]));
+  }
+  out.print('\n');
+}
+
+void LoopProfiler::print(JsonWriter& json) {
+  uint32_t passes = _passes ? _passes : 1;
+
+  json.field("passes", _passes);
+  json.field("maxUs", _us(_maxPass));
+  json.field("meanUs", _us(_totalPass / passes));
+  json.field("budgetUs", _budget);
+  json.field("overBudget", _overBudget);
+  json.key("sections").beginArray();
+  for (uint8_t i = 0; i < _sections; i++) {
+    json.beginObject();
+    json.field("name", _names[i]);
+    json.field("maxUs", _us(_max[i]));
+    json.field("meanUs", _us(_total[i] / passes));
+    json.field("worstUs", _us(_worst[i]));
+    json.endObject();
+  }
+  json.endArray();
+  json.key("lastUs").beginArray();
+  for (uint8_t i = 0; i < LOOP_PROFILER_RING; i++)
+    json.value(_us(_ring[(_ringPos + i) % LOOP_PROFILER_RING]));
+  json.endArray();
+}
@@ -0,0 +1,57 @@
+#ifndef __LOOPPROFILER_H
+#define __LOOPPROFILER_H
+
+#include <Arduino.h>
+#include "JsonWriter.h"
+
+#define LOOP_PROFILER_SECTIONS 8
+#define LOOP_PROFILER_RING     32    // Last passes kept
+#define LOOP_PROFILER_BUDGET   20000 // Default budget of one loop() pass, us
+
+// Profiler of loop() on the CPU cycle counter.
+// start() begins a pass, mark(n) charges the cycles since the last
+// start() or mark() to section n, end() closes the pass.
+// Kept are max and mean of every section and of the whole pass, the
+// last passes in a ring, and the passes over the budget together with
+// the sections of the worst one. The Wi-Fi stack does not run while
+// loop() does, so a long pass is as long as the stack was starved.
+// The cycle counter wraps after 53 s at 80 MHz.
+class LoopProfiler {
+public:
+  LoopProfiler(uint32_t budget = LOOP_PROFILER_BUDGET);
+  uint8_t add(const char *name); // New section, returns its number
+  inline void start() {
+    _start = ESP.getCycleCount();
+    _mark = _start;
+  }
+  inline void mark(uint8_t section) {
+    uint32_t now = ESP.getCycleCount();
+    _current[section] += now - _mark;
+    _mark = now;
+  }
+  void end();
+  void reset();
+  uint32_t overBudget() { return _overBudget; }
+  void print(Print& out);       // Table for the serial console
+  void print(JsonWriter& json); // Fields into an open object
+protected:
+  static uint32_t _us(uint64_t cycles) { return cycles / ESP.getCpuFreqMHz(); }
+
+  const char *_names[LOOP_PROFILER_SECTIONS];
+  uint8_t _sections;
+  uint32_t _budget;                          // us
+  uint32_t _start;                           // Cycle count at start()
+  uint32_t _mark;                            // Cycle count at the last start() or mark()
+  uint32_t _current[LOOP_PROFILER_SECTIONS]; // This pass, cycles
+  uint32_t _max[LOOP_PROFILER_SECTIONS];
+  uint64_t _total[LOOP_PROFILER_SECTIONS];
+  uint32_t _worst[LOOP_PROFILER_SECTIONS];   // Sections of the longest pass
+  uint32_t _ring[LOOP_PROFILER_RING];        // Last passes, cycles
+  uint8_t _ringPos;
+  uint32_t _passes;
+  uint32_t _maxPass;
+  uint64_t _totalPass;
+  uint32_t _overBudget;
+};
+
+#endif
@@ -0,0 +1,117 @@
+#include "Metrics.h"
+
+// Bucket bounds, us and as printed in seconds
+static const uint32_t bounds[METRICS_BUCKETS] = { 100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 0xFFFFFFFF };
+static const char *const labels[METRICS_BUCKETS] = { "0.0001", "0.0005", "0.001", "0.005", "0.01", "0.05", "0.1", "0.5", "1", "+Inf" };
+
+/***
+ * Histogram implementation
+ */
+
+void Histogram::record(uint32_t us) {
+  uint8_t i = 0;
+
+  while (us > bounds[i])
+    i++;
+  buckets[i]++;
+  count++;
+  sum += us;
+}
+
+/***
+ * Metrics class implementation
+ */
+
+Histogram *Metrics::histogram(const char *name, const char *route) {
+  if (_count >= METRICS_MAX_HISTOGRAMS)
+    return NULL;
+  Histogram *h = &_histograms[_count++];
+  memset(h, 0, sizeof(Histogram));
+  h->name = name;
+  h->route = route;
+
+  return h;
+}
+
+void Metrics::print(Print& out) {
+  for (uint8_t part = 0; print(out, part); part++)
+    ;
+}
+
+bool Metrics::print(Print& out, uint8_t part) {
+  uint8_t n = 0;
+
+  for (uint8_t i = 0; i < _count; i++) {
+    // A family is printed whole where its first histogram is
+    uint8_t j = 0;
+    while (strcmp(_histograms[j].name, _histograms[i].name))
+      j++;
+    if (j < i)
+      continue;
+    for (j = i; j < _count; j++) {
+      if (strcmp(_histograms[j].name, _histograms[i].name) || (n++ != part))
+        continue;
+      if (j == i) {
+        out.print("# TYPE ");
+        out.print(_histograms[i].name);
+        out.print(" histogram\n");
+      }
+      if (_histograms[j].count)
+        _print(out, _histograms[j]);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void Metrics::printValue(Print& out, const char *name, const char *type, uint32_t value) {
+  out.print("# TYPE ");
+  out.print(name);
+  out.print(' ');
+  out.print(type);
+  out.print('\n');
+  out.print(name);
+  out.print(' ');
+  out.print(value);
+  out.print('\n');
+}
+
+void Metrics::_print(Print& out, const Histogram& s) {
+  uint32_t cumulative = 0;
+  char fraction[8];
+
+  for (uint8_t i = 0; i < METRICS_BUCKETS; i++) {
+    cumulative += s.buckets[i];
+    out.print(s.name);
+    out.print("_bucket{");
+    if (s.route) {
+      out.print("route=\"");
+      out.print(s.route);
+      out.print("\",");
+    }
+    out.print("le=\"");
+    out.print(labels[i]);
+    out.print("\"} ");
+    out.print(cumulative);
+    out.print('\n');
+  }
+  for (uint8_t i = 0; i < 2; i++) {
+    out.print(s.name);
+    out.print(i ? "_count" : "_sum");
+    if (s.route) {
+      out.print("{route=\"");
+      out.print(s.route);
+      out.print("\"}");
+    }
+    out.print(' ');
+    if (i) {
+      out.print(s.count);
+    } else {
+      sprintf(fraction, ".%06lu", (unsigned long)(s.sum % 1000000));
+      out.print((unsigned long)(s.sum / 1000000));
+      out.print(fraction);
+    }
+    out.print('\n');
+  }
+}
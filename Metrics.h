@@ -0,0 +1,75 @@
+#ifndef __METRICS_H
+#define __METRICS_H
+
+#include <Arduino.h>
+
+#define METRICS_MAX_HISTOGRAMS 8 // The hot routes and the three of the loop, see setup()
+#define METRICS_BUCKETS        10 // Upper bounds in Metrics.cpp, the last one is +Inf
+
+// Latency histogram with fixed buckets, times in microseconds.
+// Recording is a few compares and increments, no allocations.
+struct Histogram {
+  const char *name;  // Metric family, e.g. "wifipower_http_handler_seconds"
+  const char *route; // Value of the route label, NULL for none
+  uint32_t buckets[METRICS_BUCKETS]; // Not cumulative
+  uint32_t count;
+  uint64_t sum;      // us
+
+  void record(uint32_t us);
+};
+
+// Records the time from its construction to the end of the scope.
+// A NULL histogram records nothing.
+class MetricTimer {
+public:
+  MetricTimer(Histogram *histogram) : _histogram(histogram), _start(micros()) {}
+  ~MetricTimer() { if (_histogram) _histogram->record(micros() - _start); }
+protected:
+  Histogram *_histogram;
+  uint32_t _start;
+};
+
+// Histograms in static memory, printed in the Prometheus text format.
+// Histograms of one family share the name and differ by the route.
+// Empty histograms are left out, a route shows up with its first
+// request, as with the labeled metrics of the Prometheus clients.
+// print(out, part) prints one histogram, the families kept together,
+// so a server can send them one at a time.
+class Metrics {
+public:
+  Metrics() : _count(0) {}
+  Histogram *histogram(const char *name, const char *route = NULL); // NULL if all are taken
+  void print(Print& out);
+  bool print(Print& out, uint8_t part); // false after the last histogram
+  uint8_t count() { return _count; }
+  static void printValue(Print& out, const char *name, const char *type, uint32_t value); // counter or gauge
+protected:
+  void _print(Print& out, const Histogram& s);
+
+  Histogram _histograms[METRICS_MAX_HISTOGRAMS];
+  uint8_t _count;
+};
+
+// Wraps a request handler so its run time is recorded:
+//   server.on("/state", timed<getState>(metrics.histogram("wifipower_http_handler_seconds", "/state")));
+// One histogram per handler function.
+template <void (*Handler)()>
+class TimedHandler {
+public:
+  static void run() {
+    MetricTimer timer(histogram);
+    Handler();
+  }
+  static Histogram *histogram;
+};
+
+template <void (*Handler)()>
+Histogram *TimedHandler<Handler>::histogram = NULL;
+
+template <void (*Handler)()>
+void (*timed(Histogram *histogram))() {
+  TimedHandler<Handler>::histogram = histogram;
+  return &TimedHandler<Handler>::run;
+}
+
+#endif
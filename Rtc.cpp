@@ -5,28 +5,18 @@
 #endif
 #include "Rtc.h"
 
-static const uint8_t daysInMonth[] PROGMEM = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+static_assert(daysFromCivil(2000, 1, 1) == 0, "2000-01-01 is day 0");
+static_assert(daysFromCivil(2000, 3, 1) == 60, "2000 is a leap year");
+static_assert(daysFromCivil(2100, 3, 1) - daysFromCivil(2100, 2, 28) == 1, "2100 is not a leap year");
+static_assert(civilFromDays(49710).year == 2136, "uint32_t seconds end in 2136");
+static_assert((monthLength(2024, 2) == 29) && (monthLength(2100, 2) == 28) && (monthLength(2000, 2) == 29), "leap years");
+static_assert((monthLength(2025, 7) == 31) && (monthLength(2025, 8) == 31) && (monthLength(2025, 9) == 30), "month lengths");
+static_assert(civilFromDays(daysFromCivil(2024, 2, 29)).day == 29, "round trip");
 
 /***
  * Utility functions
  */
 
-static uint16_t date2days(uint16_t y, uint8_t m, uint8_t d) { // Number of days since 2000/01/01, valid for 2001..2099
-  if (y >= 2000)
-    y -= 2000;
-  uint16_t days = d;
-  for (uint8_t i = 1; i < m; ++i)
-    days += pgm_read_byte(daysInMonth + i - 1);
-  if ((m > 2) && (y % 4 == 0))
-    ++days;
-
-  return days + 365 * y + (y + 3) / 4 - 1;
-}
-
-static uint32_t time2long(uint16_t days, uint8_t h, uint8_t m, uint8_t s) {
-  return ((days * 24L + h) * 60 + m) * 60 + s;
-}
-
 static uint8_t conv2d(const char* p) {
   uint8_t v = 0;
   if (('0' <= *p) && (*p <= '9'))
@@ -42,20 +32,147 @@ static char* conv2s(char* s, uint8_t v) {
   return s;
 }
 
+void rtcParseDate(const char* date, uint16_t& year, uint8_t& month, uint8_t& day) {
+  // Sample input: date = "Dec 26 2009"
+  year = conv2d(date + 9) + 2000;
+  // Jan Feb Mar Apr May Jun Jul Aug Sep Oct Nov Dec 
+  switch (date[0]) {
+    case 'J':
+      month = date[1] == 'a' ? 1 : date[2] == 'n' ? 6 : 7;
+      break;
+    case 'F':
+      month = 2;
+      break;
+    case 'A':
+      month = date[2] == 'r' ? 4 : 8;
+      break;
+    case 'M':
+      month = date[2] == 'r' ? 3 : 5;
+      break;
+    case 'S':
+      month = 9;
+      break;
+    case 'O':
+      month = 10;
+      break;
+    case 'N':
+      month = 11;
+      break;
+    case 'D':
+      month = 12;
+      break;
+  }
+  day = conv2d(date + 4);
+}
+
+void rtcParseTime(const char* time, uint8_t& hour, uint8_t& minute, uint8_t& second) {
+  // Sample input: time = "12:34:56"
+  hour = conv2d(time);
+  minute = conv2d(time + 3);
+  second = conv2d(time + 6);
+}
+
+const char dateDelimiter = '.';
+const char timeDelimiter = ':';
+
+char* rtcDateTimeToStr(char* str, const DateTime& dt) { // dd.mm.yyyy hh:mm:ss
+  rtcDateToStr(str, dt);
+  str[10] = ' ';
+  rtcTimeToStr(str + 11, dt);
+
+  return str;
+}
+
+char* rtcDateToStr(char* str, const DateTime& dt) { // dd.mm.yyyy
+  char* p = str;
+
+  p = conv2s(p, dt.day);
+  *p++ = dateDelimiter;
+  p = conv2s(p, dt.month);
+  *p++ = dateDelimiter;
+  p = conv2s(p, dt.year / 100);
+  p = conv2s(p, dt.year % 100);
+  *p = 0; // NULL
+
+  return str;
+}
+
+char* rtcTimeToStr(char* str, const DateTime& dt) { // hh:mm:ss
+  char* p = str;
+
+  p = conv2s(p, dt.hour);
+  *p++ = timeDelimiter;
+  p = conv2s(p, dt.minute);
+  *p++ = timeDelimiter;
+  p = conv2s(p, dt.second);
+  *p = 0; // NULL
+
+  return str;
+}
+
+/***
+ * RtcRegisterRun class implementation
+ */
+
+bool RtcRegisterRun::begin(const RtcUpdate& update) {
+  uint8_t fields = update.fields();
+  uint8_t last;
+
+  if (!fields)
+    return false;
+  // The field bits follow the register order
+  for (first = 0; !(fields & (1 << first)); first++)
+    ;
+  for (last = 6; !(fields & (1 << last)); last--)
+    ;
+  length = last - first + 1;
+  _needsRead = !update.covers((2 << last) - (1 << first));
+
+  return true;
+}
+
+void RtcRegisterRun::encode(const RtcUpdate& update, DateTime& dt) {
+  update.apply(dt);
+  for (uint8_t i = 0; i < length; i++) {
+    switch (first + i) {
+      case 0:
+        data[i] = bin2bcd(dt.second);
+        break;
+      case 1:
+        data[i] = bin2bcd(dt.minute);
+        break;
+      case 2:
+        data[i] = bin2bcd(dt.hour);
+        break;
+      case 3:
+        data[i] = dt.dow;
+        break;
+      case 4:
+        data[i] = bin2bcd(dt.day);
+        break;
+      case 5:
+        data[i] = bin2bcd(dt.month);
+        break;
+      default:
+        data[i] = bin2bcd(dt.year - 2000);
+    }
+  }
+}
+
 /***
  * RtcBase class implementation
  */
 
 uint32_t RtcBase::getSecondsSince2000() {
-  uint8_t hour, minute, second;
-  uint16_t year;
-  uint8_t month, day;
-  uint16_t days;
+  DateTime dt;
+
+  now(dt);
 
-  get(hour, minute, second, year, month, day);
-  days = date2days(year, month, day);
+  return toSecondsSince2000(dt);
+}
 
-  return time2long(days, hour, minute, second);
+void RtcBase::now(DateTime& dt) {
+  get(dt.hour, dt.minute, dt.second, dt.year, dt.month, dt.day, dt.dow);
 }
 
 void RtcBase::get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day) {
@@ -71,38 +188,14 @@ void RtcBase::getDate(uint16_t& year, uint8_t& month, uint8_t& day) {
 }
 
 void RtcBase::setSecondsSince2000(uint32_t t) {
-  uint8_t hour, minute, second;
-  uint16_t year;
-  uint8_t month, day, dow;
+  DateTime dt;
 
-  second = t % 60;
-  t /= 60;
-  minute = t % 60;
-  t /= 60;
-  hour = t % 24;
-  uint16_t days = t / 24;
-  dow = (days + 6) % 7 + 1;
-  uint8_t leap;
-  for (year = 2000; ; ++year) {
-    leap = year % 4 == 0;
-    if (days < 365 + leap)
-      break;
-    days -= 365 + leap;
-  }
-  for (month = 1; ; ++month) {
-    uint8_t daysPerMonth = pgm_read_byte(daysInMonth + month - 1);
-    if (leap && (month == 2))
-      ++daysPerMonth;
-    if (days < daysPerMonth)
-      break;
-    days -= daysPerMonth;
-  }
-  day = days + 1;
-  set(hour, minute, second, year, month, day, dow);
+  fromSecondsSince2000(t, dt);
+  set(dt.hour, dt.minute, dt.second, dt.year, dt.month, dt.day, dt.dow);
 }
 
 void RtcBase::set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day) {
-  uint8_t dow = (date2days(year, month, day) + 6) % 7 + 1;
+  uint8_t dow = (daysFromCivil(year, month, day) + 6) % 7 + 1;
 
   set(hour, minute, second, year, month, day, dow);
 }
@@ -112,40 +205,9 @@ void RtcBase::set(const char* date, const char* time) {
   uint16_t year;
   uint8_t month, day, dow;
 
-  // Sample input: date = "Dec 26 2009", time = "12:34:56"
-  year = conv2d(date + 9) + 2000;
-  // Jan Feb Mar Apr May Jun Jul Aug Sep Oct Nov Dec 
-  switch (date[0]) {
-    case 'J':
-      month = date[1] == 'a' ? 1 : date[2] == 'n' ? 6 : 7;
-      break;
-    case 'F':
-      month = 2;
-      break;
-    case 'A':
-      month = date[2] == 'r' ? 4 : 8;
-      break;
-    case 'M':
-      month = date[2] == 'r' ? 3 : 5;
-      break;
-    case 'S':
-      month = 9;
-      break;
-    case 'O':
-      month = 10;
-      break;
-    case 'N':
-      month = 11;
-      break;
-    case 'D':
-      month = 12;
-      break;
-  }
-  day = conv2d(date + 4);
-  hour = conv2d(time);
-  minute = conv2d(time + 3);
-  second = conv2d(time + 6);
-  dow = (date2days(year, month, day) + 6) % 7 + 1;
+  rtcParseDate(date, year, month, day);
+  rtcParseTime(time, hour, minute, second);
+  dow = (daysFromCivil(year, month, day) + 6) % 7 + 1;
   set(hour, minute, second, year, month, day, dow);
 }
 
@@ -158,47 +220,17 @@ void RtcBase::set(const __FlashStringHelper* date, const __FlashStringHelper* ti
 }
 
 void RtcBase::setDate(uint16_t year, uint8_t month, uint8_t day) {
-  uint8_t dow = (date2days(year, month, day) + 6) % 7 + 1;
+  uint8_t dow = (daysFromCivil(year, month, day) + 6) % 7 + 1;
 
   setDate(year, month, day, dow);
 }
 
 void RtcBase::setDate(const char* date) {
   uint16_t year;
-  uint8_t month, day, dow;
+  uint8_t month, day;
 
-  // Sample input: date = "Dec 26 2009"
-  year = conv2d(date + 9) + 2000;
-  // Jan Feb Mar Apr May Jun Jul Aug Sep Oct Nov Dec 
-  switch (date[0]) {
-    case 'J':
-      month = date[1] == 'a' ? 1 : date[2] == 'n' ? 6 : 7;
-      break;
-    case 'F':
-      month = 2;
-      break;
-    case 'A':
-      month = date[2] == 'r' ? 4 : 8;
-      break;
-    case 'M':
-      month = date[2] == 'r' ? 3 : 5;
-      break;
-    case 'S':
-      month = 9;
-      break;
-    case 'O':
-      month = 10;
-      break;
-    case 'N':
-      month = 11;
-      break;
-    case 'D':
-      month = 12;
-      break;
-  }
-  day = conv2d(date + 4);
-  dow = (date2days(year, month, day) + 6) % 7 + 1;
-  setDate(year, month, day, dow);
+  rtcParseDate(date, year, month, day);
+  setDate(year, month, day);
 }
 
 void RtcBase::setDate(const __FlashStringHelper* date) {
@@ -211,10 +243,7 @@ void RtcBase::setDate(const __FlashStringHelper* date) {
 void RtcBase::setTime(const char* time) {
   uint8_t hour, minute, second;
 
-  // Sample input: time = "12:34:56"
-  hour = conv2d(time);
-  minute = conv2d(time + 3);
-  second = conv2d(time + 6);
+  rtcParseTime(time, hour, minute, second);
   setTime(hour, minute, second);
 }
 
@@ -225,63 +254,26 @@ void RtcBase::setTime(const __FlashStringHelper* time) {
   setTime(_time);
 }
 
-const char dateDelimiter = '.';
-const char timeDelimiter = ':';
-
 char* RtcBase::dateTimeToStr(char* str) { // dd.mm.yyyy hh:mm:ss
-  char* p = str;
-  uint8_t hour, minute, second;
-  uint16_t year;
-  uint8_t month, day;
+  DateTime dt;
 
-  get(hour, minute, second, year, month, day);
-  p = conv2s(p, day);
-  *p++ = dateDelimiter;
-  p = conv2s(p, month);
-  *p++ = dateDelimiter;
-  *p++ = '2'; // year from 2000 to 2099
-  *p++ = '0';
-  p = conv2s(p, year - 2000);
-  *p++ = ' ';
-  p = conv2s(p, hour);
-  *p++ = timeDelimiter;
-  p = conv2s(p, minute);
-  *p++ = timeDelimiter;
-  p = conv2s(p, second);
-  *p = 0; // NULL
+  now(dt);
 
-  return str;
+  return rtcDateTimeToStr(str, dt);
 }
 
 char* RtcBase::dateToStr(char* str) { // dd.mm.yyyy
-  char* p = str;
-  uint16_t year;
-  uint8_t month, day;
+  DateTime dt;
 
-  getDate(year, month, day);
-  p = conv2s(p, day);
-  *p++ = dateDelimiter;
-  p = conv2s(p, month);
-  *p++ = dateDelimiter;
-  *p++ = '2'; // year from 2000 to 2099
-  *p++ = '0';
-  p = conv2s(p, year - 2000);
-  *p = 0; // NULL
+  getDate(dt.year, dt.month, dt.day, dt.dow);
 
-  return str;
+  return rtcDateToStr(str, dt);
 }
 
 char* RtcBase::timeToStr(char* str) { // hh:mm:ss
-  char* p = str;
-  uint8_t hour, minute, second;
+  DateTime dt;
 
-  getTime(hour, minute, second);
-  p = conv2s(p, hour);
-  *p++ = timeDelimiter;
-  p = conv2s(p, minute);
-  *p++ = timeDelimiter;
-  p = conv2s(p, second);
-  *p = 0; // NULL
+  getTime(dt.hour, dt.minute, dt.second);
 
-  return str;
+  return rtcTimeToStr(str, dt);
 }
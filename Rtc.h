@@ -6,12 +6,301 @@
 #define EPOCH_TIME_OFF  946684800L // This is 2000-jan-01 00:00:00 in epoch time
 #define SECONDS_PER_DAY 86400L
 
+// Date and time taken from one read of the chip.
+// Fields follow the order of the clock registers, 8 bytes without padding.
+struct DateTime {
+  uint8_t second;
+  uint8_t minute;
+  uint8_t hour;
+  uint8_t dow;
+  uint8_t day;
+  uint8_t month;
+  uint16_t year;
+};
+
+// Calendar conversion in constant time, after H. Hinnant's days_from_civil/civil_from_days.
+// The year is counted from March 1st, so the leap day is the last day of the year
+// and the month lengths repeat in a 153 day cycle of five months.
+// Valid for every date from 2000-01-01 on, including the whole uint32_t range
+// of getSecondsSince2000(). Written as single expressions so that they are
+// constexpr under C++11 and fold to constants for constant arguments.
+#define DAYS_TO_2000 730425UL // Days from 0000-03-01 to 2000-01-01
+#define DAYS_PER_ERA 146097UL // Days in 400 years
+
+constexpr uint16_t _marchDayOfYear(uint8_t month, uint8_t day) {
+  return (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+}
+
+constexpr uint32_t _marchDayOfEra(uint32_t yearOfEra, uint16_t dayOfYear) {
+  return yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+}
+
+constexpr uint32_t _daysFromMarchYear(uint32_t year, uint8_t month, uint8_t day) {
+  return year / 400 * DAYS_PER_ERA + _marchDayOfEra(year % 400, _marchDayOfYear(month, day)) - DAYS_TO_2000;
+}
+
+constexpr DateTime _civilFromMarchDay(uint32_t days, uint32_t year, uint16_t dayOfYear, uint8_t monthOfYear) {
+  return { 0, 0, 0,
+    (uint8_t)((days + 6) % 7 + 1), // 2000-01-01 is a Saturday, dow 1 is Sunday
+    (uint8_t)(dayOfYear - (153 * monthOfYear + 2) / 5 + 1),
+    (uint8_t)(monthOfYear < 10 ? monthOfYear + 3 : monthOfYear - 9),
+    (uint16_t)(year + (monthOfYear >= 10)) };
+}
+
+constexpr DateTime _civilFromYearOfEra(uint32_t days, uint32_t era, uint32_t dayOfEra, uint32_t yearOfEra) {
+  return _civilFromMarchDay(days, era * 400 + yearOfEra, dayOfEra - _marchDayOfEra(yearOfEra, 0),
+    (5 * (dayOfEra - _marchDayOfEra(yearOfEra, 0)) + 2) / 153);
+}
+
+constexpr DateTime _civilFromDayOfEra(uint32_t days, uint32_t era, uint32_t dayOfEra) {
+  return _civilFromYearOfEra(days, era, dayOfEra,
+    (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365);
+}
+
+// Number of days since 2000-01-01
+constexpr uint32_t daysFromCivil(uint16_t year, uint8_t month, uint8_t day) {
+  return _daysFromMarchYear(year - (month <= 2), month, day);
+}
+
+// Days of a month, February has 29 in the leap years of the Gregorian calendar
+constexpr uint8_t monthLength(uint16_t year, uint8_t month) {
+  return month == 2 ? 28 + ((year % 4 == 0) && ((year % 100 != 0) || (year % 400 == 0)))
+    : 30 + ((month + (month > 7)) & 1);
+}
+
+// Date for a number of days since 2000-01-01, the time fields are zero
+constexpr DateTime civilFromDays(uint32_t days) {
+  return _civilFromDayOfEra(days, (days + DAYS_TO_2000) / DAYS_PER_ERA, (days + DAYS_TO_2000) % DAYS_PER_ERA);
+}
+
+// Seconds since 2000-01-01 00:00:00 for a date and time
+inline uint32_t toSecondsSince2000(const DateTime& dt) {
+  return ((daysFromCivil(dt.year, dt.month, dt.day) * 24UL + dt.hour) * 60 + dt.minute) * 60 + dt.second;
+}
+
+// Date and time for a number of seconds since 2000-01-01 00:00:00
+inline void fromSecondsSince2000(uint32_t t, DateTime& dt) {
+  uint32_t s = t % SECONDS_PER_DAY;
+
+  dt = civilFromDays(t / SECONDS_PER_DAY);
+  dt.hour = s / 3600;
+  dt.minute = s / 60 % 60;
+  dt.second = s % 60;
+}
+
+inline uint8_t bcd2bin(uint8_t val) { return val - 6 * (val >> 4); }
+inline uint8_t bin2bcd(uint8_t val) { return val + 6 * (val / 10); }
+
+// Clock fields in register order, as bits of RtcUpdate::fields()
+#define RTC_FIELD_SECOND 0x01
+#define RTC_FIELD_MINUTE 0x02
+#define RTC_FIELD_HOUR   0x04
+#define RTC_FIELD_DOW    0x08
+#define RTC_FIELD_DAY    0x10
+#define RTC_FIELD_MONTH  0x20
+#define RTC_FIELD_YEAR   0x40
+#define RTC_FIELD_DATE   (RTC_FIELD_DAY | RTC_FIELD_MONTH | RTC_FIELD_YEAR)
+#define RTC_FIELD_ALL    0x7F
+
+// Field changes recorded and written to the chip at once by commit().
+// A changed date without an explicit day of week gets the day of week
+// recomputed, so the chip never holds a stale one.
+class RtcUpdate {
+public:
+  RtcUpdate() : _dirty(0) {}
+  RtcUpdate& setSecond(uint8_t second) { _dt.second = second; _dirty |= RTC_FIELD_SECOND; return *this; }
+  RtcUpdate& setMinute(uint8_t minute) { _dt.minute = minute; _dirty |= RTC_FIELD_MINUTE; return *this; }
+  RtcUpdate& setHour(uint8_t hour) { _dt.hour = hour; _dirty |= RTC_FIELD_HOUR; return *this; }
+  RtcUpdate& setDow(uint8_t dow) { _dt.dow = dow; _dirty |= RTC_FIELD_DOW; return *this; }
+  RtcUpdate& setDay(uint8_t day) { _dt.day = day; _dirty |= RTC_FIELD_DAY; return *this; }
+  RtcUpdate& setMonth(uint8_t month) { _dt.month = month; _dirty |= RTC_FIELD_MONTH; return *this; }
+  RtcUpdate& setYear(uint16_t year) { _dt.year = year; _dirty |= RTC_FIELD_YEAR; return *this; }
+  // Fields to write, including a recomputed day of week
+  uint8_t fields() const { return (_dirty & RTC_FIELD_DATE) ? _dirty | RTC_FIELD_DOW : _dirty; }
+  // True if all fields in mask are known without reading the chip
+  bool covers(uint8_t mask) const {
+    uint8_t known = (_dirty & RTC_FIELD_DATE) == RTC_FIELD_DATE ? _dirty | RTC_FIELD_DOW : _dirty;
+
+    return (known & mask) == mask;
+  }
+  // Merges the changes into dt, which holds the current chip time for the fields not covered
+  void apply(DateTime& dt) const {
+    if (_dirty & RTC_FIELD_SECOND)
+      dt.second = _dt.second;
+    if (_dirty & RTC_FIELD_MINUTE)
+      dt.minute = _dt.minute;
+    if (_dirty & RTC_FIELD_HOUR)
+      dt.hour = _dt.hour;
+    if (_dirty & RTC_FIELD_DAY)
+      dt.day = _dt.day;
+    if (_dirty & RTC_FIELD_MONTH)
+      dt.month = _dt.month;
+    if (_dirty & RTC_FIELD_YEAR)
+      dt.year = _dt.year;
+    if (_dirty & RTC_FIELD_DOW)
+      dt.dow = _dt.dow;
+    else if (_dirty & RTC_FIELD_DATE)
+      dt.dow = (daysFromCivil(dt.year, dt.month, dt.day) + 6) % 7 + 1;
+  }
+protected:
+  DateTime _dt;
+  uint8_t _dirty;
+};
+
+// Commit helper for chips with the seven clock fields in consecutive
+// BCD registers, in the order of the RTC_FIELD bits (DS1307, DS3231).
+// begin() picks the smallest run of registers that holds every change,
+// needsRead() tells whether the run holds registers the update does
+// not cover, encode() fills in the register values of the run.
+class RtcRegisterRun {
+public:
+  bool begin(const RtcUpdate& update); // False if there is nothing to write
+  bool needsRead() const { return _needsRead; }
+  void encode(const RtcUpdate& update, DateTime& dt); // dt holds the chip time if needsRead()
+
+  uint8_t first;  // Field of the first register, 0 = seconds
+  uint8_t length; // Registers in the run
+  uint8_t data[7];
+protected:
+  bool _needsRead;
+};
+
+// String helpers shared by RtcCore and RtcBase, see Rtc.cpp
+void rtcParseDate(const char* date, uint16_t& year, uint8_t& month, uint8_t& day);
+void rtcParseTime(const char* time, uint8_t& hour, uint8_t& minute, uint8_t& second);
+char* rtcDateTimeToStr(char* str, const DateTime& dt);
+char* rtcDateToStr(char* str, const DateTime& dt);
+char* rtcTimeToStr(char* str, const DateTime& dt);
+
+// Static dispatch front end.
+// A driver derives from RtcCore<Driver> and implements begin(), now(),
+// get(), getDate(), getTime(), the field getters, set(), setDate(),
+// setTime() and the field setters. RtcCore adds the overloads and
+// conversions on top of them without any virtual call, so everything
+// the sketch does not use is dropped by the linker.
+// A driver has to re-export the overloads it hides:
+//   using RtcCore<Driver>::get; (also getDate, set, setDate, setTime)
+template <class Derived>
+class RtcCore {
+public:
+  uint32_t getSecondsSince2000() {
+    DateTime dt;
+
+    _self().now(dt);
+
+    return toSecondsSince2000(dt);
+  }
+  uint32_t getEpoch() { return _self().getSecondsSince2000() + EPOCH_TIME_OFF; } // UNIX time
+  void now(DateTime& dt) { _self().get(dt.hour, dt.minute, dt.second, dt.year, dt.month, dt.day, dt.dow); }
+  void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day) {
+    uint8_t dow;
+
+    _self().get(hour, minute, second, year, month, day, dow);
+  }
+  void getDate(uint16_t& year, uint8_t& month, uint8_t& day) {
+    uint8_t dow;
+
+    _self().getDate(year, month, day, dow);
+  }
+  void setSecondsSince2000(uint32_t t) {
+    DateTime dt;
+
+    fromSecondsSince2000(t, dt);
+    _self().set(dt.hour, dt.minute, dt.second, dt.year, dt.month, dt.day, dt.dow);
+  }
+  void setEpoch(uint32_t epoch) { _self().setSecondsSince2000(epoch - EPOCH_TIME_OFF); } // UNIX time
+  // Default commit: one read for the fields not in the update, one full write
+  void commit(const RtcUpdate& update) {
+    DateTime dt;
+
+    if (!update.fields())
+      return;
+    if (!update.covers(RTC_FIELD_ALL))
+      _self().now(dt);
+    update.apply(dt);
+    _self().set(dt.hour, dt.minute, dt.second, dt.year, dt.month, dt.day, dt.dow);
+  }
+  void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day) {
+    _self().set(hour, minute, second, year, month, day, (daysFromCivil(year, month, day) + 6) % 7 + 1);
+  }
+  void set(const char* date, const char* time) {
+    uint8_t hour, minute, second;
+    uint16_t year;
+    uint8_t month, day;
+
+    rtcParseDate(date, year, month, day);
+    rtcParseTime(time, hour, minute, second);
+    _self().set(hour, minute, second, year, month, day, (daysFromCivil(year, month, day) + 6) % 7 + 1);
+  }
+  void set(const __FlashStringHelper* date, const __FlashStringHelper* time) {
+    char _date[11], _time[8];
+
+    memcpy_P(_date, date, 11);
+    memcpy_P(_time, time, 8);
+    set(_date, _time);
+  }
+  void setDate(uint16_t year, uint8_t month, uint8_t day) {
+    _self().setDate(year, month, day, (daysFromCivil(year, month, day) + 6) % 7 + 1);
+  }
+  void setDate(const char* date) {
+    uint16_t year;
+    uint8_t month, day;
+
+    rtcParseDate(date, year, month, day);
+    setDate(year, month, day);
+  }
+  void setDate(const __FlashStringHelper* date) {
+    char _date[11];
+
+    memcpy_P(_date, date, 11);
+    setDate(_date);
+  }
+  void setTime(const char* time) {
+    uint8_t hour, minute, second;
+
+    rtcParseTime(time, hour, minute, second);
+    _self().setTime(hour, minute, second);
+  }
+  void setTime(const __FlashStringHelper* time) {
+    char _time[8];
+
+    memcpy_P(_time, time, 8);
+    setTime(_time);
+  }
+  char *dateTimeToStr(char* str) { // dd.mm.yyyy hh:mm:ss
+    DateTime dt;
+
+    _self().now(dt);
+
+    return rtcDateTimeToStr(str, dt);
+  }
+  char *dateToStr(char* str) { // dd.mm.yyyy
+    DateTime dt;
+
+    _self().getDate(dt.year, dt.month, dt.day, dt.dow);
+
+    return rtcDateToStr(str, dt);
+  }
+  char *timeToStr(char* str) { // hh:mm:ss
+    DateTime dt;
+
+    _self().getTime(dt.hour, dt.minute, dt.second);
+
+    return rtcTimeToStr(str, dt);
+  }
+protected:
+  Derived& _self() { return *static_cast<Derived*>(this); }
+};
+
+// Virtual interface, for code that has to pick the chip at run time.
+// Wrap a driver with RtcAdapter to get one.
 class RtcBase {
 public:
   RtcBase() {}
   virtual bool begin() = 0;
   virtual uint32_t getSecondsSince2000();
   virtual uint32_t getEpoch() { return getSecondsSince2000() + EPOCH_TIME_OFF; } // UNIX time
+  virtual void now(DateTime& dt);
   virtual void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) = 0;
   virtual void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day);
   virtual void getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) = 0;
@@ -26,6 +315,7 @@ public:
   virtual uint8_t getDow() = 0;
   virtual void setSecondsSince2000(uint32_t t);
   virtual void setEpoch(uint32_t epoch) { setSecondsSince2000(epoch - EPOCH_TIME_OFF); } // UNIX time
+  virtual void commit(const RtcUpdate& update) = 0; // The driver's own commit, see RtcAdapter
   virtual void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow) = 0;
   virtual void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day);
   virtual void set(const char* date, const char* time);
@@ -47,9 +337,41 @@ public:
   virtual char *dateTimeToStr(char* str);
   virtual char *dateToStr(char* str);
   virtual char *timeToStr(char* str);
+};
+
+// RtcBase on top of a static dispatch driver, e.g.
+//   RtcDS3231 chip;
+//   RtcAdapter<RtcDS3231> rtc(chip);
+template <class Rtc>
+class RtcAdapter : public RtcBase {
+public:
+  RtcAdapter(Rtc& rtc) : _rtc(rtc) {}
+  virtual bool begin() { return _rtc.begin(); }
+  virtual uint32_t getSecondsSince2000() { return _rtc.getSecondsSince2000(); }
+  virtual void now(DateTime& dt) { _rtc.now(dt); }
+  virtual void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) { _rtc.get(hour, minute, second, year, month, day, dow); }
+  virtual void getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) { _rtc.getDate(year, month, day, dow); }
+  virtual void getTime(uint8_t& hour, uint8_t& minute, uint8_t& second) { _rtc.getTime(hour, minute, second); }
+  virtual uint8_t getHour() { return _rtc.getHour(); }
+  virtual uint8_t getMinute() { return _rtc.getMinute(); }
+  virtual uint8_t getSecond() { return _rtc.getSecond(); }
+  virtual uint16_t getYear() { return _rtc.getYear(); }
+  virtual uint8_t getMonth() { return _rtc.getMonth(); }
+  virtual uint8_t getDay() { return _rtc.getDay(); }
+  virtual uint8_t getDow() { return _rtc.getDow(); }
+  virtual void commit(const RtcUpdate& update) { _rtc.commit(update); }
+  virtual void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow) { _rtc.set(hour, minute, second, year, month, day, dow); }
+  virtual void setDate(uint16_t year, uint8_t month, uint8_t day, uint8_t dow) { _rtc.setDate(year, month, day, dow); }
+  virtual void setTime(uint8_t hour, uint8_t minute, uint8_t second) { _rtc.setTime(hour, minute, second); }
+  virtual void setHour(uint8_t hour) { _rtc.setHour(hour); }
+  virtual void setMinute(uint8_t minute) { _rtc.setMinute(minute); }
+  virtual void setSecond(uint8_t second) { _rtc.setSecond(second); }
+  virtual void setYear(uint16_t year) { _rtc.setYear(year); }
+  virtual void setMonth(uint8_t month) { _rtc.setMonth(month); }
+  virtual void setDay(uint8_t day) { _rtc.setDay(day); }
+  virtual void setDow(uint8_t dow) { _rtc.setDow(dow); }
 protected:
-  uint8_t bcd2bin(uint8_t val) { return val - 6 * (val >> 4); }
-  uint8_t bin2bcd(uint8_t val) { return val + 6 * (val / 10); }
+  Rtc& _rtc;
 };
 
 #endif
@@ -3,41 +3,833 @@
 
 #include "Rtc.h"
 
-class RtcDS1302 : public RtcBase {
+// See RtcDS1302.cpp for the description of the chip and the protocol.
+
+// Macros to convert the bcd values of the registers to normal
+// integer variables.
+// The code uses seperate variables for the high byte and the low byte
+// of the bcd, so these macros handle both bytes seperately.
+#define bcd2dec(h,l)  (((h)*10) + (l))
+#define dec2bcd_h(x)  ((x)/10)
+#define dec2bcd_l(x)  ((x)%10)
+
+// Register names.
+// Since the highest bit is always '1', 
+// the registers start at 0x80
+// If the register is read, the lowest bit should be '1'.
+#define DS1302_SECONDS           0x80
+#define DS1302_MINUTES           0x82
+#define DS1302_HOURS             0x84
+#define DS1302_DATE              0x86
+#define DS1302_MONTH             0x88
+#define DS1302_DAY               0x8A
+#define DS1302_YEAR              0x8C
+#define DS1302_ENABLE            0x8E
+#define DS1302_TRICKLE           0x90
+#define DS1302_CLOCK_BURST       0xBE
+#define DS1302_CLOCK_BURST_WRITE 0xBE
+#define DS1302_CLOCK_BURST_READ  0xBF
+#define DS1302_RAMSTART          0xC0
+#define DS1302_RAMEND            0xFC
+#define DS1302_RAM_BURST         0xFE
+#define DS1302_RAM_BURST_WRITE   0xFE
+#define DS1302_RAM_BURST_READ    0xFF
+
+#define DS1302_RAM_SIZE 31 // Bytes of battery-backed ram
+
+// Bus timing from the datasheet, in ns.
+// The 2.0V figures are used, the module runs at 3.3V.
+#define DS1302_T_CC   4000 // CE to CLK setup
+#define DS1302_T_CWH  4000 // CE inactive time
+#define DS1302_T_DC    200 // Data to CLK setup
+#define DS1302_T_CH   1000 // CLK high time
+#define DS1302_T_CL   1000 // CLK low time, covers tCDD = 800ns
+
+// Nanoseconds to CPU cycles, rounded up
+#define DS1302_CYCLES(ns) ((uint32_t)(((uint64_t)F_CPU * (ns) + 999999999UL) / 1000000000UL))
+
+// Defines for the bits, to be able to change 
+// between bit number and binary definition.
+// By using the bit number, using the DS1302 
+// is like programming an AVR microcontroller.
+// But instead of using "(1<<X)", or "_BV(X)", 
+// the Arduino "bit(X)" is used.
+#define DS1302_D0 0
+#define DS1302_D1 1
+#define DS1302_D2 2
+#define DS1302_D3 3
+#define DS1302_D4 4
+#define DS1302_D5 5
+#define DS1302_D6 6
+#define DS1302_D7 7
+
+// Bit for reading (bit in address)
+#define DS1302_READBIT DS1302_D0 // READBIT=1: read instruction
+
+// Bit for clock (0) or ram (1) area, 
+// called R/C-bit (bit in address)
+#define DS1302_RC DS1302_D6
+
+// Seconds Register
+#define DS1302_CH DS1302_D7   // 1 = Clock Halt, 0 = start
+
+// Hour Register
+#define DS1302_AM_PM DS1302_D5 // 0 = AM, 1 = PM
+#define DS1302_12_24 DS1302_D7 // 0 = 24 hour, 1 = 12 hour
+
+// Enable Register
+#define DS1302_WP DS1302_D7   // 1 = Write Protect, 0 = enabled
+
+// Trickle Register
+#define DS1302_ROUT0 DS1302_D0
+#define DS1302_ROUT1 DS1302_D1
+#define DS1302_DS0   DS1302_D2
+#define DS1302_DS1   DS1302_D2
+#define DS1302_TCS0  DS1302_D4
+#define DS1302_TCS1  DS1302_D5
+#define DS1302_TCS2  DS1302_D6
+#define DS1302_TCS3  DS1302_D7
+
+// Structure for the first 8 registers.
+// These 8 bytes can be read at once with 
+// the 'clock burst' command.
+// Note that this structure contains an anonymous union.
+// It might cause a problem on other compilers.
+struct ds1302_struct {
+  uint8_t Seconds : 4;      // low decimal digit 0-9
+  uint8_t Seconds10 : 3;    // high decimal digit 0-5
+  uint8_t CH : 1;           // CH = Clock Halt
+  uint8_t Minutes : 4;
+  uint8_t Minutes10 : 3;
+  uint8_t reserved1 : 1;
+  union {
+    struct {
+      uint8_t Hour : 4;
+      uint8_t Hour10 : 2;
+      uint8_t reserved2 : 1;
+      uint8_t hour_12_24 : 1; // 0 for 24 hour format
+    } h24;
+    struct {
+      uint8_t Hour : 4;
+      uint8_t Hour10 : 1;
+      uint8_t AM_PM : 1;      // 0 for AM, 1 for PM
+      uint8_t reserved2 : 1;
+      uint8_t hour_12_24 : 1; // 1 for 12 hour format
+    } h12;
+  };
+  uint8_t Date : 4;           // Day of month, 1 = first day
+  uint8_t Date10 : 2;
+  uint8_t reserved3 : 2;
+  uint8_t Month : 4;          // Month, 1 = January
+  uint8_t Month10 : 1;
+  uint8_t reserved4 : 3;
+  uint8_t Day : 3;            // Day of week, 1 = first day (any day)
+  uint8_t reserved5 : 5;
+  uint8_t Year : 4;           // Year, 0 = year 2000
+  uint8_t Year10 : 4;
+  uint8_t reserved6 : 7;
+  uint8_t WP : 1;             // WP = Write Protect
+};
+
+#define DS1302_INLINE inline __attribute__((always_inline))
+
+// Busy wait on the CPU cycle counter
+static DS1302_INLINE void ds1302Wait(uint32_t cycles) {
+#ifdef ESP8266
+  uint32_t start = ESP.getCycleCount();
+
+  while (ESP.getCycleCount() - start < cycles)
+    ;
+#else
+  delayMicroseconds((cycles * 1000000UL + F_CPU - 1) / F_CPU);
+#endif
+}
+
+// Pin access with the pins chosen at run time.
+// Pins below GPIO16 are driven through the GPIO set/clear registers,
+// the others through the Arduino functions.
+class Ds1302Pins {
 public:
-  RtcDS1302(uint8_t pinRst, uint8_t pinDat, uint8_t pinClk);
-  virtual bool begin();
-  virtual void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
-  virtual void getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
-  virtual void getTime(uint8_t& hour, uint8_t& minute, uint8_t& second);
-  virtual uint8_t getHour();
-  virtual uint8_t getMinute();
-  virtual uint8_t getSecond();
-  virtual uint16_t getYear();
-  virtual uint8_t getMonth();
-  virtual uint8_t getDay();
-  virtual uint8_t getDow();
-  virtual void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
-  virtual void setDate(uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
-  virtual void setTime(uint8_t hour, uint8_t minute, uint8_t second);
-  virtual void setHour(uint8_t hour);
-  virtual void setMinute(uint8_t minute);
-  virtual void setSecond(uint8_t second);
-  virtual void setYear(uint16_t year);
-  virtual void setMonth(uint8_t month);
-  virtual void setDay(uint8_t day);
-  virtual void setDow(uint8_t dow);
+  Ds1302Pins(uint8_t pinRst, uint8_t pinDat, uint8_t pinClk);
+  void setup();
+  DS1302_INLINE void rst(uint8_t value) { _write(_pinRst, _maskRst, value); }
+  DS1302_INLINE void clk(uint8_t value) { _write(_pinClk, _maskClk, value); }
+  DS1302_INLINE void dat(uint8_t value) { _write(_pinDat, _maskDat, value); }
+  DS1302_INLINE uint8_t datRead() {
+#ifdef ESP8266
+    if (_fast)
+      return (GPI & _maskDat) != 0;
+#endif
+    return digitalRead(_pinDat);
+  }
+  DS1302_INLINE void datMode(uint8_t mode) {
+#ifdef ESP8266
+    if (_fast) {
+      // The pin function was set by pinMode() in setup(),
+      // only the output driver is switched here
+      if (mode == OUTPUT)
+        GPES = _maskDat;
+      else
+        GPEC = _maskDat;
+      return;
+    }
+#endif
+    pinMode(_pinDat, mode);
+  }
 protected:
-  void _burstread(uint8_t *p);
-  void _burstwrite(uint8_t *p);
+  DS1302_INLINE void _write(uint8_t pin, uint32_t mask, uint8_t value) {
+#ifdef ESP8266
+    if (_fast) {
+      if (value)
+        GPOS = mask;
+      else
+        GPOC = mask;
+      return;
+    }
+#else
+    (void)mask;
+#endif
+    digitalWrite(pin, value);
+  }
+
+  uint8_t _pinRst, _pinDat, _pinClk;
+  uint32_t _maskRst, _maskDat, _maskClk; // GPIO register masks
+  bool _fast; // All pins are on the GPIO set/clear registers
+};
+
+// Pin access with the pins fixed at compile time.
+// The pin checks and masks are constants, every access folds into
+// a single register store or load.
+template <uint8_t pinRst, uint8_t pinDat, uint8_t pinClk>
+class Ds1302StaticPins {
+public:
+  static void setup() {
+    digitalWrite(pinRst, LOW); // default, not enabled
+    pinMode(pinRst, OUTPUT);
+
+    digitalWrite(pinClk, LOW); // default, clock low
+    pinMode(pinClk, OUTPUT);
+
+    pinMode(pinDat, OUTPUT);
+  }
+  static DS1302_INLINE void rst(uint8_t value) { _write<pinRst>(value); }
+  static DS1302_INLINE void clk(uint8_t value) { _write<pinClk>(value); }
+  static DS1302_INLINE void dat(uint8_t value) { _write<pinDat>(value); }
+  static DS1302_INLINE uint8_t datRead() {
+#ifdef ESP8266
+    if (_fast(pinDat))
+      return (GPI & _mask(pinDat)) != 0;
+#endif
+    return digitalRead(pinDat);
+  }
+  static DS1302_INLINE void datMode(uint8_t mode) {
+#ifdef ESP8266
+    if (_fast(pinDat)) {
+      if (mode == OUTPUT)
+        GPES = _mask(pinDat);
+      else
+        GPEC = _mask(pinDat);
+      return;
+    }
+#endif
+    pinMode(pinDat, mode);
+  }
+protected:
+  static constexpr bool _fast(uint8_t pin) { return pin < 16; }
+  static constexpr uint32_t _mask(uint8_t pin) { return 1UL << (pin & 0x1F); }
+  template <uint8_t pin>
+  static DS1302_INLINE void _write(uint8_t value) {
+#ifdef ESP8266
+    if (_fast(pin)) {
+      if (value)
+        GPOS = _mask(pin);
+      else
+        GPOC = _mask(pin);
+      return;
+    }
+#endif
+    digitalWrite(pin, value);
+  }
+};
+
+// States of an incremental clock read, see beginNow()
+#define DS1302_ASYNC_IDLE    0
+#define DS1302_ASYNC_COMMAND 1 // Shifting out the burst read command
+#define DS1302_ASYNC_DATA    2 // Shifting in the 64 clock data bits
+#define DS1302_ASYNC_DONE    3 // Result is waiting for result()
+
+#define DS1302_ASYNC_BITS    8 // Bits per poll() by default, about 20us
+
+typedef void (*RtcNowCallback)(const DateTime& dt);
+
+// The driver, on top of either pin access
+template <class Pins>
+class RtcDS1302Driver : public RtcCore<RtcDS1302Driver<Pins> > {
+public:
+  typedef RtcCore<RtcDS1302Driver<Pins> > Core;
+  using Core::get;
+  using Core::getDate;
+  using Core::set;
+  using Core::setDate;
+  using Core::setTime;
+
+  RtcDS1302Driver(const Pins& pins) : _pins(pins), _ready(false), _asyncState(DS1302_ASYNC_IDLE) {}
+  bool begin();
+  void now(DateTime& dt);
+  void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
+  void getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
+  void getTime(uint8_t& hour, uint8_t& minute, uint8_t& second);
+  uint8_t getHour();
+  uint8_t getMinute();
+  uint8_t getSecond();
+  uint16_t getYear();
+  uint8_t getMonth();
+  uint8_t getDay();
+  uint8_t getDow();
+  void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
+  void setDate(uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
+  void setTime(uint8_t hour, uint8_t minute, uint8_t second);
+  void setHour(uint8_t hour);
+  void setMinute(uint8_t minute);
+  void setSecond(uint8_t second);
+  void setYear(uint16_t year);
+  void setMonth(uint8_t month);
+  void setDay(uint8_t day);
+  void setDow(uint8_t dow);
+  // Incremental clock read, for callers that can not block for a whole burst.
+  // beginNow() opens the session, every poll() shifts at most 'bits' more bits
+  // and returns true once the snapshot is complete. The snapshot goes to the
+  // callback if one is given, otherwise it waits for result().
+  // A blocking transaction started meanwhile cancels the read.
+  bool beginNow(RtcNowCallback callback = NULL);
+  bool poll(uint8_t bits = DS1302_ASYNC_BITS);
+  bool busy() { return _asyncState != DS1302_ASYNC_IDLE; }
+  void result(DateTime& dt);
+  uint32_t startedAt() { return _asyncMillis; } // millis() when the chip latched the snapshot
+  // Battery-backed ram, addresses 0..DS1302_RAM_SIZE-1.
+  // The burst functions always start at address 0.
+  uint8_t readRam(uint8_t address);
+  void writeRam(uint8_t address, uint8_t data);
+  void readRam(uint8_t *buf, uint8_t len);
+  void writeRam(const uint8_t *buf, uint8_t len);
+protected:
+  void _decode(const uint8_t *p, DateTime& dt);
+  void _burstread(uint8_t *p, uint8_t len = 8, uint8_t command = DS1302_CLOCK_BURST_READ);
+  void _burstwrite(const uint8_t *p, uint8_t len = 8, uint8_t command = DS1302_CLOCK_BURST_WRITE);
   uint8_t _read(int address);
   void _write(int address, uint8_t data);
   void _start();
   void _stop();
   uint8_t _toggleread();
   void _togglewrite(uint8_t data, uint8_t release);
+  DS1302_INLINE uint8_t _readBit();
+  DS1302_INLINE void _writeBit(uint8_t bit, uint8_t release);
 
-  uint8_t _pinRst, _pinDat, _pinClk;
+  Pins _pins;
+  bool _ready; // Pins are configured
+  uint8_t _asyncState;
+  uint8_t _asyncBit; // Bits shifted in the current state
+  uint8_t _asyncBuf[8];
+  uint32_t _asyncMillis;
+  RtcNowCallback _asyncCallback;
+};
+
+/***
+ * RtcDS1302Driver class implementation
+ */
+
+template <class Pins>
+bool RtcDS1302Driver<Pins>::begin() {
+  // Disable Trickle Charger
+  _write(DS1302_TRICKLE, 0x00);
+
+  return true;
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::now(DateTime& dt) {
+  uint8_t buf[8];
+
+  // Read all clock data at once (burst mode)
+  _burstread(buf);
+  _decode(buf, dt);
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::_decode(const uint8_t *p, DateTime& dt) {
+  const ds1302_struct& rtc = *(const ds1302_struct *)p;
+
+  dt.hour = bcd2dec(rtc.h24.Hour10, rtc.h24.Hour);
+  dt.minute = bcd2dec(rtc.Minutes10, rtc.Minutes);
+  dt.second = bcd2dec(rtc.Seconds10, rtc.Seconds);
+  dt.year = bcd2dec(rtc.Year10, rtc.Year) + 2000;
+  dt.month = bcd2dec(rtc.Month10, rtc.Month);
+  dt.day = bcd2dec(rtc.Date10, rtc.Date);
+  dt.dow = rtc.Day;
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) {
+  DateTime dt;
+
+  now(dt);
+  hour = dt.hour;
+  minute = dt.minute;
+  second = dt.second;
+  year = dt.year;
+  month = dt.month;
+  day = dt.day;
+  dow = dt.dow;
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) {
+  ds1302_struct rtc;
+
+  // Read all clock data at once (burst mode)
+  _burstread((uint8_t *)&rtc);
+  year = bcd2dec(rtc.Year10, rtc.Year) + 2000;
+  month = bcd2dec(rtc.Month10, rtc.Month);
+  day = bcd2dec(rtc.Date10, rtc.Date);
+  dow = rtc.Day;
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::getTime(uint8_t& hour, uint8_t& minute, uint8_t& second) {
+  ds1302_struct rtc;
+
+  // Read all clock data at once (burst mode)
+  _burstread((uint8_t *)&rtc);
+  hour = bcd2dec(rtc.h24.Hour10, rtc.h24.Hour);
+  minute = bcd2dec(rtc.Minutes10, rtc.Minutes);
+  second = bcd2dec(rtc.Seconds10, rtc.Seconds);
+}
+
+template <class Pins>
+uint8_t RtcDS1302Driver<Pins>::getHour() {
+  return bcd2bin(_read(DS1302_HOURS));
+}
+
+template <class Pins>
+uint8_t RtcDS1302Driver<Pins>::getMinute() {
+  return bcd2bin(_read(DS1302_MINUTES));
+}
+
+template <class Pins>
+uint8_t RtcDS1302Driver<Pins>::getSecond() {
+  return bcd2bin(_read(DS1302_SECONDS));
+}
+
+template <class Pins>
+uint16_t RtcDS1302Driver<Pins>::getYear() {
+  return bcd2bin(_read(DS1302_YEAR)) + 2000;
+}
+
+template <class Pins>
+uint8_t RtcDS1302Driver<Pins>::getMonth() {
+  return bcd2bin(_read(DS1302_MONTH));
+}
+
+template <class Pins>
+uint8_t RtcDS1302Driver<Pins>::getDay() {
+  return bcd2bin(_read(DS1302_DATE));
+}
+
+template <class Pins>
+uint8_t RtcDS1302Driver<Pins>::getDow() {
+  return _read(DS1302_DAY);
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow) {
+  ds1302_struct rtc;
+
+  // Read all clock data at once (burst mode)
+//  _burstread((uint8_t *)&rtc);
+  rtc.Seconds = dec2bcd_l(second);
+  rtc.Seconds10 = dec2bcd_h(second);
+  rtc.Minutes = dec2bcd_l(minute);
+  rtc.Minutes10 = dec2bcd_h(minute);
+  rtc.h24.Hour = dec2bcd_l(hour);
+  rtc.h24.Hour10 = dec2bcd_h(hour);
+  rtc.h24.hour_12_24 = 0; // 0 for 24 hour format
+  rtc.Date = dec2bcd_l(day);
+  rtc.Date10 = dec2bcd_h(day);
+  rtc.Month = dec2bcd_l(month);
+  rtc.Month10 = dec2bcd_h(month);
+  rtc.Year = dec2bcd_l(year - 2000);
+  rtc.Year10 = dec2bcd_h(year - 2000);
+  rtc.Day = dow;
+  rtc.CH = 0; // 1 for Clock Halt, 0 to run;
+  rtc.WP = 0;
+  // Start by clearing the Write Protect bit
+  // Otherwise the clock data cannot be written
+  // The whole register is written, 
+  // but the WP-bit is the only bit in that register.
+  _write(DS1302_ENABLE, 0x00);
+  // Write all clock data at once (burst mode)
+  _burstwrite((uint8_t *)&rtc);
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::setDate(uint16_t year, uint8_t month, uint8_t day, uint8_t dow) {
+  ds1302_struct rtc;
+
+  // Read all clock data at once (burst mode)
+  _burstread((uint8_t *)&rtc);
+  rtc.Date = dec2bcd_l(day);
+  rtc.Date10 = dec2bcd_h(day);
+  rtc.Month = dec2bcd_l(month);
+  rtc.Month10 = dec2bcd_h(month);
+  rtc.Year = dec2bcd_l(year - 2000);
+  rtc.Year10 = dec2bcd_h(year - 2000);
+  rtc.Day = dow;
+  rtc.CH = 0; // 1 for Clock Halt, 0 to run;
+  rtc.WP = 0;
+  // Start by clearing the Write Protect bit
+  // Otherwise the clock data cannot be written
+  // The whole register is written, 
+  // but the WP-bit is the only bit in that register.
+  _write(DS1302_ENABLE, 0x00);
+  // Write all clock data at once (burst mode)
+  _burstwrite((uint8_t *)&rtc);
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::setTime(uint8_t hour, uint8_t minute, uint8_t second) {
+  ds1302_struct rtc;
+
+  // Read all clock data at once (burst mode)
+  _burstread((uint8_t *)&rtc);
+  rtc.Seconds = dec2bcd_l(second);
+  rtc.Seconds10 = dec2bcd_h(second);
+  rtc.Minutes = dec2bcd_l(minute);
+  rtc.Minutes10 = dec2bcd_h(minute);
+  rtc.h24.Hour = dec2bcd_l(hour);
+  rtc.h24.Hour10 = dec2bcd_h(hour);
+  rtc.h24.hour_12_24 = 0; // 0 for 24 hour format
+  rtc.CH = 0; // 1 for Clock Halt, 0 to run;
+  rtc.WP = 0;
+  // Start by clearing the Write Protect bit
+  // Otherwise the clock data cannot be written
+  // The whole register is written, 
+  // but the WP-bit is the only bit in that register.
+  _write(DS1302_ENABLE, 0x00);
+  // Write all clock data at once (burst mode)
+  _burstwrite((uint8_t *)&rtc);
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::setHour(uint8_t hour) {
+  // Start by clearing the Write Protect bit
+  // Otherwise the clock data cannot be written
+  // The whole register is written, 
+  // but the WP-bit is the only bit in that register.
+  _write(DS1302_ENABLE, 0x00);
+  _write(DS1302_HOURS, bin2bcd(hour));
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::setMinute(uint8_t minute) {
+  // Start by clearing the Write Protect bit
+  // Otherwise the clock data cannot be written
+  // The whole register is written, 
+  // but the WP-bit is the only bit in that register.
+  _write(DS1302_ENABLE, 0x00);
+  _write(DS1302_MINUTES, bin2bcd(minute));
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::setSecond(uint8_t second) {
+  // Start by clearing the Write Protect bit
+  // Otherwise the clock data cannot be written
+  // The whole register is written, 
+  // but the WP-bit is the only bit in that register.
+  _write(DS1302_ENABLE, 0x00);
+  _write(DS1302_SECONDS, bin2bcd(second));
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::setYear(uint16_t year) {
+  // Start by clearing the Write Protect bit
+  // Otherwise the clock data cannot be written
+  // The whole register is written, 
+  // but the WP-bit is the only bit in that register.
+  _write(DS1302_ENABLE, 0x00);
+  _write(DS1302_YEAR, bin2bcd(year - 2000));
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::setMonth(uint8_t month) {
+  // Start by clearing the Write Protect bit
+  // Otherwise the clock data cannot be written
+  // The whole register is written, 
+  // but the WP-bit is the only bit in that register.
+  _write(DS1302_ENABLE, 0x00);
+  _write(DS1302_MONTH, bin2bcd(month));
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::setDay(uint8_t day) {
+  // Start by clearing the Write Protect bit
+  // Otherwise the clock data cannot be written
+  // The whole register is written, 
+  // but the WP-bit is the only bit in that register.
+  _write(DS1302_ENABLE, 0x00);
+  _write(DS1302_DATE, bin2bcd(day));
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::setDow(uint8_t dow) {
+  // Start by clearing the Write Protect bit
+  // Otherwise the clock data cannot be written
+  // The whole register is written, 
+  // but the WP-bit is the only bit in that register.
+  _write(DS1302_ENABLE, 0x00);
+  _write(DS1302_DAY, dow);
+}
+
+template <class Pins>
+uint8_t RtcDS1302Driver<Pins>::readRam(uint8_t address) {
+  if (address >= DS1302_RAM_SIZE)
+    return 0;
+
+  return _read(DS1302_RAMSTART + (address << 1));
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::writeRam(uint8_t address, uint8_t data) {
+  if (address >= DS1302_RAM_SIZE)
+    return;
+  // Start by clearing the Write Protect bit
+  _write(DS1302_ENABLE, 0x00);
+  _write(DS1302_RAMSTART + (address << 1), data);
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::readRam(uint8_t *buf, uint8_t len) {
+  if (len > DS1302_RAM_SIZE)
+    len = DS1302_RAM_SIZE;
+  _burstread(buf, len, DS1302_RAM_BURST_READ);
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::writeRam(const uint8_t *buf, uint8_t len) {
+  if (len > DS1302_RAM_SIZE)
+    len = DS1302_RAM_SIZE;
+  // Start by clearing the Write Protect bit
+  _write(DS1302_ENABLE, 0x00);
+  // Unlike the clock burst, a ram burst may stop before the last byte
+  _burstwrite(buf, len, DS1302_RAM_BURST_WRITE);
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::_burstread(uint8_t *p, uint8_t len, uint8_t command) {
+  _start();
+  // Instead of the address, 
+  // the burst read command is issued
+  // the I/O-line is released for the data
+  _togglewrite(command, true);
+  for (uint8_t i = 0; i < len; i++) {
+    *p++ = _toggleread();
+  }
+  _stop();
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::_burstwrite(const uint8_t *p, uint8_t len, uint8_t command) {
+  _start();
+  // Instead of the address, 
+  // the burst write command is issued.
+  // the I/O-line is not released
+  _togglewrite(command, false);
+  for (uint8_t i = 0; i < len; i++) {
+    // the I/O-line is not released
+    _togglewrite(*p++, false);
+  }
+  _stop();
+}
+
+template <class Pins>
+uint8_t RtcDS1302Driver<Pins>::_read(int address) {
+  uint8_t data;
+
+  // set lowest bit (read bit) in address
+  bitSet(address, DS1302_READBIT);
+  _start();
+  // the I/O-line is released for the data
+  _togglewrite(address, true);
+  data = _toggleread();
+  _stop();
+
+  return data;
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::_write(int address, uint8_t data) {
+  // clear lowest bit (read bit) in address
+  bitClear(address, DS1302_READBIT);
+  _start();
+  // don't release the I/O-line
+  _togglewrite(address, false);
+  // don't release the I/O-line
+  _togglewrite(data, false);
+  _stop();
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::_start() {
+  if ((_asyncState == DS1302_ASYNC_COMMAND) || (_asyncState == DS1302_ASYNC_DATA)) {
+    // A blocking transaction cuts into an incremental read, drop the read
+    _stop();
+    _asyncState = DS1302_ASYNC_IDLE;
+  }
+  if (!_ready) {
+    _pins.setup();
+    _ready = true;
+  }
+  _pins.clk(LOW); // default, clock low
+  _pins.datMode(OUTPUT);
+
+  _pins.rst(HIGH); // start the session
+  ds1302Wait(DS1302_CYCLES(DS1302_T_CC));
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::_stop() {
+  // Set CE low
+  _pins.rst(LOW);
+
+  ds1302Wait(DS1302_CYCLES(DS1302_T_CWH));
+}
+
+template <class Pins>
+uint8_t RtcDS1302Driver<Pins>::_toggleread() {
+  uint8_t data = 0;
+
+  for (uint8_t i = 0; i <= 7; i++) {
+    // read bit, and set it in place in 'data' variable
+    bitWrite(data, i, _readBit());
+  }
+
+  return data;
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::_togglewrite(uint8_t data, uint8_t release) {
+  for (uint8_t i = 0; i <= 7; i++) {
+    _writeBit(bitRead(data, i), release && (i == 7));
+  }
+}
+
+template <class Pins>
+uint8_t RtcDS1302Driver<Pins>::_readBit() {
+  // Issue a clock pulse for the next databit.
+  // If the 'togglewrite' function was used before 
+  // this function, the SCLK is already high.
+  _pins.clk(HIGH);
+  ds1302Wait(DS1302_CYCLES(DS1302_T_CH));
+  // Clock down, data is ready after some time.
+  _pins.clk(LOW);
+  ds1302Wait(DS1302_CYCLES(DS1302_T_CL));
+
+  return _pins.datRead();
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::_writeBit(uint8_t bit, uint8_t release) {
+  // set a bit of the data on the I/O-line
+  _pins.dat(bit);
+  ds1302Wait(DS1302_CYCLES(DS1302_T_DC));
+  // clock up, data is read by DS1302
+  _pins.clk(HIGH);
+  ds1302Wait(DS1302_CYCLES(DS1302_T_CH));
+  if (release) {
+    // If this write is followed by a read, 
+    // the I/O-line should be released after 
+    // the last bit, before the clock line is made low.
+    // This is according the datasheet.
+    // I have seen other programs that don't release 
+    // the I/O-line at this moment, 
+    // and that could cause a shortcut spike 
+    // on the I/O-line.
+    _pins.datMode(INPUT);
+  } else {
+    _pins.clk(LOW);
+    ds1302Wait(DS1302_CYCLES(DS1302_T_CL));
+  }
+}
+
+template <class Pins>
+bool RtcDS1302Driver<Pins>::beginNow(RtcNowCallback callback) {
+  if (_asyncState != DS1302_ASYNC_IDLE)
+    return false;
+  _start();
+  // The chip copies the clock registers into its burst buffer 
+  // when the command arrives, the snapshot can not tear 
+  // however long the data bits take.
+  _asyncMillis = millis();
+  _asyncCallback = callback;
+  _asyncState = DS1302_ASYNC_COMMAND;
+  _asyncBit = 0;
+
+  return true;
+}
+
+template <class Pins>
+bool RtcDS1302Driver<Pins>::poll(uint8_t bits) {
+  // The DS1302 clock is static, the session can pause between any two bits
+  while (bits--) {
+    switch (_asyncState) {
+      case DS1302_ASYNC_COMMAND:
+        // the I/O-line is released after the last command bit
+        _writeBit(bitRead(DS1302_CLOCK_BURST_READ, _asyncBit), _asyncBit == 7);
+        if (++_asyncBit == 8) {
+          _asyncState = DS1302_ASYNC_DATA;
+          _asyncBit = 0;
+        }
+        break;
+      case DS1302_ASYNC_DATA:
+        bitWrite(_asyncBuf[_asyncBit >> 3], _asyncBit & 7, _readBit());
+        if (++_asyncBit == 64) {
+          _stop();
+          _asyncState = DS1302_ASYNC_DONE;
+          if (_asyncCallback) {
+            DateTime dt;
+
+            result(dt);
+            _asyncCallback(dt);
+          }
+          return true;
+        }
+        break;
+      default:
+        return false;
+    }
+  }
+
+  return false;
+}
+
+template <class Pins>
+void RtcDS1302Driver<Pins>::result(DateTime& dt) {
+  _decode(_asyncBuf, dt);
+  _asyncState = DS1302_ASYNC_IDLE;
+}
+
+// Runtime pins, compiled once in RtcDS1302.cpp
+extern template class RtcDS1302Driver<Ds1302Pins>;
+
+class RtcDS1302 : public RtcDS1302Driver<Ds1302Pins> {
+public:
+  RtcDS1302(uint8_t pinRst, uint8_t pinDat, uint8_t pinClk) : RtcDS1302Driver<Ds1302Pins>(Ds1302Pins(pinRst, pinDat, pinClk)) {}
+};
+
+// Pins fixed at compile time, e.g. RtcDS1302T<D7, D6, D5> rtc;
+template <uint8_t pinRst, uint8_t pinDat, uint8_t pinClk>
+class RtcDS1302T : public RtcDS1302Driver<Ds1302StaticPins<pinRst, pinDat, pinClk> > {
+public:
+  RtcDS1302T() : RtcDS1302Driver<Ds1302StaticPins<pinRst, pinDat, pinClk> >(Ds1302StaticPins<pinRst, pinDat, pinClk>()) {}
 };
 
 #endif
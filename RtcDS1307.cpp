@@ -26,19 +26,33 @@ bool RtcDS1307::begin() {
   return (status == 0);
 }
 
-void RtcDS1307::get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) {
+void RtcDS1307::now(DateTime& dt) {
   Wire.beginTransmission(DS1307_ADDRESS);
   Wire.write((byte)DS1307_SEC_REG);
   Wire.endTransmission();
 
+  // All clock registers at once, so the fields can not tear across a rollover
   Wire.requestFrom(DS1307_ADDRESS, 7);
-  second = bcd2bin(Wire.read());
-  minute = bcd2bin(Wire.read());
-  hour = bcd2bin(Wire.read() & ~0b11000000); // Ignore 24 Hour bit
-  dow = Wire.read();
-  day = bcd2bin(Wire.read());
-  month = bcd2bin(Wire.read());
-  year = bcd2bin(Wire.read()) + 2000;
+  dt.second = bcd2bin(Wire.read());
+  dt.minute = bcd2bin(Wire.read());
+  dt.hour = bcd2bin(Wire.read() & ~0b11000000); // Ignore 24 Hour bit
+  dt.dow = Wire.read();
+  dt.day = bcd2bin(Wire.read());
+  dt.month = bcd2bin(Wire.read());
+  dt.year = bcd2bin(Wire.read()) + 2000;
+}
+
+void RtcDS1307::get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) {
+  DateTime dt;
+
+  now(dt);
+  hour = dt.hour;
+  minute = dt.minute;
+  second = dt.second;
+  year = dt.year;
+  month = dt.month;
+  day = dt.day;
+  dow = dt.dow;
 }
 
 void RtcDS1307::getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) {
@@ -64,34 +78,51 @@ void RtcDS1307::getTime(uint8_t& hour, uint8_t& minute, uint8_t& second) {
   hour = bcd2bin(Wire.read() & ~0b11000000); // Ignore 24 Hour bit
 }
 
-inline uint8_t RtcDS1307::getHour() {
+uint8_t RtcDS1307::getHour() {
   return bcd2bin(_read(DS1307_HOUR_REG) & ~0b11000000); // Ignore 24 Hour bit
 }
 
-inline uint8_t RtcDS1307::getMinute() {
+uint8_t RtcDS1307::getMinute() {
   return bcd2bin(_read(DS1307_MIN_REG));
 }
 
-inline uint8_t RtcDS1307::getSecond() {
+uint8_t RtcDS1307::getSecond() {
   return bcd2bin(_read(DS1307_SEC_REG));
 }
 
-inline uint16_t RtcDS1307::getYear() {
+uint16_t RtcDS1307::getYear() {
   return bcd2bin(_read(DS1307_YEAR_REG)) + 2000;
 }
 
-inline uint8_t RtcDS1307::getMonth() {
+uint8_t RtcDS1307::getMonth() {
   return bcd2bin(_read(DS1307_MONTH_REG));
 }
 
-inline uint8_t RtcDS1307::getDay() {
+uint8_t RtcDS1307::getDay() {
   return bcd2bin(_read(DS1307_MDAY_REG));
 }
 
-inline uint8_t RtcDS1307::getDow() {
+uint8_t RtcDS1307::getDow() {
   return _read(DS1307_WDAY_REG);
 }
 
+void RtcDS1307::commit(const RtcUpdate& update) {
+  RtcRegisterRun run;
+  DateTime dt;
+
+  // The smallest run of registers that holds every change
+  if (!run.begin(update))
+    return;
+  if (run.needsRead())
+    now(dt); // One burst read for the unchanged registers in the run
+  run.encode(update, dt);
+
+  Wire.beginTransmission(DS1307_ADDRESS);
+  Wire.write((byte)(DS1307_SEC_REG + run.first));
+  Wire.write(run.data, run.length);
+  Wire.endTransmission();
+}
+
 void RtcDS1307::set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow) {
   Wire.beginTransmission(DS1307_ADDRESS);
   Wire.write((byte)DS1307_SEC_REG);  // beginning from SEC Register address
@@ -127,31 +158,31 @@ void RtcDS1307::setTime(uint8_t hour, uint8_t minute, uint8_t second) {
   Wire.endTransmission();
 }
 
-inline void RtcDS1307::setHour(uint8_t hour) {
+void RtcDS1307::setHour(uint8_t hour) {
   _write(DS1307_HOUR_REG, bin2bcd(hour));
 }
 
-inline void RtcDS1307::setMinute(uint8_t minute) {
+void RtcDS1307::setMinute(uint8_t minute) {
   _write(DS1307_MIN_REG, bin2bcd(minute));
 }
 
-inline void RtcDS1307::setSecond(uint8_t second) {
+void RtcDS1307::setSecond(uint8_t second) {
   _write(DS1307_SEC_REG, bin2bcd(second));
 }
 
-inline void RtcDS1307::setYear(uint16_t year) {
+void RtcDS1307::setYear(uint16_t year) {
   _write(DS1307_YEAR_REG, bin2bcd(year - 2000));
 }
 
-inline void RtcDS1307::setMonth(uint8_t month) {
+void RtcDS1307::setMonth(uint8_t month) {
   _write(DS1307_MONTH_REG, bin2bcd(month));
 }
 
-inline void RtcDS1307::setDay(uint8_t day) {
+void RtcDS1307::setDay(uint8_t day) {
   _write(DS1307_MDAY_REG, bin2bcd(day));
 }
 
-inline void RtcDS1307::setDow(uint8_t dow) {
+void RtcDS1307::setDow(uint8_t dow) {
   _write(DS1307_WDAY_REG, dow);
 }
 
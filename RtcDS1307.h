@@ -3,30 +3,38 @@
 
 #include "Rtc.h"
 
-class RtcDS1307 : public RtcBase {
+class RtcDS1307 : public RtcCore<RtcDS1307> {
 public:
+  using RtcCore<RtcDS1307>::get;
+  using RtcCore<RtcDS1307>::getDate;
+  using RtcCore<RtcDS1307>::set;
+  using RtcCore<RtcDS1307>::setDate;
+  using RtcCore<RtcDS1307>::setTime;
+
   RtcDS1307() {}
-  virtual bool begin();
-  virtual void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
-  virtual void getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
-  virtual void getTime(uint8_t& hour, uint8_t& minute, uint8_t& second);
-  virtual uint8_t getHour();
-  virtual uint8_t getMinute();
-  virtual uint8_t getSecond();
-  virtual uint16_t getYear();
-  virtual uint8_t getMonth();
-  virtual uint8_t getDay();
-  virtual uint8_t getDow();
-  virtual void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
-  virtual void setDate(uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
-  virtual void setTime(uint8_t hour, uint8_t minute, uint8_t second);
-  virtual void setHour(uint8_t hour);
-  virtual void setMinute(uint8_t minute);
-  virtual void setSecond(uint8_t second);
-  virtual void setYear(uint16_t year);
-  virtual void setMonth(uint8_t month);
-  virtual void setDay(uint8_t day);
-  virtual void setDow(uint8_t dow);
+  bool begin();
+  void now(DateTime& dt);
+  void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
+  void getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
+  void getTime(uint8_t& hour, uint8_t& minute, uint8_t& second);
+  uint8_t getHour();
+  uint8_t getMinute();
+  uint8_t getSecond();
+  uint16_t getYear();
+  uint8_t getMonth();
+  uint8_t getDay();
+  uint8_t getDow();
+  void commit(const RtcUpdate& update);
+  void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
+  void setDate(uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
+  void setTime(uint8_t hour, uint8_t minute, uint8_t second);
+  void setHour(uint8_t hour);
+  void setMinute(uint8_t minute);
+  void setSecond(uint8_t second);
+  void setYear(uint16_t year);
+  void setMonth(uint8_t month);
+  void setDay(uint8_t day);
+  void setDow(uint8_t dow);
 protected:
   uint8_t _read(byte address);
   void _write(byte address, byte value);
@@ -12,12 +12,29 @@
 #define DS3231_MONTH_REG  0x05
 #define DS3231_YEAR_REG   0x06
 
+#define DS3231_ALARM1_REG 0x07 // Seconds, minutes, hours, day/date
+#define DS3231_ALARM2_REG 0x0B // Minutes, hours, day/date
+
 #define DS3231_CONTROL_REG      0x0E
 #define DS3231_STATUS_REG       0x0F
-#define DS3231_AGING_OFFSET_REG 0x0F
+#define DS3231_AGING_OFFSET_REG 0x10
 #define DS3231_TMP_UP_REG       0x11
 #define DS3231_TMP_LOW_REG      0x12
 
+// Control register bits
+#define DS3231_CONTROL_A1IE  0x01
+#define DS3231_CONTROL_A2IE  0x02
+#define DS3231_CONTROL_INTCN 0x04
+#define DS3231_CONTROL_RS    0x18
+
+// Status register bits
+#define DS3231_STATUS_A1F 0x01
+#define DS3231_STATUS_A2F 0x02
+
+// Alarm register bits
+#define DS3231_ALARM_MASK 0x80 // AxMy, the field is not matched
+#define DS3231_ALARM_DYDT 0x40 // Day of week instead of day of month
+
 /***
  * RtcDS3231 class implementation
  */
@@ -31,19 +48,33 @@ bool RtcDS3231::begin() {
   return (status == 0);
 }
 
-void RtcDS3231::get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) {
+void RtcDS3231::now(DateTime& dt) {
   Wire.beginTransmission(DS3231_ADDRESS);
   Wire.write((byte)DS3231_SEC_REG);
   Wire.endTransmission();
 
+  // All clock registers at once, so the fields can not tear across a rollover
   Wire.requestFrom(DS3231_ADDRESS, 7);
-  second = bcd2bin(Wire.read());
-  minute = bcd2bin(Wire.read());
-  hour = bcd2bin(Wire.read() & ~0b11000000); // Ignore 24 Hour bit
-  dow = Wire.read();
-  day = bcd2bin(Wire.read());
-  month = bcd2bin(Wire.read() & ~0b10000000);
-  year = bcd2bin(Wire.read()) + 2000;
+  dt.second = bcd2bin(Wire.read());
+  dt.minute = bcd2bin(Wire.read());
+  dt.hour = bcd2bin(Wire.read() & ~0b11000000); // Ignore 24 Hour bit
+  dt.dow = Wire.read();
+  dt.day = bcd2bin(Wire.read());
+  dt.month = bcd2bin(Wire.read() & ~0b10000000);
+  dt.year = bcd2bin(Wire.read()) + 2000;
+}
+
+void RtcDS3231::get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) {
+  DateTime dt;
+
+  now(dt);
+  hour = dt.hour;
+  minute = dt.minute;
+  second = dt.second;
+  year = dt.year;
+  month = dt.month;
+  day = dt.day;
+  dow = dt.dow;
 }
 
 void RtcDS3231::getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow) {
@@ -69,34 +100,51 @@ void RtcDS3231::getTime(uint8_t& hour, uint8_t& minute, uint8_t& second) {
   hour = bcd2bin(Wire.read() & ~0b11000000); // Ignore 24 Hour bit
 }
 
-inline uint8_t RtcDS3231::getHour() {
+uint8_t RtcDS3231::getHour() {
   return bcd2bin(_read(DS3231_HOUR_REG) & ~0b11000000); // Ignore 24 Hour bit
 }
 
-inline uint8_t RtcDS3231::getMinute() {
+uint8_t RtcDS3231::getMinute() {
   return bcd2bin(_read(DS3231_MIN_REG));
 }
 
-inline uint8_t RtcDS3231::getSecond() {
+uint8_t RtcDS3231::getSecond() {
   return bcd2bin(_read(DS3231_SEC_REG));
 }
 
-inline uint16_t RtcDS3231::getYear() {
+uint16_t RtcDS3231::getYear() {
   return bcd2bin(_read(DS3231_YEAR_REG)) + 2000;
 }
 
-inline uint8_t RtcDS3231::getMonth() {
+uint8_t RtcDS3231::getMonth() {
   return bcd2bin(_read(DS3231_MONTH_REG) & ~0b10000000);
 }
 
-inline uint8_t RtcDS3231::getDay() {
+uint8_t RtcDS3231::getDay() {
   return bcd2bin(_read(DS3231_MDAY_REG));
 }
 
-inline uint8_t RtcDS3231::getDow() {
+uint8_t RtcDS3231::getDow() {
   return _read(DS3231_WDAY_REG);
 }
 
+void RtcDS3231::commit(const RtcUpdate& update) {
+  RtcRegisterRun run;
+  DateTime dt;
+
+  // The smallest run of registers that holds every change
+  if (!run.begin(update))
+    return;
+  if (run.needsRead())
+    now(dt); // One burst read for the unchanged registers in the run
+  run.encode(update, dt);
+
+  Wire.beginTransmission(DS3231_ADDRESS);
+  Wire.write((byte)(DS3231_SEC_REG + run.first));
+  Wire.write(run.data, run.length);
+  Wire.endTransmission();
+}
+
 void RtcDS3231::set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow) {
   Wire.beginTransmission(DS3231_ADDRESS);
   Wire.write((byte)DS3231_SEC_REG);  // beginning from SEC Register address
@@ -132,34 +180,87 @@ void RtcDS3231::setTime(uint8_t hour, uint8_t minute, uint8_t second) {
   Wire.endTransmission();
 }
 
-inline void RtcDS3231::setHour(uint8_t hour) {
+void RtcDS3231::setHour(uint8_t hour) {
   _write(DS3231_HOUR_REG, bin2bcd(hour));
 }
 
-inline void RtcDS3231::setMinute(uint8_t minute) {
+void RtcDS3231::setMinute(uint8_t minute) {
   _write(DS3231_MIN_REG, bin2bcd(minute));
 }
 
-inline void RtcDS3231::setSecond(uint8_t second) {
+void RtcDS3231::setSecond(uint8_t second) {
   _write(DS3231_SEC_REG, bin2bcd(second));
 }
 
-inline void RtcDS3231::setYear(uint16_t year) {
+void RtcDS3231::setYear(uint16_t year) {
   _write(DS3231_YEAR_REG, bin2bcd(year - 2000));
 }
 
-inline void RtcDS3231::setMonth(uint8_t month) {
+void RtcDS3231::setMonth(uint8_t month) {
   _write(DS3231_MONTH_REG, bin2bcd(month));
 }
 
-inline void RtcDS3231::setDay(uint8_t day) {
+void RtcDS3231::setDay(uint8_t day) {
   _write(DS3231_MDAY_REG, bin2bcd(day));
 }
 
-inline void RtcDS3231::setDow(uint8_t dow) {
+void RtcDS3231::setDow(uint8_t dow) {
   _write(DS3231_WDAY_REG, dow);
 }
 
+void RtcDS3231::setAlarm1(uint8_t mode, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second) {
+  uint8_t values[4] = { second, minute, hour, day };
+
+  _setAlarm(DS3231_ALARM1_REG, 4, mode, values);
+}
+
+void RtcDS3231::setAlarm2(uint8_t mode, uint8_t day, uint8_t hour, uint8_t minute) {
+  uint8_t values[3] = { minute, hour, day };
+
+  _setAlarm(DS3231_ALARM2_REG, 3, mode, values);
+}
+
+void RtcDS3231::enableAlarms(uint8_t alarms) {
+  // The alarms only reach the pin in interrupt mode
+  _update(DS3231_CONTROL_REG, DS3231_CONTROL_A1IE | DS3231_CONTROL_A2IE | DS3231_CONTROL_INTCN,
+    (alarms & (DS3231_ALARM1 | DS3231_ALARM2)) | (alarms ? DS3231_CONTROL_INTCN : 0));
+}
+
+uint8_t RtcDS3231::clearAlarms() {
+  uint8_t status = _read(DS3231_STATUS_REG);
+  uint8_t fired = status & (DS3231_STATUS_A1F | DS3231_STATUS_A2F);
+
+  if (fired)
+    _write(DS3231_STATUS_REG, status & ~fired);
+
+  return fired;
+}
+
+void RtcDS3231::setPinMode(uint8_t mode) {
+  _update(DS3231_CONTROL_REG, DS3231_CONTROL_INTCN | DS3231_CONTROL_RS, mode);
+}
+
+// Writes the 'count' alarm registers from 'reg' on in one transmission.
+// Bit i of 'mode' masks field i, bit 4 selects the day of week.
+void RtcDS3231::_setAlarm(uint8_t reg, uint8_t count, uint8_t mode, const uint8_t *values) {
+  Wire.beginTransmission(DS3231_ADDRESS);
+  Wire.write((byte)reg);
+  for (uint8_t i = 0; i < count; i++) {
+    byte value = bin2bcd(values[i]);
+    if (mode & (1 << i))
+      value |= DS3231_ALARM_MASK;
+    if ((i == count - 1) && (mode & 0x10))
+      value |= DS3231_ALARM_DYDT;
+    Wire.write(value);
+  }
+  Wire.endTransmission();
+}
+
+// Changes the bits in 'mask' of a register, keeps the others
+void RtcDS3231::_update(byte address, byte mask, byte value) {
+  _write(address, (_read(address) & ~mask) | (value & mask));
+}
+
 uint8_t RtcDS3231::_read(byte address) {
   Wire.beginTransmission(DS3231_ADDRESS);
   Wire.write((byte)address);
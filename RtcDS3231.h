@@ -3,31 +3,76 @@
 
 #include "Rtc.h"
 
-class RtcDS3231 : public RtcBase {
+// Alarm numbers, also the bits of enableAlarms() and clearAlarms()
+#define DS3231_ALARM1 0x01
+#define DS3231_ALARM2 0x02
+
+// Alarm 1 match modes, A1M1..A1M4 in bits 0..3 and DY/DT in bit 4
+#define DS3231_ALARM1_EVERY_SECOND 0x0F
+#define DS3231_ALARM1_MATCH_SECOND 0x0E // second
+#define DS3231_ALARM1_MATCH_MINUTE 0x0C // minute and second
+#define DS3231_ALARM1_MATCH_HOUR   0x08 // hour, minute and second, once a day
+#define DS3231_ALARM1_MATCH_DATE   0x00 // day of month, hour, minute and second
+#define DS3231_ALARM1_MATCH_DOW    0x10 // day of week, hour, minute and second
+
+// Alarm 2 match modes, A2M2..A2M4 in bits 0..2 and DY/DT in bit 4.
+// Alarm 2 has no seconds register, it fires at second 00.
+#define DS3231_ALARM2_EVERY_MINUTE 0x07
+#define DS3231_ALARM2_MATCH_MINUTE 0x06 // minute
+#define DS3231_ALARM2_MATCH_HOUR   0x04 // hour and minute, once a day
+#define DS3231_ALARM2_MATCH_DATE   0x00 // day of month, hour and minute
+#define DS3231_ALARM2_MATCH_DOW    0x10 // day of week, hour and minute
+
+// INT/SQW pin modes, the INTCN, RS1 and RS2 bits of the control register.
+// The pin is open drain and active low in every mode.
+#define DS3231_PIN_INTERRUPT 0x04 // Low while an enabled alarm flag is set
+#define DS3231_PIN_SQW_1HZ   0x00
+#define DS3231_PIN_SQW_1KHZ  0x08 // 1.024kHz
+#define DS3231_PIN_SQW_4KHZ  0x10 // 4.096kHz
+#define DS3231_PIN_SQW_8KHZ  0x18 // 8.192kHz
+
+class RtcDS3231 : public RtcCore<RtcDS3231> {
 public:
+  using RtcCore<RtcDS3231>::get;
+  using RtcCore<RtcDS3231>::getDate;
+  using RtcCore<RtcDS3231>::set;
+  using RtcCore<RtcDS3231>::setDate;
+  using RtcCore<RtcDS3231>::setTime;
+
   RtcDS3231() {}
-  virtual bool begin();
-  virtual void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
-  virtual void getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
-  virtual void getTime(uint8_t& hour, uint8_t& minute, uint8_t& second);
-  virtual uint8_t getHour();
-  virtual uint8_t getMinute();
-  virtual uint8_t getSecond();
-  virtual uint16_t getYear();
-  virtual uint8_t getMonth();
-  virtual uint8_t getDay();
-  virtual uint8_t getDow();
-  virtual void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
-  virtual void setDate(uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
-  virtual void setTime(uint8_t hour, uint8_t minute, uint8_t second);
-  virtual void setHour(uint8_t hour);
-  virtual void setMinute(uint8_t minute);
-  virtual void setSecond(uint8_t second);
-  virtual void setYear(uint16_t year);
-  virtual void setMonth(uint8_t month);
-  virtual void setDay(uint8_t day);
-  virtual void setDow(uint8_t dow);
+  bool begin();
+  void now(DateTime& dt);
+  void get(uint8_t& hour, uint8_t& minute, uint8_t& second, uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
+  void getDate(uint16_t& year, uint8_t& month, uint8_t& day, uint8_t& dow);
+  void getTime(uint8_t& hour, uint8_t& minute, uint8_t& second);
+  uint8_t getHour();
+  uint8_t getMinute();
+  uint8_t getSecond();
+  uint16_t getYear();
+  uint8_t getMonth();
+  uint8_t getDay();
+  uint8_t getDow();
+  void commit(const RtcUpdate& update);
+  void set(uint8_t hour, uint8_t minute, uint8_t second, uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
+  void setDate(uint16_t year, uint8_t month, uint8_t day, uint8_t dow);
+  void setTime(uint8_t hour, uint8_t minute, uint8_t second);
+  void setHour(uint8_t hour);
+  void setMinute(uint8_t minute);
+  void setSecond(uint8_t second);
+  void setYear(uint16_t year);
+  void setMonth(uint8_t month);
+  void setDay(uint8_t day);
+  void setDow(uint8_t dow);
+  // Alarms. 'day' is the day of month, or the day of week for the _DOW modes.
+  // Fields that the mode does not match are ignored.
+  void setAlarm1(uint8_t mode, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second);
+  void setAlarm2(uint8_t mode, uint8_t day, uint8_t hour, uint8_t minute);
+  void enableAlarms(uint8_t alarms); // DS3231_ALARM1 | DS3231_ALARM2, others are disabled
+  uint8_t clearAlarms(); // Returns the alarms that fired and releases the INT pin
+  void setPinMode(uint8_t mode);
 protected:
+  void _setAlarm(uint8_t reg, uint8_t count, uint8_t mode, const uint8_t *values);
+  void _update(byte address, byte mask, byte value);
   uint8_t _read(byte address);
   void _write(byte address, byte value);
 };
@@ -0,0 +1,67 @@
+#ifndef __RTCRAMSTORE_H
+#define __RTCRAMSTORE_H
+
+#include "RtcDS1302.h"
+
+#define RTCRAMSTORE_MAGIC 0xA5 // First ram byte of a stored record
+
+// Keeps a small record in the battery-backed ram of the DS1302.
+// The record is framed by a magic byte and a checksum, so an empty
+// or corrupted ram is recognized after the battery ran out.
+// A save costs one ram burst of a few microseconds and no flash
+// wear, and is skipped if the record did not change since the
+// last load or save.
+// T must be plain data of at most DS1302_RAM_SIZE - 2 bytes.
+template <class Rtc, class T>
+class RtcRamStore {
+public:
+  RtcRamStore(Rtc& rtc) : _rtc(rtc) { memset(_buf, 0, sizeof(_buf)); }
+  bool load(T& value);       // false if the ram holds no valid record
+  void save(const T& value);
+protected:
+  static uint8_t _checksum(const uint8_t *p, uint8_t len);
+
+  Rtc& _rtc;
+  uint8_t _buf[sizeof(T) + 2]; // magic, checksum, record as last seen in ram
+};
+
+/***
+ * RtcRamStore class implementation
+ */
+
+template <class Rtc, class T>
+bool RtcRamStore<Rtc, T>::load(T& value) {
+  static_assert(sizeof(T) + 2 <= DS1302_RAM_SIZE, "record does not fit in the DS1302 ram");
+
+  _rtc.readRam(_buf, sizeof(_buf));
+  if ((_buf[0] != RTCRAMSTORE_MAGIC) || (_buf[1] != _checksum(_buf + 2, sizeof(T)))) {
+    _buf[0] = 0; // force the next save
+    return false;
+  }
+  memcpy(&value, _buf + 2, sizeof(T));
+
+  return true;
+}
+
+template <class Rtc, class T>
+void RtcRamStore<Rtc, T>::save(const T& value) {
+  if ((_buf[0] == RTCRAMSTORE_MAGIC) && !memcmp(_buf + 2, &value, sizeof(T)))
+    return;
+  _buf[0] = RTCRAMSTORE_MAGIC;
+  memcpy(_buf + 2, &value, sizeof(T));
+  _buf[1] = _checksum(_buf + 2, sizeof(T));
+  _rtc.writeRam(_buf, sizeof(_buf));
+}
+
+template <class Rtc, class T>
+uint8_t RtcRamStore<Rtc, T>::_checksum(const uint8_t *p, uint8_t len) {
+  uint8_t sum = RTCRAMSTORE_MAGIC;
+
+  // Rotate and add, so swapped bytes change the sum too
+  while (len--)
+    sum = ((sum << 1) | (sum >> 7)) + *p++;
+
+  return sum;
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include "Schedule.h"
+#include <EEPROM.h>
+
+/***
+ * Schedule class implementation
+ */
+
+uint16_t Schedule::minuteOfWeek(uint32_t secondsSince2000) {
+  uint32_t days = secondsSince2000 / 86400UL;
+
+  return (days + 6) % 7 * 1440 + secondsSince2000 % 86400UL / 60;
+}
+
+bool Schedule::add(uint16_t minute, bool on) {
+  uint16_t entry = minute | (on ? SCHEDULE_ON : 0);
+  uint16_t i;
+
+  if (minute >= MINUTES_PER_WEEK)
+    return false;
+  i = _upper(minute);
+  if (i && ((_entries[i - 1] & SCHEDULE_MINUTE) == minute)) {
+    _entries[i - 1] = entry;
+    return true;
+  }
+  if (_count >= SCHEDULE_MAX_ENTRIES)
+    return false;
+  memmove(&_entries[i + 1], &_entries[i], (_count - i) * sizeof(_entries[0]));
+  _entries[i] = entry;
+  _count++;
+
+  return true;
+}
+
+bool Schedule::remove(uint16_t minute) {
+  uint16_t i = _upper(minute);
+
+  if (!i || ((_entries[i - 1] & SCHEDULE_MINUTE) != minute))
+    return false;
+  memmove(&_entries[i - 1], &_entries[i], (_count - i) * sizeof(_entries[0]));
+  _count--;
+
+  return true;
+}
+
+bool Schedule::contains(uint16_t minute) {
+  uint16_t i = _upper(minute);
+
+  return i && ((_entries[i - 1] & SCHEDULE_MINUTE) == minute);
+}
+
+int16_t Schedule::find(uint16_t minute) {
+  uint16_t i;
+
+  if (!_count)
+    return -1;
+  i = _upper(minute);
+
+  // Before the first entry of the week the last one is still in force
+  return i ? i - 1 : _count - 1;
+}
+
+uint16_t Schedule::next(uint16_t minute) {
+  uint16_t i = _upper(minute);
+
+  return i < _count ? i : 0;
+}
+
+bool Schedule::load() {
+  uint16_t count = EEPROM.read(SCHEDULE_EEPROM_ADDR + 1) | (EEPROM.read(SCHEDULE_EEPROM_ADDR + 2) << 8);
+
+  _count = 0;
+  if ((EEPROM.read(SCHEDULE_EEPROM_ADDR) != SCHEDULE_MAGIC) || (count > SCHEDULE_MAX_ENTRIES))
+    return false;
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t addr = SCHEDULE_EEPROM_ADDR + 4 + i * 2;
+    _entries[i] = EEPROM.read(addr) | (EEPROM.read(addr + 1) << 8);
+  }
+  _count = count;
+  if (EEPROM.read(SCHEDULE_EEPROM_ADDR + 3) != _checksum()) {
+    _count = 0;
+    return false;
+  }
+
+  return true;
+}
+
+void Schedule::save() {
+  // magic, count (LSB first), checksum, entries (LSB first)
+  EEPROM.write(SCHEDULE_EEPROM_ADDR, SCHEDULE_MAGIC);
+  EEPROM.write(SCHEDULE_EEPROM_ADDR + 1, _count & 0xFF);
+  EEPROM.write(SCHEDULE_EEPROM_ADDR + 2, _count >> 8);
+  EEPROM.write(SCHEDULE_EEPROM_ADDR + 3, _checksum());
+  for (uint16_t i = 0; i < _count; i++) {
+    uint16_t addr = SCHEDULE_EEPROM_ADDR + 4 + i * 2;
+    EEPROM.write(addr, _entries[i] & 0xFF);
+    EEPROM.write(addr + 1, _entries[i] >> 8);
+  }
+}
+
+uint16_t Schedule::_upper(uint16_t minute) {
+  uint16_t lo = 0, hi = _count;
+
+  while (lo < hi) {
+    uint16_t mid = (lo + hi) / 2;
+    SCHEDULE_PROBE();
+    if ((_entries[mid] & SCHEDULE_MINUTE) <= minute)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+uint8_t Schedule::_checksum() {
+  uint8_t sum = SCHEDULE_MAGIC;
+
+  // Rotate and add, so swapped entries change the sum too
+  for (uint16_t i = 0; i < _count; i++) {
+    sum = ((sum << 1) | (sum >> 7)) + (_entries[i] & 0xFF);
+    sum = ((sum << 1) | (sum >> 7)) + (_entries[i] >> 8);
+  }
+
+  return sum;
+}
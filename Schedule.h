@@ -0,0 +1,52 @@
+#ifndef __SCHEDULE_H
+#define __SCHEDULE_H
+
+#include <Arduino.h>
+
+#ifndef SCHEDULE_MAX_ENTRIES
+#define SCHEDULE_MAX_ENTRIES 240 // Fits the 512 bytes of EEPROM after the old on/off pair
+#endif
+#define SCHEDULE_EEPROM_ADDR 8    // Header and entries, see save()
+#define SCHEDULE_MAGIC       0x5C
+#define MINUTES_PER_WEEK     10080
+
+#ifdef SCHEDULE_COUNT_PROBES
+extern uint32_t scheduleProbes; // Entries read by the binary searches, test builds only
+#define SCHEDULE_PROBE() scheduleProbes++
+#else
+#define SCHEDULE_PROBE()
+#endif
+
+#define SCHEDULE_MINUTE 0x3FFF // Entry bits: minute of the week, 0 is Sunday 0:00
+#define SCHEDULE_ON     0x8000 // Entry bit: switch on, off if clear
+
+// Weekly table of relay transitions, sorted by the minute of the week.
+// An entry is one word: the minute and the action. The state at any
+// minute is the action of the last entry at or before it, the table
+// wraps around the end of the week. Lookups are binary searches, so
+// their cost barely grows with the table, inserts shift the entries
+// behind.
+class Schedule {
+public:
+  Schedule() : _count(0) {}
+  static uint16_t minuteOfWeek(uint32_t secondsSince2000); // 1.1.2000 was a Saturday
+  static uint16_t minuteOfWeek(uint8_t day, uint8_t hour, uint8_t minute) { return day * 1440 + hour * 60 + minute; } // day 0 is Sunday
+  bool add(uint16_t minute, bool on); // Replaces an entry at the same minute, false if full or out of range
+  bool remove(uint16_t minute);       // False if there is no entry at the minute
+  bool contains(uint16_t minute);     // There is an entry at the minute
+  void clear() { _count = 0; }
+  uint16_t count() { return _count; }
+  uint16_t operator[](uint16_t i) { return _entries[i]; }
+  int16_t find(uint16_t minute);      // Index of the entry in force at the minute, -1 if the table is empty
+  uint16_t next(uint16_t minute);     // Index of the first entry after the minute, the table must not be empty
+  bool load();                        // From EEPROM, false and empty if there is no valid table
+  void save();                        // To the EEPROM buffer, EEPROM.commit() is up to the caller
+protected:
+  uint16_t _upper(uint16_t minute);   // Number of entries at or before the minute
+  uint8_t _checksum();
+
+  uint16_t _entries[SCHEDULE_MAX_ENTRIES];
+  uint16_t _count;
+};
+
+#endif
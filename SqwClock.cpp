@@ -0,0 +1,56 @@
+#include "SqwClock.h"
+
+/***
+ * SqwClock class implementation
+ */
+
+SqwClock::SqwClock() {
+  _edges = 0;
+  _edgeMillis = 0;
+  _baseSeconds = 0;
+  _baseEdges = 0;
+  _last = 0;
+  _synced = false;
+}
+
+uint32_t SqwClock::edgeCount() {
+  return _edges;
+}
+
+uint32_t SqwClock::getSecondsSince2000() {
+  return getMillisSince2000() / 1000;
+}
+
+uint64_t SqwClock::getMillisSince2000() {
+  uint32_t edges, edgeMillis, ms;
+  uint64_t t;
+
+  _snapshot(edges, edgeMillis);
+  ms = millis() - edgeMillis;
+  // The next edge is due, hold at the end of the second until it comes
+  if (ms > 999)
+    ms = 999;
+  t = (uint64_t)(_baseSeconds + (edges - _baseEdges)) * 1000 + ms;
+  // Timestamps never decrease between syncs
+  if (t < _last)
+    t = _last;
+  _last = t;
+
+  return t;
+}
+
+void SqwClock::_sync(uint32_t seconds, uint32_t edges) {
+  _baseSeconds = seconds;
+  _baseEdges = edges;
+  // A sync is the one place the time may jump, also backwards after the chip was set
+  _last = 0;
+  _synced = true;
+}
+
+// Edge count and time of the last edge from the same edge
+void SqwClock::_snapshot(uint32_t& edges, uint32_t& edgeMillis) {
+  noInterrupts();
+  edges = _edges;
+  edgeMillis = _edgeMillis;
+  interrupts();
+}
@@ -0,0 +1,57 @@
+#ifndef __SQWCLOCK_H
+#define __SQWCLOCK_H
+
+#include "Rtc.h"
+
+// Millisecond clock on the 1Hz square wave of an RTC.
+// edge() counts the falling edges from an interrupt, the chip updates
+// its seconds on that edge. The chip is read once to give the count
+// a date, after that the seconds come from the edges and the
+// milliseconds from millis() since the last edge, without any reads.
+// The milliseconds stop at 999 if an edge is late, so the clock
+// never runs ahead of the chip and never goes back.
+class SqwClock {
+public:
+  SqwClock();
+  // Call from the interrupt handler of the SQW pin, FALLING edge
+  inline void edge() __attribute__((always_inline)) {
+    _edgeMillis = millis();
+    _edges++;
+  }
+  template <class Rtc> bool sync(Rtc& rtc); // False if no edge was seen yet or an edge came during the read
+  bool synced() { return _synced; }
+  void invalidate() { _synced = false; } // The chip was set, the edges need a new date
+  uint32_t edgeCount();
+  uint32_t getSecondsSince2000();
+  uint64_t getMillisSince2000();
+  void now(DateTime& dt) { fromSecondsSince2000(getSecondsSince2000(), dt); }
+protected:
+  void _sync(uint32_t seconds, uint32_t edges);
+  void _snapshot(uint32_t& edges, uint32_t& edgeMillis);
+
+  volatile uint32_t _edges;
+  volatile uint32_t _edgeMillis; // millis() at the last edge
+  uint32_t _baseSeconds;         // Chip time at edge number _baseEdges
+  uint32_t _baseEdges;
+  uint64_t _last;                // Last timestamp handed out
+  bool _synced;
+};
+
+template <class Rtc>
+bool SqwClock::sync(Rtc& rtc) {
+  DateTime dt;
+  uint32_t edges = edgeCount();
+
+  // Before the first edge the milliseconds have no reference
+  if (!edges)
+    return false;
+  rtc.now(dt);
+  // The read must fall into the second that started with the edge
+  if (edgeCount() != edges)
+    return false;
+  _sync(toSecondsSince2000(dt), edges);
+
+  return true;
+}
+
+#endif
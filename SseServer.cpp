@@ -0,0 +1,115 @@
+#include "SseServer.h"
+
+static const char SSE_HEADER[] PROGMEM =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: text/event-stream\r\n"
+  "Cache-Control: no-cache\r\n"
+  "Access-Control-Allow-Origin: *\r\n" // the page comes from port 80
+  "Connection: keep-alive\r\n"
+  "\r\n"
+  "retry: 5000\n\n";
+
+/***
+ * SseServer class implementation
+ */
+
+void SseServer::handle() {
+  _accept();
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (_state[i] == SSE_SLOT_FREE)
+      continue;
+    if (!_clients[i].connected())
+      _drop(i);
+    else if (_state[i] == SSE_SLOT_REQUEST) {
+      _read(i);
+    }
+  }
+  if (millis() - _keepalive >= SSE_KEEPALIVE) {
+    _keepalive = millis();
+    for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+      if (_state[i] != SSE_SLOT_OPEN)
+        continue;
+      if (_clients[i].availableForWrite() >= 3)
+        _clients[i].write((const uint8_t *)":\n\n", 3);
+      else
+        _drop(i);
+    }
+  }
+}
+
+void SseServer::broadcast(const char *event, const char *data) {
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if ((_state[i] == SSE_SLOT_OPEN) && !send(_clients[i], event, data))
+      _drop(i); // Too slow, the browser reconnects after the 'retry' time
+  }
+}
+
+bool SseServer::send(WiFiClient& client, const char *event, const char *data) {
+  char buf[SSE_EVENT_SIZE];
+  int len = snprintf(buf, sizeof(buf), "event: %s\ndata: %s\n\n", event, data);
+
+  if ((len <= 0) || (len >= (int)sizeof(buf)))
+    return true; // Too long, skipped
+  if (client.availableForWrite() < (size_t)len)
+    return false;
+  client.write((const uint8_t *)buf, len);
+
+  return true;
+}
+
+uint8_t SseServer::count() {
+  uint8_t n = 0;
+
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (_state[i] == SSE_SLOT_OPEN)
+      n++;
+  }
+
+  return n;
+}
+
+void SseServer::_accept() {
+  WiFiClient client = _server.available();
+
+  if (!client)
+    return;
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (_state[i] == SSE_SLOT_FREE) {
+      _clients[i] = client;
+      _clients[i].setNoDelay(true); // events are small and should go out at once
+      _state[i] = SSE_SLOT_REQUEST;
+      _match[i] = 0;
+      _since[i] = millis();
+      return;
+    }
+  }
+  // All slots taken, the browser retries after the 'retry' time
+  client.stop();
+}
+
+void SseServer::_read(uint8_t slot) {
+  WiFiClient& client = _clients[slot];
+
+  // The request itself does not matter, only where it ends
+  while (client.available()) {
+    char c = client.read();
+    if (c == ((_match[slot] & 1) ? '\n' : '\r')) {
+      if (++_match[slot] == 4) {
+        client.write_P(SSE_HEADER, sizeof(SSE_HEADER) - 1);
+        _state[slot] = SSE_SLOT_OPEN;
+        if (_onConnect)
+          _onConnect(client);
+        return;
+      }
+    } else {
+      _match[slot] = (c == '\r') ? 1 : 0;
+    }
+  }
+  if (millis() - _since[slot] >= SSE_REQUEST_TIMEOUT)
+    _drop(slot);
+}
+
+void SseServer::_drop(uint8_t slot) {
+  _clients[slot].stop();
+  _state[slot] = SSE_SLOT_FREE;
+}
@@ -0,0 +1,50 @@
+#ifndef __SSESERVER_H
+#define __SSESERVER_H
+
+#include <ESP8266WiFi.h>
+
+// Open event streams at a time. lwIP of core 2.4.0 has MEMP_NUM_TCP_PCB = 5
+// connections for everything: 2 streams, the client of ESP8266WebServer,
+// and 2 for new connections and closing ones in TIME_WAIT
+#define SSE_MAX_CLIENTS     2
+#define SSE_KEEPALIVE       15000UL // Comment line to every stream, ms. Also drops dead clients
+#define SSE_REQUEST_TIMEOUT 2000UL  // Time for a new client to send its request, ms
+#define SSE_EVENT_SIZE      128     // Longest event, name and data included
+
+#define SSE_SLOT_FREE    0
+#define SSE_SLOT_REQUEST 1 // Reading the request headers
+#define SSE_SLOT_OPEN    2 // Receives events
+
+// Server-Sent Events on a port of its own.
+// ESP8266WebServer serves one client at a time and keeps it until
+// it closes, an open event stream would block every other request.
+// Any request to this port becomes an event stream, the request
+// headers are read without blocking from handle().
+// A stream whose send buffer can not take the next event is dropped,
+// a write to it would block loop() until the client catches up.
+class SseServer {
+public:
+  typedef void (*ConnectCallback)(WiFiClient& client); // Sends the current state to a new stream
+
+  SseServer(uint16_t port) : _server(port), _onConnect(NULL), _keepalive(0) { memset(_state, SSE_SLOT_FREE, sizeof(_state)); }
+  void begin() { _server.begin(); }
+  void onConnect(ConnectCallback callback) { _onConnect = callback; }
+  void handle(); // Call from loop()
+  void broadcast(const char *event, const char *data);
+  static bool send(WiFiClient& client, const char *event, const char *data); // False if the send buffer had no room
+  uint8_t count(); // Open streams
+protected:
+  void _accept();
+  void _read(uint8_t slot);
+  void _drop(uint8_t slot);
+
+  WiFiServer _server;
+  WiFiClient _clients[SSE_MAX_CLIENTS];
+  uint8_t _state[SSE_MAX_CLIENTS];
+  uint8_t _match[SSE_MAX_CLIENTS];   // Characters of the "\r\n\r\n" ending the request seen so far
+  uint32_t _since[SSE_MAX_CLIENTS];  // millis() at the accept
+  ConnectCallback _onConnect;
+  uint32_t _keepalive;               // millis() at the last keep-alive
+};
+
+#endif
@@ -0,0 +1,185 @@
+#include "WeekRules.h"
+#include <EEPROM.h>
+
+// Rotate and add, so swapped bytes change the sum too
+static uint8_t checksumAdd(uint8_t sum, uint8_t data) {
+  return ((sum << 1) | (sum >> 7)) + data;
+}
+
+/***
+ * WeekRules class implementation
+ */
+
+bool WeekRules::validRule(uint8_t days, uint16_t from, uint16_t to) {
+  return (days & 0x7F) && (from < MINUTES_PER_DAY) && (to <= MINUTES_PER_DAY) && (from != to);
+}
+
+bool WeekRules::addRule(uint8_t days, uint16_t from, uint16_t to) {
+  if ((_ruleCount >= WEEKRULES_MAX_RULES) || !validRule(days, from, to))
+    return false;
+  _rules[_ruleCount].days = days & 0x7F;
+  _rules[_ruleCount].from = from;
+  _rules[_ruleCount].to = to;
+  _ruleCount++;
+
+  return true;
+}
+
+bool WeekRules::removeRule(uint8_t i) {
+  if (i >= _ruleCount)
+    return false;
+  memmove(&_rules[i], &_rules[i + 1], (_ruleCount - i - 1) * sizeof(WeekRule));
+  _ruleCount--;
+
+  return true;
+}
+
+bool WeekRules::addException(uint16_t day, uint16_t from, uint16_t to) {
+  int8_t i = _findException(day);
+
+  if ((from >= MINUTES_PER_DAY) || (to > MINUTES_PER_DAY))
+    return false;
+  if (i < 0) {
+    if (_exceptionCount >= WEEKRULES_MAX_EXCEPTIONS)
+      return false;
+    i = _exceptionCount++;
+  }
+  _exceptions[i].day = day;
+  _exceptions[i].from = from;
+  _exceptions[i].to = to;
+
+  return true;
+}
+
+bool WeekRules::removeException(uint8_t i) {
+  if (i >= _exceptionCount)
+    return false;
+  memmove(&_exceptions[i], &_exceptions[i + 1], (_exceptionCount - i - 1) * sizeof(WeekRuleException));
+  _exceptionCount--;
+
+  return true;
+}
+
+bool WeekRules::prune(uint16_t today) {
+  uint8_t n = 0;
+
+  // The exception of yesterday may still reach into today
+  for (uint8_t i = 0; i < _exceptionCount; i++) {
+    if (_exceptions[i].day + 1 >= today)
+      _exceptions[n++] = _exceptions[i];
+  }
+  if (n == _exceptionCount)
+    return false;
+  _exceptionCount = n;
+
+  return true;
+}
+
+void WeekRules::resolve(DayPlan& plan, uint16_t day) {
+  uint8_t weekday = (day + 6) % 7;
+  uint8_t yesterday = (weekday + 6) % 7;
+  int8_t today = _findException(day);
+  int8_t before = day ? _findException(day - 1) : -1; // Nothing before 1.1.2000
+
+  // An exception decides its whole date alone. The rules of the day
+  // after go on at midnight, except that the part of its window that
+  // reaches into the next morning replaces theirs of the day before.
+  if (today >= 0) {
+    const WeekRuleException& e = _exceptions[today];
+    if (e.from != e.to)
+      _window(plan, e.from, e.to, true);
+    return;
+  }
+  if (before >= 0)
+    _window(plan, _exceptions[before].from, _exceptions[before].to, false);
+  for (uint8_t i = 0; i < _ruleCount; i++) {
+    const WeekRule& r = _rules[i];
+    if (r.days & (1 << weekday))
+      _window(plan, r.from, r.to, true);
+    if ((before < 0) && (r.days & (1 << yesterday)))
+      _window(plan, r.from, r.to, false);
+  }
+}
+
+bool WeekRules::load() {
+  uint8_t rules = EEPROM.read(WEEKRULES_EEPROM_ADDR + 1);
+  uint8_t exceptions = EEPROM.read(WEEKRULES_EEPROM_ADDR + 2);
+  uint16_t addr = WEEKRULES_EEPROM_ADDR + 4;
+  uint8_t sum = WEEKRULES_MAGIC;
+  uint8_t b[6];
+
+  _ruleCount = 0;
+  _exceptionCount = 0;
+  if ((EEPROM.read(WEEKRULES_EEPROM_ADDR) != WEEKRULES_MAGIC) || (rules > WEEKRULES_MAX_RULES) || (exceptions > WEEKRULES_MAX_EXCEPTIONS))
+    return false;
+  for (uint8_t i = 0; i < rules; i++) {
+    for (uint8_t k = 0; k < 4; k++)
+      sum = checksumAdd(sum, b[k] = EEPROM.read(addr++));
+    uint32_t word = b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+    _rules[i].from = word & 0x7FF;
+    _rules[i].to = (word >> 11) & 0x7FF;
+    _rules[i].days = (word >> 22) & 0x7F;
+  }
+  for (uint8_t i = 0; i < exceptions; i++) {
+    for (uint8_t k = 0; k < 6; k++)
+      sum = checksumAdd(sum, b[k] = EEPROM.read(addr++));
+    _exceptions[i].day = b[0] | (b[1] << 8);
+    _exceptions[i].from = b[2] | (b[3] << 8);
+    _exceptions[i].to = b[4] | (b[5] << 8);
+  }
+  if (EEPROM.read(WEEKRULES_EEPROM_ADDR + 3) != sum)
+    return false;
+  _ruleCount = rules;
+  _exceptionCount = exceptions;
+
+  return true;
+}
+
+void WeekRules::save() {
+  uint16_t addr = WEEKRULES_EEPROM_ADDR + 4;
+  uint8_t sum = WEEKRULES_MAGIC;
+  uint8_t b[6];
+
+  // magic, rule count, exception count, checksum, rule words, exceptions (all LSB first)
+  for (uint8_t i = 0; i < _ruleCount; i++) {
+    uint32_t word = _rules[i].from | ((uint32_t)_rules[i].to << 11) | ((uint32_t)_rules[i].days << 22);
+    for (uint8_t k = 0; k < 4; k++) {
+      b[k] = word >> (8 * k);
+      sum = checksumAdd(sum, b[k]);
+      EEPROM.write(addr++, b[k]);
+    }
+  }
+  for (uint8_t i = 0; i < _exceptionCount; i++) {
+    const WeekRuleException& e = _exceptions[i];
+    b[0] = e.day & 0xFF;
+    b[1] = e.day >> 8;
+    b[2] = e.from & 0xFF;
+    b[3] = e.from >> 8;
+    b[4] = e.to & 0xFF;
+    b[5] = e.to >> 8;
+    for (uint8_t k = 0; k < 6; k++) {
+      sum = checksumAdd(sum, b[k]);
+      EEPROM.write(addr++, b[k]);
+    }
+  }
+  EEPROM.write(WEEKRULES_EEPROM_ADDR, WEEKRULES_MAGIC);
+  EEPROM.write(WEEKRULES_EEPROM_ADDR + 1, _ruleCount);
+  EEPROM.write(WEEKRULES_EEPROM_ADDR + 2, _exceptionCount);
+  EEPROM.write(WEEKRULES_EEPROM_ADDR + 3, sum);
+}
+
+int8_t WeekRules::_findException(uint16_t day) {
+  for (uint8_t i = 0; i < _exceptionCount; i++) {
+    if (_exceptions[i].day == day)
+      return i;
+  }
+
+  return -1;
+}
+
+void WeekRules::_window(DayPlan& plan, uint16_t from, uint16_t to, bool today) {
+  if (today)
+    plan.setInterval(from, to >= from ? to : MINUTES_PER_DAY);
+  else if (to < from)
+    plan.setInterval(0, to); // The part after midnight of a window that began yesterday
+}
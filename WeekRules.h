@@ -0,0 +1,63 @@
+#ifndef __WEEKRULES_H
+#define __WEEKRULES_H
+
+#include "DayPlan.h"
+
+#define WEEKRULES_MAX_RULES      16
+#define WEEKRULES_MAX_EXCEPTIONS 16
+#define WEEKRULES_EEPROM_ADDR    512 // After the on/off pair and the schedule table
+#define WEEKRULES_MAGIC          0x7E
+#define WEEKRULES_EEPROM_SIZE    (4 + WEEKRULES_MAX_RULES * 4 + WEEKRULES_MAX_EXCEPTIONS * 6)
+
+// On window on the weekdays of a mask, bit 0 is Sunday.
+// A window with to < from ends the next morning.
+struct WeekRule {
+  uint8_t days;
+  uint16_t from; // Minute of the day
+  uint16_t to;   // Minute of the day, up to MINUTES_PER_DAY
+};
+
+// One date that does not follow the schedule.
+// On that date only its window counts: the rules, the weekly table and
+// the on/off pair are left out, with their windows of the day before
+// that reach past midnight. from == to keeps the relay off all day.
+// One per date, a new one replaces it.
+struct WeekRuleException {
+  uint16_t day; // Days since 1.1.2000
+  uint16_t from;
+  uint16_t to;
+};
+
+// Recurring weekly windows with date exceptions.
+// resolve() turns them into the plan of one day, so the time they
+// take is spent once a day and not at every check.
+// In EEPROM a rule takes one 32-bit word (from in bits 0-10, to in
+// bits 11-21, the weekdays in bits 22-28), an exception 6 bytes.
+class WeekRules {
+public:
+  WeekRules() : _ruleCount(0), _exceptionCount(0) {}
+  bool addRule(uint8_t days, uint16_t from, uint16_t to); // False if full or invalid
+  static bool validRule(uint8_t days, uint16_t from, uint16_t to); // Some day, a window that is not empty
+  bool removeRule(uint8_t i);
+  bool addException(uint16_t day, uint16_t from, uint16_t to); // Replaces the one of the same date, false if full or invalid
+  bool removeException(uint8_t i);
+  bool prune(uint16_t today); // Drops the exceptions that can not matter any more, true if any
+  bool excepted(uint16_t day) { return _findException(day) >= 0; }
+  uint8_t ruleCount() { return _ruleCount; }
+  uint8_t exceptionCount() { return _exceptionCount; }
+  const WeekRule& rule(uint8_t i) { return _rules[i]; }
+  const WeekRuleException& exception(uint8_t i) { return _exceptions[i]; }
+  void resolve(DayPlan& plan, uint16_t day); // Or-s the windows of the day into the plan, only the exception's on an excepted date
+  bool load();                               // From EEPROM, false and empty if there is nothing valid
+  void save();                               // To the EEPROM buffer, EEPROM.commit() is up to the caller
+protected:
+  int8_t _findException(uint16_t day); // Index, -1 if the date has none
+  static void _window(DayPlan& plan, uint16_t from, uint16_t to, bool today);
+
+  WeekRule _rules[WEEKRULES_MAX_RULES];
+  WeekRuleException _exceptions[WEEKRULES_MAX_EXCEPTIONS];
+  uint8_t _ruleCount;
+  uint8_t _exceptionCount;
+};
+
+#endif
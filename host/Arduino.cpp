@@ -0,0 +1,440 @@
+#include <sys/time.h>
+#include "Host.h"
+#include "HostInternal.h"
+
+// The simulated board: clock, events, pins, interrupts and the serial port
+
+HardwareSerial Serial;
+EspClass ESP;
+
+HostGpioRegister GPO(0), GPOS(1), GPOC(2), GPE(3), GPES(4), GPEC(5), GPI(6);
+
+/***
+ * Time and events
+ */
+
+static uint64_t cycles = 0;
+static HostEvent *events = NULL; // Hardware, sorted by time
+static HostEvent *tasks = NULL;  // SDK tasks, sorted by time
+static bool realTime = false;
+static uint64_t realTimeBase = 0; // Host us at hostRealTime(true), minus the simulated us then
+
+static uint64_t hostMicros() {
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static void insert(HostEvent **list, HostEvent& event) {
+  while (*list && ((*list)->at <= event.at))
+    list = &(*list)->next;
+  event.next = *list;
+  *list = &event;
+}
+
+static void unlink(HostEvent **list, HostEvent& event) {
+  for (; *list; list = &(*list)->next) {
+    if (*list == &event) {
+      *list = event.next;
+      return;
+    }
+  }
+}
+
+void hostSchedule(HostEvent& event, uint64_t at) {
+  hostCancel(event);
+  event.at = at;
+  event.task = false;
+  event.armed = true;
+  insert(&events, event);
+}
+
+void hostScheduleTask(HostEvent& event, uint64_t at) {
+  hostCancel(event);
+  event.at = at;
+  event.task = true;
+  event.armed = true;
+  insert(&tasks, event);
+}
+
+void hostCancel(HostEvent& event) {
+  if (!event.armed)
+    return;
+  unlink(event.task ? &tasks : &events, event);
+  event.armed = false;
+}
+
+uint64_t hostCycles() {
+  return cycles;
+}
+
+void hostAdvance(uint64_t n) {
+  uint64_t target = cycles + n;
+
+  while (events && (events->at <= target)) {
+    HostEvent *e = events;
+    events = e->next;
+    e->armed = false;
+    if (e->at > cycles)
+      cycles = e->at;
+    e->fn(e->arg);
+  }
+  cycles = target;
+}
+
+void hostAdvanceMicros(uint64_t us) {
+  hostAdvance(us * HOST_CYCLES_PER_US);
+}
+
+void hostAdvanceMillis(uint64_t ms) {
+  hostAdvance(ms * 1000 * HOST_CYCLES_PER_US);
+}
+
+static void runTasks() {
+  while (tasks && (tasks->at <= cycles)) {
+    HostEvent *e = tasks;
+    tasks = e->next;
+    e->armed = false;
+    e->fn(e->arg);
+  }
+}
+
+void hostRealTime(bool on) {
+  realTime = on;
+  realTimeBase = hostMicros() - cycles / HOST_CYCLES_PER_US;
+}
+
+void hostYield() {
+  if (realTime) {
+    uint64_t now = (hostMicros() - realTimeBase) * HOST_CYCLES_PER_US;
+    if (now > cycles)
+      hostAdvance(now - cycles);
+  }
+  runTasks();
+  hostNetwork();
+}
+
+unsigned long millis() {
+  return (uint32_t)(cycles / (1000 * HOST_CYCLES_PER_US));
+}
+
+unsigned long micros() {
+  return (uint32_t)(cycles / HOST_CYCLES_PER_US);
+}
+
+void delayMicroseconds(unsigned int us) {
+  hostAdvanceMicros(us);
+}
+
+// The SDK runs its tasks while the sketch waits
+void delay(unsigned long ms) {
+  uint64_t target = cycles + (uint64_t)ms * 1000 * HOST_CYCLES_PER_US;
+
+  while (tasks && (tasks->at <= target)) {
+    if (tasks->at > cycles)
+      hostAdvance(tasks->at - cycles);
+    runTasks();
+  }
+  hostAdvance(target - cycles);
+  hostYield();
+}
+
+void yield() {
+  hostYield();
+}
+
+uint32_t EspClass::getCycleCount() {
+  hostAdvance(HOST_CYCLES_PER_READ);
+  return (uint32_t)cycles;
+}
+
+uint32_t EspClass::getFreeHeap() {
+  int64_t used = hostHeap().inUse - hostHeapAtBoot();
+
+  return used >= HOST_FREE_HEAP ? 0 : HOST_FREE_HEAP - used;
+}
+
+/***
+ * Pins and interrupts
+ */
+
+struct HostPin {
+  uint8_t latch;
+  uint8_t level;
+  bool output;
+  bool pullup;
+  int8_t external; // Level driven from outside, HOST_FLOAT if none
+  HostPinDevice *device;
+  void (*isr)(void);
+  int isrMode;
+  bool isrPending;
+};
+
+static HostPin pins[HOST_PINS];
+static uint32_t conflicts = 0;
+static uint32_t gpioCalls = 0;
+static bool interruptsOn = true;
+static bool pinsReady = false;
+
+static void setupPins() {
+  if (pinsReady)
+    return;
+  for (uint8_t i = 0; i < HOST_PINS; i++) {
+    memset(&pins[i], 0, sizeof(pins[i]));
+    pins[i].external = HOST_FLOAT;
+  }
+  pinsReady = true;
+}
+
+static void runIsr(HostPin& p) {
+  if (!interruptsOn) {
+    p.isrPending = true;
+    return;
+  }
+  p.isrPending = false;
+  p.isr();
+}
+
+// Level after a change of either end; the device hears only what the firmware did
+static void update(uint8_t pin, bool byFirmware) {
+  HostPin& p = pins[pin];
+  uint8_t level;
+
+  if (p.output && (p.external != HOST_FLOAT) && (p.external != p.latch))
+    conflicts++;
+  if (p.output)
+    level = p.latch;
+  else if (p.external != HOST_FLOAT)
+    level = p.external;
+  else
+    level = p.pullup ? HIGH : LOW; // The chips this board talks to pull down
+  if (level == p.level)
+    return;
+  p.level = level;
+  if (byFirmware && p.device)
+    p.device->pinChanged(pin, level);
+  if (p.isr && ((p.isrMode == CHANGE) || ((p.isrMode == RISING) == (level == HIGH))))
+    runIsr(p);
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  setupPins();
+  gpioCalls++;
+  if (pin >= HOST_PINS)
+    return;
+  pins[pin].output = mode == OUTPUT;
+  pins[pin].pullup = mode == INPUT_PULLUP;
+  update(pin, true);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  setupPins();
+  gpioCalls++;
+  if (pin >= HOST_PINS)
+    return;
+  pins[pin].latch = value ? HIGH : LOW;
+  update(pin, true);
+}
+
+int digitalRead(uint8_t pin) {
+  setupPins();
+  gpioCalls++;
+  if (pin >= HOST_PINS)
+    return LOW;
+  if (pins[pin].device)
+    pins[pin].device->pinSampled(pin);
+  return pins[pin].level;
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode) {
+  setupPins();
+  if (pin >= HOST_PINS)
+    return;
+  pins[pin].isr = handler;
+  pins[pin].isrMode = mode;
+  pins[pin].isrPending = false;
+}
+
+void detachInterrupt(uint8_t pin) {
+  if (pin < HOST_PINS)
+    pins[pin].isr = NULL;
+}
+
+void noInterrupts() {
+  interruptsOn = false;
+}
+
+void interrupts() {
+  interruptsOn = true;
+  for (uint8_t i = 0; i < HOST_PINS; i++) {
+    if (pins[i].isr && pins[i].isrPending)
+      runIsr(pins[i]);
+  }
+}
+
+void hostAttachPin(uint8_t pin, HostPinDevice *device) {
+  setupPins();
+  if (pin < HOST_PINS)
+    pins[pin].device = device;
+}
+
+void hostDrivePin(uint8_t pin, int level) {
+  setupPins();
+  if (pin >= HOST_PINS)
+    return;
+  pins[pin].external = level == HOST_FLOAT ? HOST_FLOAT : level ? HIGH : LOW;
+  update(pin, false);
+}
+
+uint8_t hostPinLevel(uint8_t pin) {
+  setupPins();
+  return pin < HOST_PINS ? pins[pin].level : LOW;
+}
+
+bool hostPinIsOutput(uint8_t pin) {
+  setupPins();
+  return (pin < HOST_PINS) && pins[pin].output;
+}
+
+uint32_t hostPinConflicts() {
+  return conflicts;
+}
+
+uint32_t hostGpioCalls() {
+  return gpioCalls;
+}
+
+// GPIO16 is not on the registers
+HostGpioRegister& HostGpioRegister::operator=(uint32_t value) {
+  setupPins();
+  for (uint8_t pin = 0; pin < 16; pin++) {
+    bool set = value & (1UL << pin);
+    switch (_id) {
+      case 0: // GPO
+        pins[pin].latch = set;
+        break;
+      case 1: // GPOS
+        if (set)
+          pins[pin].latch = HIGH;
+        break;
+      case 2: // GPOC
+        if (set)
+          pins[pin].latch = LOW;
+        break;
+      case 3: // GPE
+        pins[pin].output = set;
+        break;
+      case 4: // GPES
+        if (set)
+          pins[pin].output = true;
+        break;
+      case 5: // GPEC
+        if (set)
+          pins[pin].output = false;
+        break;
+      default: // GPI is read only
+        return *this;
+    }
+    update(pin, true);
+  }
+  return *this;
+}
+
+HostGpioRegister::operator uint32_t() const {
+  uint32_t value = 0;
+
+  setupPins();
+  for (uint8_t pin = 0; pin < 16; pin++) {
+    bool set;
+    switch (_id) {
+      case 0: // GPO
+        set = pins[pin].latch;
+        break;
+      case 3: // GPE
+        set = pins[pin].output;
+        break;
+      case 6: // GPI
+        if (pins[pin].device)
+          pins[pin].device->pinSampled(pin);
+        set = pins[pin].level;
+        break;
+      default: // The set/clear registers read as 0
+        set = false;
+    }
+    if (set)
+      value |= 1UL << pin;
+  }
+  return value;
+}
+
+/***
+ * Serial
+ */
+
+#define SERIAL_OUTPUT_SIZE 16384
+#define SERIAL_INPUT_SIZE  256
+
+static char serialOut[SERIAL_OUTPUT_SIZE + 1];
+static size_t serialOutLen = 0;
+static char serialIn[SERIAL_INPUT_SIZE];
+static size_t serialInHead = 0, serialInTail = 0;
+static bool serialEcho = false;
+
+int HardwareSerial::available() {
+  return serialInTail - serialInHead;
+}
+
+int HardwareSerial::read() {
+  return serialInHead < serialInTail ? (uint8_t)serialIn[serialInHead++] : -1;
+}
+
+int HardwareSerial::peek() {
+  return serialInHead < serialInTail ? (uint8_t)serialIn[serialInHead] : -1;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  if (serialEcho) {
+    fwrite(buffer, 1, size, stdout);
+    fflush(stdout);
+  }
+  for (size_t i = 0; i < size; i++) {
+    // Keeps the newer half when full
+    if (serialOutLen == SERIAL_OUTPUT_SIZE) {
+      memmove(serialOut, serialOut + SERIAL_OUTPUT_SIZE / 2, SERIAL_OUTPUT_SIZE / 2);
+      serialOutLen = SERIAL_OUTPUT_SIZE / 2;
+    }
+    serialOut[serialOutLen++] = buffer[i];
+  }
+  serialOut[serialOutLen] = 0;
+  return size;
+}
+
+void hostSerialInput(const char *text) {
+  size_t len = strlen(text);
+
+  if (serialInHead == serialInTail)
+    serialInHead = serialInTail = 0;
+  if (serialInTail + len > SERIAL_INPUT_SIZE)
+    len = SERIAL_INPUT_SIZE - serialInTail;
+  memcpy(serialIn + serialInTail, text, len);
+  serialInTail += len;
+}
+
+const char *hostSerialOutput() {
+  serialOut[serialOutLen] = 0;
+  return serialOut;
+}
+
+void hostSerialClear() {
+  serialOutLen = 0;
+  serialOut[0] = 0;
+}
+
+void hostSerialEcho(bool on) {
+  serialEcho = on;
+}
@@ -0,0 +1,120 @@
+#ifndef __HOST_ARDUINO_H
+#define __HOST_ARDUINO_H
+
+// Host build: the part of the ESP8266 Arduino core 2.4.0 the firmware
+// uses, on top of the simulated board in Host.h.
+// Time is simulated. It moves on when the firmware waits (delay(),
+// delayMicroseconds(), busy waits on ESP.getCycleCount()) and when a
+// test moves it, never by itself, so every run is repeatable. The run
+// time of the code between the waits is not modelled.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <algorithm>
+
+#include "pgmspace.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#ifndef F_CPU
+#define F_CPU 80000000L
+#endif
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x00
+#define OUTPUT       0x01
+#define INPUT_PULLUP 0x02
+
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define ICACHE_RAM_ATTR
+#define ICACHE_FLASH_ATTR
+
+// NodeMCU pin names
+#define D0 16
+#define D1 5
+#define D2 4
+#define D3 0
+#define D4 2
+#define D5 14
+#define D6 12
+#define D7 13
+#define D8 15
+
+#define digitalPinToInterrupt(p) (p)
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) (bitvalue ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+
+using std::min;
+using std::max;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t pin);
+void noInterrupts();
+void interrupts();
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// GPIO set/clear/enable/input registers of GPIO0..15.
+// Stores and loads go to the simulated pins, so the register fast
+// paths of the drivers run unchanged.
+class HostGpioRegister {
+public:
+  explicit HostGpioRegister(uint8_t id) : _id(id) {}
+  HostGpioRegister& operator=(uint32_t value);
+  operator uint32_t() const;
+protected:
+  uint8_t _id;
+};
+
+extern HostGpioRegister GPO;  // Output latches
+extern HostGpioRegister GPOS; // Output set
+extern HostGpioRegister GPOC; // Output clear
+extern HostGpioRegister GPE;  // Output enables
+extern HostGpioRegister GPES; // Output enable set
+extern HostGpioRegister GPEC; // Output enable clear
+extern HostGpioRegister GPI;  // Input levels
+
+class EspClass {
+public:
+  uint32_t getCycleCount(); // Every call takes HOST_CYCLES_PER_READ cycles
+  uint32_t getFreeHeap();
+  uint8_t getCpuFreqMHz() { return F_CPU / 1000000L; }
+  uint32_t getChipId() { return 0x00C0FFEE; }
+};
+
+extern EspClass ESP;
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+
+#endif
@@ -0,0 +1,74 @@
+#include "EEPROM.h"
+#include "Host.h"
+
+EEPROMClass EEPROM;
+
+static uint8_t flash[HOST_EEPROM_SECTOR];
+static bool flashErased = false;
+static uint32_t commits = 0;
+
+uint8_t *hostEepromFlash() {
+  if (!flashErased) {
+    memset(flash, 0xFF, sizeof(flash));
+    flashErased = true;
+  }
+  return flash;
+}
+
+uint32_t hostEepromCommits() {
+  return commits;
+}
+
+/***
+ * EEPROMClass class implementation
+ */
+
+void EEPROMClass::begin(size_t size) {
+  if ((size <= 0) || (size > HOST_EEPROM_SECTOR))
+    size = HOST_EEPROM_SECTOR;
+  size = (size + 3) & ~3;
+  delete[] _data;
+  _data = new uint8_t[size];
+  _size = size;
+  memcpy(_data, hostEepromFlash(), size);
+  _dirty = false;
+}
+
+uint8_t EEPROMClass::read(int address) {
+  if ((address < 0) || ((size_t)address >= _size))
+    return 0;
+  return _data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  if ((address < 0) || ((size_t)address >= _size))
+    return;
+  if (_data[address] != value) {
+    _data[address] = value;
+    _dirty = true;
+  }
+}
+
+bool EEPROMClass::commit() {
+  if (!_size)
+    return false;
+  if (!_dirty)
+    return true;
+  memcpy(hostEepromFlash(), _data, _size);
+  commits++;
+  hostAdvanceMicros(HOST_EEPROM_COMMIT_US);
+  _dirty = false;
+  return true;
+}
+
+void EEPROMClass::end() {
+  commit();
+  delete[] _data;
+  _data = NULL;
+  _size = 0;
+}
+
+uint8_t *EEPROMClass::getDataPtr() {
+  _dirty = true;
+  return _data;
+}
@@ -0,0 +1,39 @@
+#ifndef __HOST_EEPROM_H
+#define __HOST_EEPROM_H
+
+#include <Arduino.h>
+
+// EEPROM emulation of core 2.4.0: a RAM copy of one flash sector,
+// written back by commit(). The sector is Host.h's hostEepromFlash().
+class EEPROMClass {
+public:
+  EEPROMClass() : _data(NULL), _size(0), _dirty(false) {}
+  void begin(size_t size);
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+  bool commit();
+  void end();
+  uint8_t *getDataPtr();
+  size_t length() { return _size; }
+  template <typename T> T& get(int address, T& t) {
+    if ((address < 0) || (address + sizeof(T) > _size))
+      return t;
+    memcpy((uint8_t *)&t, _data + address, sizeof(T));
+    return t;
+  }
+  template <typename T> const T& put(int address, const T& t) {
+    if ((address < 0) || (address + sizeof(T) > _size))
+      return t;
+    memcpy(_data + address, (const uint8_t *)&t, sizeof(T));
+    _dirty = true;
+    return t;
+  }
+protected:
+  uint8_t *_data;
+  size_t _size;
+  bool _dirty;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
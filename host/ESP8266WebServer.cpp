@@ -0,0 +1,378 @@
+#include "ESP8266WebServer.h"
+#include "Host.h"
+
+// Loopback between hostHttpRequest() and the server
+#define HOST_HTTP_TARGET_SIZE  256
+#define HOST_HTTP_HEADERS_SIZE 512
+#define HOST_HTTP_WIRE_SIZE    65536
+
+static bool pending = false;
+static char requestTarget[HOST_HTTP_TARGET_SIZE];
+static char requestHeaders[HOST_HTTP_HEADERS_SIZE];
+static char wire[HOST_HTTP_WIRE_SIZE]; // The response as sent
+static size_t wireLen = 0;
+static char responseHeaders[HOST_HTTP_HEADERS_SIZE];
+static char responseBody[HOST_HTTP_WIRE_SIZE];
+static HostHttpResponse response;
+
+void hostHttpRequest(const char *target, const char *headers) {
+  snprintf(requestTarget, sizeof(requestTarget), "%s", target);
+  snprintf(requestHeaders, sizeof(requestHeaders), "%s", headers ? headers : "");
+  memset(&response, 0, sizeof(response));
+  response.headers = "";
+  response.body = "";
+  pending = true;
+}
+
+const HostHttpResponse& hostHttpResponse() {
+  return response;
+}
+
+const char *hostHttpHeader(const char *name) {
+  static char value[HOST_HTTP_HEADERS_SIZE];
+  size_t len = strlen(name);
+  const char *line = response.headers;
+
+  while (line && *line) {
+    const char *end = strstr(line, "\r\n");
+    if (!end)
+      break;
+    if (!strncasecmp(line, name, len) && (line[len] == ':')) {
+      const char *p = line + len + 1;
+      while (*p == ' ')
+        p++;
+      snprintf(value, sizeof(value), "%.*s", (int)(end - p), p);
+      return value;
+    }
+    line = end + 2;
+  }
+  return NULL;
+}
+
+// Splits the wire bytes into status, headers and body, the chunk framing removed
+static void parseResponse() {
+  const char *end;
+  const char *p;
+  size_t headersLen;
+
+  wire[wireLen] = 0;
+  response.wireBytes = wireLen;
+  response.code = atoi(wire + 9);
+  p = strstr(wire, "\r\n");
+  end = strstr(wire, "\r\n\r\n");
+  if (!p || !end)
+    return;
+  p += 2;
+  headersLen = min((size_t)(end + 2 - p), sizeof(responseHeaders) - 1);
+  memcpy(responseHeaders, p, headersLen);
+  responseHeaders[headersLen] = 0;
+  response.headers = responseHeaders;
+  p = end + 4;
+  response.bodyLength = 0;
+  if (hostHttpHeader("Transfer-Encoding")) {
+    unsigned long size;
+    char *next;
+    while ((size = strtoul(p, &next, 16)) > 0) {
+      p = next + 2;
+      memcpy(responseBody + response.bodyLength, p, size);
+      response.bodyLength += size;
+      p += size + 2;
+    }
+  } else {
+    response.bodyLength = wire + wireLen - p;
+    memcpy(responseBody, p, response.bodyLength);
+  }
+  responseBody[response.bodyLength] = 0;
+  response.body = responseBody;
+}
+
+/***
+ * ESP8266WebServer class implementation
+ */
+
+ESP8266WebServer::ESP8266WebServer(int port) {
+  (void)port;
+  _routes = NULL;
+  _currentArgs = NULL;
+  _currentArgCount = 0;
+  _currentHeaders = NULL;
+  _headerKeysCount = 0;
+  _contentLength = CONTENT_LENGTH_NOT_SET;
+  _chunked = false;
+}
+
+ESP8266WebServer::~ESP8266WebServer() {
+  while (_routes) {
+    Route *next = _routes->next;
+    delete _routes;
+    _routes = next;
+  }
+  delete[] _currentArgs;
+  delete[] _currentHeaders;
+}
+
+void ESP8266WebServer::on(const String& uri, THandlerFunction handler) {
+  Route *route = new Route;
+  Route **last = &_routes;
+
+  route->uri = uri;
+  route->handler = handler;
+  route->next = NULL;
+  while (*last)
+    last = &(*last)->next;
+  *last = route;
+}
+
+void ESP8266WebServer::handleClient() {
+  HostHeapStats before;
+  Route *route;
+
+  if (!pending)
+    return;
+  pending = false;
+  before = hostHeap();
+  hostHeapResetPeak();
+  wireLen = 0;
+  _parseRequest(requestTarget, requestHeaders);
+  _contentLength = CONTENT_LENGTH_NOT_SET;
+  _chunked = false;
+  for (route = _routes; route; route = route->next) {
+    if (route->uri == _currentUri)
+      break;
+  }
+  if (route)
+    route->handler();
+  else if (_notFound)
+    _notFound();
+  else
+    send(404, "text/plain", String("Not found: ") + _currentUri);
+  _currentUri = String();
+  response.allocations = hostHeap().allocations - before.allocations;
+  response.heapPeak = hostHeap().peak - before.inUse;
+  response.done = wireLen > 0;
+  parseResponse();
+}
+
+void ESP8266WebServer::_parseRequest(const char *target, const char *headers) {
+  String url(target);
+  String query;
+  int q = url.indexOf('?');
+  int count = 0;
+
+  if (q >= 0) {
+    query = url.substring(q + 1);
+    _currentUri = url.substring(0, q);
+  } else {
+    _currentUri = url;
+  }
+  delete[] _currentArgs;
+  _currentArgs = NULL;
+  if (query.length())
+    count = 1;
+  for (unsigned int i = 0; i < query.length(); i++) {
+    if (query[i] == '&')
+      count++;
+  }
+  _currentArgCount = 0;
+  if (count) {
+    int pos = 0;
+    _currentArgs = new RequestArgument[count + 1];
+    while (pos < (int)query.length()) {
+      int amp = query.indexOf('&', pos);
+      int end = (amp < 0) ? query.length() : amp;
+      String item = query.substring(pos, end);
+      int eq = item.indexOf('=');
+      RequestArgument& a = _currentArgs[_currentArgCount++];
+      if (eq < 0) {
+        a.key = _urlDecode(item);
+      } else {
+        a.key = _urlDecode(item.substring(0, eq));
+        a.value = _urlDecode(item.substring(eq + 1));
+      }
+      pos = end + 1;
+    }
+  }
+  for (int i = 0; i < _headerKeysCount; i++)
+    _currentHeaders[i].value = String();
+  while (headers && *headers) {
+    const char *end = strstr(headers, "\r\n");
+    const char *colon = strchr(headers, ':');
+    if (!end)
+      end = headers + strlen(headers);
+    if (colon && (colon < end)) {
+      String name = String(headers).substring(0, colon - headers);
+      const char *v = colon + 1;
+      while (*v == ' ')
+        v++;
+      for (int i = 0; i < _headerKeysCount; i++) {
+        if (_currentHeaders[i].key.equalsIgnoreCase(name))
+          _currentHeaders[i].value = String(v).substring(0, end - v);
+      }
+    }
+    headers = *end ? end + 2 : end;
+  }
+}
+
+String ESP8266WebServer::arg(String name) {
+  for (int i = 0; i < _currentArgCount; i++) {
+    if (_currentArgs[i].key == name)
+      return _currentArgs[i].value;
+  }
+  return String();
+}
+
+bool ESP8266WebServer::hasArg(String name) {
+  for (int i = 0; i < _currentArgCount; i++) {
+    if (_currentArgs[i].key == name)
+      return true;
+  }
+  return false;
+}
+
+void ESP8266WebServer::collectHeaders(const char *headerKeys[], const size_t headerKeysCount) {
+  _headerKeysCount = headerKeysCount + 1;
+  delete[] _currentHeaders;
+  _currentHeaders = new RequestArgument[_headerKeysCount];
+  _currentHeaders[0].key = "Authorization";
+  for (size_t i = 1; i < (size_t)_headerKeysCount; i++)
+    _currentHeaders[i].key = headerKeys[i - 1];
+}
+
+String ESP8266WebServer::header(String name) {
+  for (int i = 0; i < _headerKeysCount; i++) {
+    if (_currentHeaders[i].key.equalsIgnoreCase(name))
+      return _currentHeaders[i].value;
+  }
+  return String();
+}
+
+bool ESP8266WebServer::hasHeader(String name) {
+  for (int i = 0; i < _headerKeysCount; i++) {
+    if (_currentHeaders[i].key.equalsIgnoreCase(name) && _currentHeaders[i].value.length())
+      return true;
+  }
+  return false;
+}
+
+void ESP8266WebServer::sendHeader(const String& name, const String& value, bool first) {
+  String headerLine = name;
+
+  headerLine += ": ";
+  headerLine += value;
+  headerLine += "\r\n";
+  if (first)
+    _responseHeaders = headerLine + _responseHeaders;
+  else
+    _responseHeaders += headerLine;
+}
+
+void ESP8266WebServer::_prepareHeader(String& response, int code, const char *content_type, size_t contentLength) {
+  response = String("HTTP/1.1 ");
+  response += String(code);
+  response += " ";
+  response += _responseCodeToString(code);
+  response += "\r\n";
+  if (!content_type)
+    content_type = "text/html";
+  sendHeader(String("Content-Type"), String(content_type), true);
+  if (_contentLength == CONTENT_LENGTH_NOT_SET) {
+    sendHeader(String("Content-Length"), String(contentLength));
+  } else if (_contentLength != CONTENT_LENGTH_UNKNOWN) {
+    sendHeader(String("Content-Length"), String(_contentLength));
+  } else {
+    _chunked = true;
+    sendHeader(String("Accept-Ranges"), String("none"));
+    sendHeader(String("Transfer-Encoding"), String("chunked"));
+  }
+  sendHeader(String("Connection"), String("close"));
+  response += _responseHeaders;
+  response += "\r\n";
+  _responseHeaders = String();
+}
+
+void ESP8266WebServer::send(int code, const char *content_type, const String& content) {
+  String header;
+
+  _prepareHeader(header, code, content_type, content.length());
+  _write(header.c_str(), header.length());
+  if (content.length())
+    sendContent(content);
+}
+
+void ESP8266WebServer::send_P(int code, PGM_P content_type, PGM_P content) {
+  send_P(code, content_type, content, strlen_P(content));
+}
+
+void ESP8266WebServer::send_P(int code, PGM_P content_type, PGM_P content, size_t contentLength) {
+  String header;
+  char type[64];
+
+  memccpy_P(type, content_type, 0, sizeof(type));
+  _prepareHeader(header, code, type, contentLength);
+  _write(header.c_str(), header.length());
+  sendContent_P(content, contentLength);
+}
+
+void ESP8266WebServer::sendContent(const String& content) {
+  sendContent_P(content.c_str(), content.length());
+}
+
+void ESP8266WebServer::sendContent_P(PGM_P content) {
+  sendContent_P(content, strlen_P(content));
+}
+
+void ESP8266WebServer::sendContent_P(PGM_P content, size_t size) {
+  if (_chunked) {
+    char *chunkSize = (char *)malloc(11);
+    if (chunkSize) {
+      sprintf(chunkSize, "%x\r\n", (unsigned)size);
+      _write(chunkSize, strlen(chunkSize));
+      free(chunkSize);
+    }
+  }
+  _write(content, size);
+  if (_chunked) {
+    _write("\r\n", 2);
+    if (!size)
+      _chunked = false;
+  }
+}
+
+void ESP8266WebServer::_write(const char *data, size_t size) {
+  size = min(size, sizeof(wire) - 1 - wireLen);
+  memcpy(wire + wireLen, data, size);
+  wireLen += size;
+}
+
+String ESP8266WebServer::_urlDecode(const String& text) {
+  String decoded;
+  char hex[3] = { 0, 0, 0 };
+
+  for (unsigned int i = 0; i < text.length(); i++) {
+    char c = text[i];
+    if ((c == '%') && (i + 2 < text.length())) {
+      hex[0] = text[i + 1];
+      hex[1] = text[i + 2];
+      decoded += (char)strtol(hex, NULL, 16);
+      i += 2;
+    } else {
+      decoded += (c == '+') ? ' ' : c;
+    }
+  }
+  return decoded;
+}
+
+const char *ESP8266WebServer::_responseCodeToString(int code) {
+  switch (code) {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    case 507: return "Insufficient Storage";
+    default: return "";
+  }
+}
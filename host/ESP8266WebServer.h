@@ -0,0 +1,93 @@
+#ifndef __HOST_ESP8266WEBSERVER_H
+#define __HOST_ESP8266WEBSERVER_H
+
+#include <functional>
+#include <ESP8266WiFi.h>
+
+#define CONTENT_LENGTH_UNKNOWN  ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET  ((size_t) -2)
+#define HTTP_DOWNLOAD_UNIT_SIZE 1460 // streamFile() buffer, as WiFiClient::write(Stream&) of 2.4.0
+
+// ESP8266WebServer of core 2.4.0 with the request and the response
+// kept in memory instead of a WiFiClient: the request comes from
+// hostHttpRequest() of Host.h, the response goes to hostHttpResponse().
+// Requests, headers and responses are built from String the way the
+// core does it, so the heap traffic of a request matches the board.
+class ESP8266WebServer {
+public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  ESP8266WebServer(int port = 80);
+  ~ESP8266WebServer();
+  void begin() {}
+  void handleClient();
+  void on(const String& uri, THandlerFunction handler);
+  void onNotFound(THandlerFunction handler) { _notFound = handler; }
+
+  String uri() { return _currentUri; }
+  String arg(String name);
+  bool hasArg(String name);
+  int args() { return _currentArgCount; }
+  void collectHeaders(const char *headerKeys[], const size_t headerKeysCount);
+  String header(String name);
+  bool hasHeader(String name);
+
+  void send(int code, const char *content_type = NULL, const String& content = String(""));
+  void send(int code, char *content_type, const String& content) { send(code, (const char *)content_type, content); }
+  void send(int code, const String& content_type, const String& content) { send(code, content_type.c_str(), content); }
+  void send_P(int code, PGM_P content_type, PGM_P content);
+  void send_P(int code, PGM_P content_type, PGM_P content, size_t contentLength);
+  void setContentLength(const size_t contentLength) { _contentLength = contentLength; }
+  void sendHeader(const String& name, const String& value, bool first = false);
+  void sendContent(const String& content);
+  void sendContent_P(PGM_P content);
+  void sendContent_P(PGM_P content, size_t size);
+
+  template <typename T> size_t streamFile(T& file, const String& contentType) {
+    setContentLength(file.size());
+    if (String(file.name()).endsWith(".gz") && (contentType != "application/x-gzip") && (contentType != "application/octet-stream"))
+      sendHeader("Content-Encoding", "gzip");
+    send(200, contentType, "");
+    return _stream(file);
+  }
+protected:
+  struct RequestArgument {
+    String key;
+    String value;
+  };
+  struct Route {
+    String uri;
+    THandlerFunction handler;
+    Route *next;
+  };
+
+  void _parseRequest(const char *target, const char *headers);
+  void _prepareHeader(String& response, int code, const char *content_type, size_t contentLength);
+  void _write(const char *data, size_t size);
+  template <typename T> size_t _stream(T& file) {
+    uint8_t *buffer = new uint8_t[HTTP_DOWNLOAD_UNIT_SIZE];
+    size_t total = 0;
+    size_t n;
+    while ((n = file.read(buffer, HTTP_DOWNLOAD_UNIT_SIZE)) > 0) {
+      _write((const char *)buffer, n);
+      total += n;
+    }
+    delete[] buffer;
+    return total;
+  }
+  static String _urlDecode(const String& text);
+  static const char *_responseCodeToString(int code);
+
+  Route *_routes;
+  THandlerFunction _notFound;
+  String _currentUri;
+  RequestArgument *_currentArgs;
+  int _currentArgCount;
+  RequestArgument *_currentHeaders;
+  int _headerKeysCount;
+  String _responseHeaders;
+  size_t _contentLength;
+  bool _chunked;
+};
+
+#endif
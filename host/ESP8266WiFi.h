@@ -0,0 +1,22 @@
+#ifndef __HOST_ESP8266WIFI_H
+#define __HOST_ESP8266WIFI_H
+
+#include <Arduino.h>
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+
+// The access point is always up, the clients come from HostPeer
+class ESP8266WiFiClass {
+public:
+  bool softAP(const char *ssid, const char *passphrase = NULL, int channel = 1, int hidden = 0) {
+    (void)ssid;
+    (void)passphrase;
+    (void)channel;
+    (void)hidden;
+    return true;
+  }
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,155 @@
+#include "FS.h"
+#include "Host.h"
+
+#define FS_MAX_FILES 8
+#define FS_MAX_PATH  32
+
+struct HostFsEntry {
+  char path[FS_MAX_PATH];
+  uint8_t *data;
+  size_t size;
+};
+
+// An open file, shared by the copies of a File
+struct HostFile {
+  const HostFsEntry *entry;
+  size_t position;
+  int refs;
+};
+
+FS SPIFFS;
+
+static HostFsEntry files[FS_MAX_FILES];
+
+void hostFsWrite(const char *path, const void *data, size_t size) {
+  HostFsEntry *slot = NULL;
+
+  for (uint8_t i = 0; i < FS_MAX_FILES; i++) {
+    if (files[i].data && !strcmp(files[i].path, path)) {
+      slot = &files[i];
+      break;
+    }
+    if (!files[i].data && !slot)
+      slot = &files[i];
+  }
+  if (!slot || (strlen(path) >= FS_MAX_PATH))
+    return;
+  free(slot->data);
+  strcpy(slot->path, path);
+  slot->data = (uint8_t *)malloc(size ? size : 1);
+  memcpy(slot->data, data, size);
+  slot->size = size;
+}
+
+void hostFsClear() {
+  for (uint8_t i = 0; i < FS_MAX_FILES; i++) {
+    free(files[i].data);
+    files[i].data = NULL;
+  }
+}
+
+static const HostFsEntry *find(const char *path) {
+  for (uint8_t i = 0; i < FS_MAX_FILES; i++) {
+    if (files[i].data && !strcmp(files[i].path, path))
+      return &files[i];
+  }
+  return NULL;
+}
+
+/***
+ * FS class implementation
+ */
+
+File FS::open(const char *path, const char *mode) {
+  const HostFsEntry *entry = find(path);
+  HostFile *file;
+
+  if (!entry || strcmp(mode, "r"))
+    return File();
+  file = new HostFile;
+  file->entry = entry;
+  file->position = 0;
+  file->refs = 0;
+  return File(file);
+}
+
+bool FS::exists(const char *path) {
+  return find(path) != NULL;
+}
+
+/***
+ * File class implementation
+ */
+
+File::File(HostFile *file) : _file(file) {
+  if (_file)
+    _file->refs++;
+}
+
+File::File(const File& other) : _file(other._file) {
+  if (_file)
+    _file->refs++;
+}
+
+File& File::operator=(const File& other) {
+  if (other._file)
+    other._file->refs++;
+  close();
+  _file = other._file;
+  return *this;
+}
+
+File::~File() {
+  close();
+}
+
+void File::close() {
+  if (_file && !--_file->refs)
+    delete _file;
+  _file = NULL;
+}
+
+int File::available() {
+  return _file ? _file->entry->size - _file->position : 0;
+}
+
+int File::read() {
+  if (!available())
+    return -1;
+  return _file->entry->data[_file->position++];
+}
+
+int File::peek() {
+  if (!available())
+    return -1;
+  return _file->entry->data[_file->position];
+}
+
+size_t File::read(uint8_t *buffer, size_t size) {
+  size_t n = min(size, (size_t)available());
+
+  if (n) {
+    memcpy(buffer, _file->entry->data + _file->position, n);
+    _file->position += n;
+  }
+  return n;
+}
+
+size_t File::size() {
+  return _file ? _file->entry->size : 0;
+}
+
+size_t File::position() {
+  return _file ? _file->position : 0;
+}
+
+bool File::seek(uint32_t position) {
+  if (!_file || (position > _file->entry->size))
+    return false;
+  _file->position = position;
+  return true;
+}
+
+const char *File::name() const {
+  return _file ? _file->entry->path : "";
+}
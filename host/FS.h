@@ -0,0 +1,46 @@
+#ifndef __HOST_FS_H
+#define __HOST_FS_H
+
+#include <Arduino.h>
+
+struct HostFile;
+
+// SPIFFS of core 2.4.0, read only, on the files of hostFsWrite().
+// An open file holds a small heap object, as the FileImpl of the core does.
+class File : public Stream {
+public:
+  File() : _file(NULL) {}
+  File(HostFile *file);
+  File(const File& other);
+  File& operator=(const File& other);
+  ~File();
+  size_t write(uint8_t c) { (void)c; return 0; }
+  size_t write(const uint8_t *buffer, size_t size) { (void)buffer; (void)size; return 0; }
+  using Print::write;
+  int available();
+  int read();
+  int peek();
+  size_t read(uint8_t *buffer, size_t size);
+  size_t size();
+  size_t position();
+  bool seek(uint32_t position);
+  const char *name() const;
+  void close();
+  operator bool() const { return _file != NULL; }
+protected:
+  HostFile *_file;
+};
+
+class FS {
+public:
+  bool begin() { return true; }
+  void end() {}
+  File open(const char *path, const char *mode);
+  File open(const String& path, const char *mode) { return open(path.c_str(), mode); }
+  bool exists(const char *path);
+  bool exists(const String& path) { return exists(path.c_str()); }
+};
+
+extern FS SPIFFS;
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef __HOST_HARDWARESERIAL_H
+#define __HOST_HARDWARESERIAL_H
+
+#include "Stream.h"
+
+// Serial port of the simulated board. Output is kept for the test
+// (see hostSerialOutput()), input comes from hostSerialInput().
+// The baud rate is not modelled, a write takes no time.
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud) { _baud = baud; }
+  void end() {}
+  int available();
+  int read();
+  int peek();
+  size_t write(uint8_t c);
+  size_t write(const uint8_t *buffer, size_t size);
+  using Print::write;
+  operator bool() const { return true; }
+protected:
+  unsigned long _baud;
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef __HOST_H
+#define __HOST_H
+
+#include <Arduino.h>
+#include "HostEvent.h"
+
+// Control side of the simulated board, for tests and the simulated
+// chips. The firmware never includes this.
+
+#define HOST_CYCLES_PER_US   (F_CPU / 1000000L)
+#define HOST_CYCLES_PER_READ 4     // ESP.getCycleCount() in a busy wait: read, subtract, compare, branch
+#define HOST_FREE_HEAP       40960 // ESP.getFreeHeap() right after boot, about what the sketch leaves on the board
+
+/***
+ * Time
+ */
+
+uint64_t hostCycles();                 // CPU cycles since power on
+void hostAdvance(uint64_t cycles);     // Moves the clock, pin events and interrupts run on the way
+void hostAdvanceMicros(uint64_t us);
+void hostAdvanceMillis(uint64_t ms);
+void hostYield();                      // What the SDK does between two loop() passes: due Ticker callbacks and the network
+void hostRealTime(bool on);            // hostYield() keeps the clock in step with the host clock, for socket tests
+
+/***
+ * GPIO
+ */
+
+#define HOST_PINS  17
+#define HOST_FLOAT -1 // hostDrivePin(): released
+
+// A chip on some pins. pinChanged() sees every change of the level
+// the firmware drives, pinSampled() every read of the pin.
+class HostPinDevice {
+public:
+  virtual ~HostPinDevice() {}
+  virtual void pinChanged(uint8_t pin, uint8_t level) { (void)pin; (void)level; }
+  virtual void pinSampled(uint8_t pin) { (void)pin; }
+};
+
+void hostAttachPin(uint8_t pin, HostPinDevice *device); // One device per pin, NULL detaches
+void hostDrivePin(uint8_t pin, int level);              // From the outside: LOW, HIGH or HOST_FLOAT
+uint8_t hostPinLevel(uint8_t pin);
+bool hostPinIsOutput(uint8_t pin);
+uint32_t hostPinConflicts();                            // Times a pin was driven from both ends
+uint32_t hostGpioCalls();                               // pinMode(), digitalWrite() and digitalRead() so far, register accesses not counted
+
+/***
+ * I2C
+ */
+
+class HostI2cDevice {
+public:
+  virtual ~HostI2cDevice() {}
+  virtual void i2cWrite(const uint8_t *data, size_t length) = 0; // One transmission, the register pointer first
+  virtual void i2cRead(uint8_t *data, size_t length) = 0;
+};
+
+// START, 9 clocks per byte (ACK included) and STOP at 100 kHz
+#define HOST_I2C_BIT_US   10
+#define HOST_I2C_FRAME_US 10 // START and STOP
+#define HOST_I2C_US(bytes) (HOST_I2C_FRAME_US + (bytes) * 9 * HOST_I2C_BIT_US)
+
+struct HostI2cStats {
+  uint32_t transactions; // Transmissions and requests, each is one START ... STOP on the bus
+  uint32_t bytes;        // Address bytes included
+};
+
+void hostAttachI2c(uint8_t address, HostI2cDevice *device);
+HostI2cStats hostI2cStats();
+
+/***
+ * Flash
+ */
+
+#define HOST_EEPROM_SECTOR   4096
+#define HOST_EEPROM_COMMIT_US 25000 // Sector erase and write
+
+uint8_t *hostEepromFlash();     // The sector behind EEPROM, erased to 0xFF at power on
+uint32_t hostEepromCommits();   // Sector writes so far
+
+void hostFsWrite(const char *path, const void *data, size_t size); // File in the SPIFFS image
+void hostFsClear();
+
+/***
+ * Serial
+ */
+
+void hostSerialInput(const char *text);
+const char *hostSerialOutput(); // Everything written since the last hostSerialClear(), the last 16 KB
+void hostSerialClear();
+void hostSerialEcho(bool on);   // Also to stdout
+
+/***
+ * Heap, counted by the malloc() of the host build
+ */
+
+struct HostHeapStats {
+  uint64_t allocations; // malloc(), calloc(), a moving realloc(), new
+  uint64_t moves;       // Moving realloc() calls, they depend on the heap layout of the host
+  uint64_t frees;
+  int64_t inUse;        // Bytes
+  int64_t peak;         // Bytes, since hostHeapResetPeak()
+};
+
+HostHeapStats hostHeap();
+void hostHeapResetPeak();
+
+/***
+ * Network
+ */
+
+// TCP of the simulated lwIP. Raw pcbs (tcp_new() and friends) are
+// real sockets on 127.0.0.1, the WiFiServer connections stay in
+// memory and are reached through HostPeer. Both take pcbs from one
+// pool of MEMP_NUM_TCP_PCB, as on the board.
+uint16_t hostTcpPort(uint16_t port); // Host port a raw listener on 'port' was bound to, 0 if none
+uint8_t hostTcpPcbs();               // Pool pcbs in use
+uint32_t hostTcpKilled();            // Connections lwIP killed to make room for a new one
+
+// The far end of a WiFiServer connection
+class HostPeer {
+public:
+  HostPeer() : _pcb(NULL), _reset(false) {}
+  ~HostPeer() { close(); }
+  bool connect(uint16_t port); // False if lwIP had no pcb for it
+  void send(const char *text);
+  size_t receive(char *buf, size_t size); // Takes what the server sent, acks it
+  size_t pending();                       // Sent by the server and not taken yet
+  bool connected();                       // Neither end closed nor reset
+  bool reset();                           // The server side aborted or lwIP killed the connection
+  void close();
+protected:
+  friend class HostTcp;
+  struct tcp_pcb *_pcb; // NULL once the connection is gone
+  bool _reset;
+};
+
+// Loopback client of ESP8266WebServer. The request is taken by the
+// next server.handleClient().
+struct HostHttpResponse {
+  bool done;
+  int code;
+  const char *headers;  // Header lines of the response, "Name: value\r\n" each
+  const char *body;     // Without the chunk framing
+  size_t bodyLength;
+  size_t wireBytes;     // Status line, headers and body as sent, chunk framing included
+  uint64_t allocations; // Heap allocations while the request was handled
+  int64_t heapPeak;     // Peak heap above the level before the request, bytes
+};
+
+void hostHttpRequest(const char *target, const char *headers = NULL); // "GET" target, extra "Name: value\r\n" lines
+const HostHttpResponse& hostHttpResponse();
+const char *hostHttpHeader(const char *name); // Value from the last response, NULL if missing
+
+#endif
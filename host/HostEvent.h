@@ -0,0 +1,25 @@
+#ifndef __HOST_EVENT_H
+#define __HOST_EVENT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Something that happens at a cycle count. Events are owned by the
+// caller, scheduling one allocates nothing.
+struct HostEvent {
+  HostEvent(void (*fn)(void *arg), void *arg) : at(0), fn(fn), arg(arg), armed(false), task(false), next(NULL) {}
+  uint64_t at;
+  void (*fn)(void *arg);
+  void *arg;
+  bool armed;
+  bool task;
+  HostEvent *next;
+};
+
+void hostSchedule(HostEvent& event, uint64_t at);     // Hardware: runs at 'at', also in the middle of a busy wait
+void hostScheduleTask(HostEvent& event, uint64_t at); // SDK task: runs at the first hostYield() from 'at' on
+void hostCancel(HostEvent& event);
+
+uint64_t hostCycles(); // CPU cycles since power on
+
+#endif
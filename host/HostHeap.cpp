@@ -0,0 +1,115 @@
+#include <malloc.h>
+#include <errno.h>
+#include <atomic>
+#include "Host.h"
+#include "HostInternal.h"
+
+// malloc() and friends of the host build count what the firmware
+// allocates. new and delete of libstdc++ come through here as well.
+// The blocks come from glibc, sizes are what malloc_usable_size() says.
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *p, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *p);
+}
+
+static std::atomic<uint64_t> allocations(0);
+static std::atomic<uint64_t> moves(0);
+static std::atomic<uint64_t> frees(0);
+static std::atomic<int64_t> inUse(0);
+static std::atomic<int64_t> peak(0);
+static int64_t atBoot = 0;
+
+static void *counted(void *p) {
+  if (p) {
+    int64_t now = inUse += malloc_usable_size(p);
+    int64_t top = peak.load(std::memory_order_relaxed);
+    allocations++;
+    while ((now > top) && !peak.compare_exchange_weak(top, now))
+      ;
+  }
+  return p;
+}
+
+static void uncount(void *p) {
+  if (p) {
+    inUse -= malloc_usable_size(p);
+    frees++;
+  }
+}
+
+extern "C" void *malloc(size_t size) {
+  return counted(__libc_malloc(size));
+}
+
+extern "C" void *calloc(size_t count, size_t size) {
+  return counted(__libc_calloc(count, size));
+}
+
+extern "C" void *realloc(void *p, size_t size) {
+  size_t before = p ? malloc_usable_size(p) : 0;
+  void *q;
+
+  if (!p)
+    return malloc(size);
+  if (!size) {
+    free(p);
+    return NULL;
+  }
+  q = __libc_realloc(p, size);
+  if (!q)
+    return NULL;
+  if (q != p) {
+    // A move is a new block and a free
+    inUse -= before;
+    frees++;
+    moves++;
+    return counted(q);
+  }
+  inUse += (int64_t)malloc_usable_size(q) - (int64_t)before;
+  return q;
+}
+
+extern "C" void free(void *p) {
+  uncount(p);
+  __libc_free(p);
+}
+
+extern "C" void *memalign(size_t alignment, size_t size) {
+  return counted(__libc_memalign(alignment, size));
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size) {
+  return counted(__libc_memalign(alignment, size));
+}
+
+extern "C" int posix_memalign(void **p, size_t alignment, size_t size) {
+  *p = counted(__libc_memalign(alignment, size));
+  return *p ? 0 : ENOMEM;
+}
+
+__attribute__((constructor)) static void heapBoot() {
+  atBoot = inUse;
+}
+
+HostHeapStats hostHeap() {
+  HostHeapStats stats;
+
+  stats.allocations = allocations;
+  stats.moves = moves;
+  stats.frees = frees;
+  stats.inUse = inUse;
+  stats.peak = peak;
+  return stats;
+}
+
+void hostHeapResetPeak() {
+  peak = inUse.load();
+}
+
+int64_t hostHeapAtBoot() {
+  return atBoot;
+}
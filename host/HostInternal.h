@@ -0,0 +1,14 @@
+#ifndef __HOST_INTERNAL_H
+#define __HOST_INTERNAL_H
+
+// Between the parts of the simulated board
+
+#include <stdint.h>
+
+struct tcp_pcb;
+
+void hostNetwork();       // lwIP timers and socket I/O, from hostYield()
+bool hostWiFiAccept(uint16_t port, struct tcp_pcb *pcb); // A HostPeer connection for the WiFiServer on port
+int64_t hostHeapAtBoot(); // Bytes in use when the program started
+
+#endif
@@ -0,0 +1,23 @@
+#include "Host.h"
+#include "SimDS1302.h"
+
+// The sketch as a host program, with a DS1302 on its pins. Built with
+// USE_ASYNC_HTTP the web server listens on a real port of 127.0.0.1,
+// tools/httpbench.py can drive it.
+
+void setup();
+void loop();
+
+int main() {
+  SimDS1302 chip(D7, D6, D5);
+
+  hostSerialEcho(true);
+  hostRealTime(true);
+  setup();
+  printf("HTTP on 127.0.0.1:%u\n", hostTcpPort(80));
+  fflush(stdout);
+  for (;;) {
+    loop();
+    hostYield();
+  }
+}
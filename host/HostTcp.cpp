@@ -0,0 +1,536 @@
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include "Host.h"
+#include "HostInternal.h"
+
+#undef TCP_MSS // The socket option of netinet/tcp.h, lwIP has its own
+
+extern "C" {
+#include "lwip/tcp.h"
+}
+
+// lwIP of the simulated board. The pool of MEMP_NUM_TCP_PCB pcbs and
+// tcp_kill_prio() follow lwIP 2.0; segments, windows and retransmits
+// are left to the host kernel. Callbacks run from hostNetwork() only,
+// never from inside a call of the firmware, as in lwIP.
+
+const ip_addr_t ip_addr_any = { 0 };
+
+static tcp_pcb pool[MEMP_NUM_TCP_PCB];
+static tcp_pcb listeners[MEMP_NUM_TCP_PCB_LISTEN];
+static uint32_t killed = 0;
+
+// Reaches into HostPeer, see Host.h
+class HostTcp {
+public:
+  static void detach(tcp_pcb *pcb, bool reset) {
+    if (!pcb->peer)
+      return;
+    pcb->peer->_pcb = NULL;
+    pcb->peer->_reset = reset;
+    pcb->peer = NULL;
+  }
+  static void attach(HostPeer *peer, tcp_pcb *pcb) {
+    peer->_pcb = pcb;
+    peer->_reset = false;
+    pcb->peer = peer;
+  }
+};
+
+/***
+ * pbufs
+ */
+
+struct pbuf *pbuf_alloc_ram(u16_t length) {
+  struct pbuf *p = (struct pbuf *)malloc(sizeof(struct pbuf) + length);
+
+  if (!p)
+    return NULL;
+  p->next = NULL;
+  p->payload = p + 1;
+  p->tot_len = length;
+  p->len = length;
+  p->ref = 1;
+  return p;
+}
+
+u8_t pbuf_free(struct pbuf *p) {
+  u8_t n = 0;
+
+  while (p && !--p->ref) {
+    struct pbuf *next = p->next;
+    free(p);
+    n++;
+    p = next;
+  }
+  return n;
+}
+
+void pbuf_ref(struct pbuf *p) {
+  if (p)
+    p->ref++;
+}
+
+void pbuf_cat(struct pbuf *head, struct pbuf *tail) {
+  struct pbuf *p;
+
+  for (p = head; p->next; p = p->next)
+    p->tot_len += tail->tot_len;
+  p->tot_len += tail->tot_len;
+  p->next = tail;
+}
+
+/***
+ * The pool
+ */
+
+static void reset(tcp_pcb *pcb) {
+  memset(pcb, 0, sizeof(*pcb));
+  pcb->fd = -1;
+  pcb->prio = TCP_PRIO_NORMAL;
+  pcb->rcv_wnd = TCP_WND;
+  pcb->active = millis();
+  pcb->polled = pcb->active;
+}
+
+// Gives the pcb back to the pool, the socket is reset or closed
+static void release(tcp_pcb *pcb, bool rst) {
+  if (pcb->fd >= 0) {
+    if (rst) {
+      struct linger linger = { 1, 0 };
+      setsockopt(pcb->fd, SOL_SOCKET, SO_LINGER, &linger, sizeof(linger));
+    }
+    close(pcb->fd);
+  }
+  pbuf_free(pcb->refused);
+  HostTcp::detach(pcb, rst);
+  reset(pcb);
+  pcb->state = HOST_TCP_FREE;
+}
+
+// tcp_abandon(): freed first, then the err callback is told
+static void kill(tcp_pcb *pcb, err_t err) {
+  tcp_err_fn errf = pcb->errf;
+  void *arg = pcb->callback_arg;
+
+  release(pcb, true);
+  if (errf)
+    errf(arg, err);
+}
+
+// tcp_alloc(): a free pcb, or the one of the oldest connection with a
+// priority not above prio, killed for it
+static tcp_pcb *alloc(u8_t prio) {
+  tcp_pcb *victim = NULL;
+  u8_t mprio = min((u8_t)TCP_PRIO_MAX, prio);
+  u32_t inactivity = 0;
+
+  for (uint8_t i = 0; i < MEMP_NUM_TCP_PCB; i++) {
+    if (pool[i].state == HOST_TCP_FREE) {
+      reset(&pool[i]);
+      pool[i].prio = prio;
+      pool[i].state = HOST_TCP_NEW;
+      return &pool[i];
+    }
+  }
+  for (uint8_t i = 0; i < MEMP_NUM_TCP_PCB; i++) {
+    tcp_pcb *pcb = &pool[i];
+    u32_t idle = millis() - pcb->active;
+    if ((pcb->state != HOST_TCP_OPEN) && (pcb->state != HOST_TCP_CLOSING))
+      continue;
+    if ((pcb->prio <= mprio) && (idle >= inactivity)) {
+      victim = pcb;
+      mprio = pcb->prio;
+      inactivity = idle;
+    }
+  }
+  if (!victim)
+    return NULL;
+  killed++;
+  kill(victim, ERR_ABRT);
+  return alloc(prio);
+}
+
+static bool isListener(tcp_pcb *pcb) {
+  return (pcb >= listeners) && (pcb < listeners + MEMP_NUM_TCP_PCB_LISTEN);
+}
+
+static void nonblocking(int fd) {
+  int one = 1;
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  // Host side only: the kernel must not hold back what lwIP sent
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+/***
+ * Raw API
+ */
+
+struct tcp_pcb *tcp_new(void) {
+  return alloc(TCP_PRIO_NORMAL);
+}
+
+err_t tcp_bind(struct tcp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port) {
+  (void)ipaddr;
+  for (uint8_t i = 0; i < MEMP_NUM_TCP_PCB_LISTEN; i++) {
+    if ((listeners[i].state == HOST_TCP_LISTEN) && (listeners[i].local_port == port))
+      return ERR_USE;
+  }
+  pcb->local_port = port;
+  return ERR_OK;
+}
+
+// The host socket listens on an ephemeral port of 127.0.0.1, see hostTcpPort()
+struct tcp_pcb *tcp_listen_with_backlog(struct tcp_pcb *pcb, u8_t backlog) {
+  struct sockaddr_in addr;
+  tcp_pcb *lpcb = NULL;
+  int fd;
+
+  for (uint8_t i = 0; i < MEMP_NUM_TCP_PCB_LISTEN; i++) {
+    if (listeners[i].state == HOST_TCP_FREE) {
+      lpcb = &listeners[i];
+      break;
+    }
+  }
+  if (!lpcb)
+    return NULL;
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+    return NULL;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if ((bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) || (listen(fd, backlog) < 0)) {
+    close(fd);
+    return NULL;
+  }
+  nonblocking(fd);
+  reset(lpcb);
+  lpcb->state = HOST_TCP_LISTEN;
+  lpcb->fd = fd;
+  lpcb->prio = pcb->prio;
+  lpcb->local_port = pcb->local_port;
+  lpcb->callback_arg = pcb->callback_arg;
+  release(pcb, false);
+  return lpcb;
+}
+
+void tcp_setprio(struct tcp_pcb *pcb, u8_t prio) {
+  pcb->prio = prio;
+}
+
+void tcp_arg(struct tcp_pcb *pcb, void *arg) {
+  pcb->callback_arg = arg;
+}
+
+void tcp_accept(struct tcp_pcb *pcb, tcp_accept_fn accept) {
+  pcb->accept = accept;
+}
+
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv) {
+  pcb->recv = recv;
+}
+
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent) {
+  pcb->sent = sent;
+}
+
+void tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval) {
+  pcb->poll = poll;
+  pcb->pollinterval = interval;
+}
+
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err) {
+  pcb->errf = err;
+}
+
+void tcp_recved(struct tcp_pcb *pcb, u16_t len) {
+  pcb->rcv_wnd = min(TCP_WND, pcb->rcv_wnd + len);
+}
+
+err_t tcp_write(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags) {
+  (void)apiflags;
+  if (pcb->state != HOST_TCP_OPEN)
+    return ERR_CONN;
+  if (len > tcp_sndbuf(pcb))
+    return ERR_MEM;
+  memcpy(pcb->snd + pcb->snd_len, dataptr, len);
+  pcb->snd_len += len;
+  return ERR_OK;
+}
+
+// Hands the send buffer to the socket, the sent callback comes later
+err_t tcp_output(struct tcp_pcb *pcb) {
+  ssize_t n;
+
+  if ((pcb->fd < 0) || !pcb->snd_len)
+    return ERR_OK;
+  n = send(pcb->fd, pcb->snd, pcb->snd_len, MSG_NOSIGNAL | MSG_DONTWAIT);
+  if (n > 0) {
+    memmove(pcb->snd, pcb->snd + n, pcb->snd_len - n);
+    pcb->snd_len -= n;
+    pcb->acked += n;
+    pcb->active = millis();
+  }
+  return ERR_OK;
+}
+
+err_t tcp_close(struct tcp_pcb *pcb) {
+  if (isListener(pcb)) {
+    close(pcb->fd);
+    reset(pcb);
+    pcb->state = HOST_TCP_FREE;
+    return ERR_OK;
+  }
+  if (pcb->state != HOST_TCP_OPEN) {
+    if (pcb->state == HOST_TCP_NEW)
+      release(pcb, false);
+    return ERR_OK;
+  }
+  // Received data nobody took: lwIP answers with a reset
+  if ((pcb->rcv_wnd != TCP_WND) || pcb->refused || ((pcb->fd < 0) && pcb->in_len)) {
+    release(pcb, true);
+    return ERR_OK;
+  }
+  pcb->state = HOST_TCP_CLOSING;
+  tcp_output(pcb);
+  if (!pcb->snd_len || ((pcb->fd < 0) && !pcb->peer))
+    release(pcb, false);
+  return ERR_OK;
+}
+
+void tcp_abort(struct tcp_pcb *pcb) {
+  kill(pcb, ERR_ABRT);
+}
+
+/***
+ * hostNetwork()
+ */
+
+// Data or the end of the stream (p == NULL) to the recv callback.
+// Returns false once the pcb was aborted.
+static bool deliver(tcp_pcb *pcb, struct pbuf *p) {
+  err_t err = ERR_OK;
+
+  if (pcb->recv) {
+    err = pcb->recv(pcb->callback_arg, pcb, p, ERR_OK);
+  } else if (p) {
+    // tcp_recv_null()
+    tcp_recved(pcb, p->tot_len);
+    pbuf_free(p);
+  } else {
+    tcp_close(pcb);
+  }
+  if (err == ERR_ABRT)
+    return false;
+  if ((err != ERR_OK) && p)
+    pcb->refused = p;
+  return true;
+}
+
+static void acceptAll(tcp_pcb *lpcb) {
+  while (lpcb->accept) {
+    struct pollfd pfd = { lpcb->fd, POLLIN, 0 };
+    tcp_pcb *pcb;
+    err_t err;
+    int fd;
+    if (poll(&pfd, 1, 0) <= 0)
+      return;
+    // Without a pcb the connection stays in the backlog, like a SYN
+    // lwIP drops and the client sends again
+    pcb = alloc(lpcb->prio);
+    if (!pcb)
+      return;
+    fd = accept(lpcb->fd, NULL, NULL);
+    if (fd < 0) {
+      release(pcb, false);
+      return;
+    }
+    nonblocking(fd);
+    pcb->state = HOST_TCP_OPEN;
+    pcb->fd = fd;
+    pcb->local_port = lpcb->local_port;
+    err = lpcb->accept(lpcb->callback_arg, pcb, ERR_OK);
+    if ((err != ERR_OK) && (err != ERR_ABRT))
+      tcp_abort(pcb);
+  }
+}
+
+static void receive(tcp_pcb *pcb) {
+  char buf[TCP_MSS];
+
+  if (pcb->refused) {
+    struct pbuf *p = pcb->refused;
+    pcb->refused = NULL;
+    if (!deliver(pcb, p))
+      return;
+  }
+  while ((pcb->state == HOST_TCP_OPEN) && !pcb->refused && !pcb->fin && pcb->rcv_wnd) {
+    ssize_t n = recv(pcb->fd, buf, min((u16_t)TCP_MSS, pcb->rcv_wnd), MSG_DONTWAIT);
+    struct pbuf *p;
+    if (n < 0) {
+      if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+        kill(pcb, ERR_RST);
+      return;
+    }
+    if (!n) {
+      pcb->fin = true;
+      break;
+    }
+    p = pbuf_alloc_ram(n);
+    memcpy(p->payload, buf, n);
+    pcb->rcv_wnd -= n;
+    pcb->active = millis();
+    if (!deliver(pcb, p))
+      return;
+  }
+  if ((pcb->state == HOST_TCP_OPEN) && pcb->fin && !pcb->finTold && !pcb->refused) {
+    pcb->finTold = true;
+    deliver(pcb, NULL);
+  }
+}
+
+static void service(tcp_pcb *pcb) {
+  tcp_output(pcb);
+  if (pcb->acked && (pcb->state == HOST_TCP_OPEN)) {
+    u16_t n = pcb->acked;
+    pcb->acked = 0;
+    if (pcb->sent && (pcb->sent(pcb->callback_arg, pcb, n) == ERR_ABRT))
+      return;
+  }
+  if ((pcb->state == HOST_TCP_OPEN) && (pcb->fd >= 0))
+    receive(pcb);
+  if (pcb->state == HOST_TCP_CLOSING) {
+    if (!pcb->snd_len || ((pcb->fd < 0) && !pcb->peer))
+      release(pcb, false);
+    return;
+  }
+  if ((pcb->state == HOST_TCP_OPEN) && pcb->poll && pcb->pollinterval
+    && (millis() - pcb->polled >= pcb->pollinterval * 500UL)) {
+    pcb->polled = millis();
+    pcb->poll(pcb->callback_arg, pcb);
+  }
+}
+
+void hostNetwork() {
+  for (uint8_t i = 0; i < MEMP_NUM_TCP_PCB_LISTEN; i++) {
+    if (listeners[i].state == HOST_TCP_LISTEN)
+      acceptAll(&listeners[i]);
+  }
+  for (uint8_t i = 0; i < MEMP_NUM_TCP_PCB; i++) {
+    if ((pool[i].state == HOST_TCP_OPEN) || (pool[i].state == HOST_TCP_CLOSING))
+      service(&pool[i]);
+  }
+}
+
+/***
+ * Control side
+ */
+
+uint16_t hostTcpPort(uint16_t port) {
+  for (uint8_t i = 0; i < MEMP_NUM_TCP_PCB_LISTEN; i++) {
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    if ((listeners[i].state != HOST_TCP_LISTEN) || (listeners[i].local_port != port))
+      continue;
+    if (getsockname(listeners[i].fd, (struct sockaddr *)&addr, &len) < 0)
+      return 0;
+    return ntohs(addr.sin_port);
+  }
+  return 0;
+}
+
+uint8_t hostTcpPcbs() {
+  uint8_t n = 0;
+
+  for (uint8_t i = 0; i < MEMP_NUM_TCP_PCB; i++) {
+    if (pool[i].state != HOST_TCP_FREE)
+      n++;
+  }
+  return n;
+}
+
+uint32_t hostTcpKilled() {
+  return killed;
+}
+
+/***
+ * HostPeer class implementation
+ */
+
+bool HostPeer::connect(uint16_t port) {
+  tcp_pcb *pcb;
+
+  close();
+  pcb = alloc(TCP_PRIO_NORMAL);
+  if (!pcb)
+    return false;
+  pcb->state = HOST_TCP_OPEN;
+  pcb->local_port = port;
+  HostTcp::attach(this, pcb);
+  if (!hostWiFiAccept(port, pcb)) {
+    release(pcb, true);
+    return false;
+  }
+  return true;
+}
+
+void HostPeer::send(const char *text) {
+  size_t n;
+
+  if (!_pcb || (_pcb->state != HOST_TCP_OPEN))
+    return;
+  n = min(strlen(text), (size_t)(TCP_WND - _pcb->in_len));
+  memcpy(_pcb->in + _pcb->in_len, text, n);
+  _pcb->in_len += n;
+  _pcb->active = millis();
+}
+
+size_t HostPeer::receive(char *buf, size_t size) {
+  tcp_pcb *pcb = _pcb;
+  size_t n;
+
+  if (!pcb)
+    return 0;
+  n = min(size, (size_t)pcb->snd_len);
+  memcpy(buf, pcb->snd, n);
+  memmove(pcb->snd, pcb->snd + n, pcb->snd_len - n);
+  pcb->snd_len -= n;
+  pcb->acked += n;
+  if (n)
+    pcb->active = millis();
+  if ((pcb->state == HOST_TCP_CLOSING) && !pcb->snd_len)
+    release(pcb, false);
+  return n;
+}
+
+size_t HostPeer::pending() {
+  return _pcb ? _pcb->snd_len : 0;
+}
+
+bool HostPeer::connected() {
+  return _pcb && (_pcb->state == HOST_TCP_OPEN);
+}
+
+bool HostPeer::reset() {
+  return _reset;
+}
+
+// FIN from the peer. The pcb stays until the firmware closes its end.
+void HostPeer::close() {
+  tcp_pcb *pcb = _pcb;
+
+  if (!pcb)
+    return;
+  pcb->fin = true;
+  HostTcp::detach(pcb, false);
+  if (pcb->state == HOST_TCP_CLOSING)
+    release(pcb, false);
+}
@@ -0,0 +1,45 @@
+#include "HostTest.h"
+
+static HostTestCase *cases = NULL;
+static HostTestCase **last = &cases;
+
+HostTestCase::HostTestCase(const char *name, HostTestFunction fn) : name(name), fn(fn), next(NULL) {
+  *last = this;
+  last = &next;
+}
+
+void hostTestFail(const char *file, int line, const char *what) {
+  printf("%s:%d: CHECK failed: %s\n", file, line, what);
+  throw HostTestFailure();
+}
+
+void hostMeasure(const char *name, double value, const char *unit) {
+  printf("  %-48s %12.3f %s\n", name, value, unit);
+}
+
+// Runs every case, or the ones named on the command line
+int main(int argc, char **argv) {
+  int failed = 0;
+  int run = 0;
+
+  for (HostTestCase *c = cases; c; c = c->next) {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc; i++)
+      selected = selected || !strcmp(argv[i], c->name);
+    if (!selected)
+      continue;
+    printf("[ RUN  ] %s\n", c->name);
+    fflush(stdout);
+    run++;
+    try {
+      c->fn();
+      printf("[  OK  ] %s\n", c->name);
+    } catch (HostTestFailure&) {
+      printf("[ FAIL ] %s\n", c->name);
+      failed++;
+    }
+    fflush(stdout);
+  }
+  printf("%d of %d passed\n", run - failed, run);
+  return failed ? 1 : 0;
+}
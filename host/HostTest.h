@@ -0,0 +1,55 @@
+#ifndef __HOST_TEST_H
+#define __HOST_TEST_H
+
+#include "Host.h"
+
+// Minimal test runner of the host build. A test file defines its
+// cases with TEST(), they run in the order of the file. A failed
+// CHECK() ends its case and the run fails. MEASURE() prints a figure
+// for the log, ctest -V shows it.
+
+typedef void (*HostTestFunction)();
+
+struct HostTestCase {
+  HostTestCase(const char *name, HostTestFunction fn);
+  const char *name;
+  HostTestFunction fn;
+  HostTestCase *next;
+};
+
+struct HostTestFailure {}; // Thrown by a failed CHECK()
+
+void hostTestFail(const char *file, int line, const char *what);
+void hostMeasure(const char *name, double value, const char *unit);
+
+#define TEST(name) \
+  static void name(); \
+  static HostTestCase name##Case(#name, name); \
+  static void name()
+
+#define CHECK(cond) \
+  do { if (!(cond)) hostTestFail(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_EQ(a, b) \
+  do { \
+    long long _a = (long long)(a), _b = (long long)(b); \
+    if (_a != _b) { \
+      char _what[256]; \
+      snprintf(_what, sizeof(_what), "%s == %s (%lld != %lld)", #a, #b, _a, _b); \
+      hostTestFail(__FILE__, __LINE__, _what); \
+    } \
+  } while (0)
+
+#define CHECK_STR(a, b) \
+  do { \
+    const char *_a = (a), *_b = (b); \
+    if (!_a || !_b || strcmp(_a, _b)) { \
+      char _what[512]; \
+      snprintf(_what, sizeof(_what), "%s == %s (\"%s\" != \"%s\")", #a, #b, _a ? _a : "NULL", _b ? _b : "NULL"); \
+      hostTestFail(__FILE__, __LINE__, _what); \
+    } \
+  } while (0)
+
+#define MEASURE(name, value, unit) hostMeasure(name, value, unit)
+
+#endif
@@ -0,0 +1,75 @@
+#include <Arduino.h>
+#include <stdarg.h>
+
+/***
+ * Print class implementation
+ */
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+
+  while (size--)
+    n += write(*buffer++);
+  return n;
+}
+
+size_t Print::printf(const char *format, ...) {
+  char buf[256];
+  va_list args;
+  int len;
+
+  va_start(args, format);
+  len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0)
+    return 0;
+  return write((const uint8_t *)buf, min((size_t)len, sizeof(buf) - 1));
+}
+
+size_t Print::print(long value, int base) {
+  if ((base == 10) && (value < 0))
+    return print('-') + print((unsigned long)-value, base);
+  return print((unsigned long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+  char buf[8 * sizeof(long) + 1];
+  char *p = buf + sizeof(buf);
+
+  if (base < 2)
+    base = 10;
+  *--p = 0;
+  do {
+    *--p = "0123456789ABCDEF"[value % base];
+    value /= base;
+  } while (value);
+  return write(p);
+}
+
+size_t Print::print(double value, int digits) {
+  char buf[32];
+
+  snprintf(buf, sizeof(buf), "%.*f", digits, value);
+  return write(buf);
+}
+
+/***
+ * Stream class implementation, without the timeouts: the data a
+ * simulated stream will ever have is there already
+ */
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+  size_t n = 0;
+
+  while ((n < length) && (available() > 0))
+    buffer[n++] = read();
+  return n;
+}
+
+String Stream::readString() {
+  String out;
+
+  while (available() > 0)
+    out += (char)read();
+  return out;
+}
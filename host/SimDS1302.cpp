@@ -0,0 +1,254 @@
+#include <time.h>
+#include "SimDS1302.h"
+
+// Datasheet timing at 2.0V, ns
+#define SIM_T_CC   4000 // CE to CLK setup
+#define SIM_T_CWH  4000 // CE inactive time
+#define SIM_T_DC    200 // Data to CLK setup
+#define SIM_T_CH   1000 // CLK high time
+#define SIM_T_CL   1000 // CLK low time
+#define SIM_T_CDD   800 // CLK to data delay, a read before this sees the old bit
+
+#define SIM_CYCLES(ns) (((uint64_t)(ns) * HOST_CYCLES_PER_US + 999) / 1000)
+#define SIM_EPOCH      946684800L // 2000-01-01 in UNIX time
+
+static uint8_t bcd(uint8_t v) {
+  return (v / 10) << 4 | (v % 10);
+}
+
+static uint8_t unbcd(uint8_t v) {
+  return (v >> 4) * 10 + (v & 0x0F);
+}
+
+/***
+ * SimDS1302 class implementation
+ */
+
+SimDS1302::SimDS1302(uint8_t pinRst, uint8_t pinDat, uint8_t pinClk) {
+  _pinRst = pinRst;
+  _pinDat = pinDat;
+  _pinClk = pinClk;
+  _ce = false;
+  _clk = false;
+  _ceAt = 0;
+  _clkAt = 0;
+  _datAt = 0;
+  _fallAt = 0;
+  _inCommand = false;
+  _reading = false;
+  _driving = false;
+  memset(_buf, 0, sizeof(_buf));
+  memset(_ram, 0, sizeof(_ram));
+  _wp = false;
+  _halted = false;
+  _haltedAt = 0;
+  setTime(0);
+  resetStats();
+  hostAttachPin(_pinRst, this);
+  hostAttachPin(_pinDat, this);
+  hostAttachPin(_pinClk, this);
+}
+
+SimDS1302::~SimDS1302() {
+  hostDrivePin(_pinDat, HOST_FLOAT);
+  hostAttachPin(_pinRst, NULL);
+  hostAttachPin(_pinDat, NULL);
+  hostAttachPin(_pinClk, NULL);
+}
+
+void SimDS1302::setTime(uint32_t secondsSince2000) {
+  _base = secondsSince2000;
+  _baseAt = hostCycles();
+}
+
+uint32_t SimDS1302::time() {
+  if (_halted)
+    return _haltedAt;
+  return _base + (hostCycles() - _baseAt) / F_CPU;
+}
+
+void SimDS1302::resetStats() {
+  memset(&_stats, 0, sizeof(_stats));
+  _violation[0] = 0;
+}
+
+void SimDS1302::_violate(const char *what, uint64_t got, uint64_t wanted) {
+  _stats.violations++;
+  snprintf(_violation, sizeof(_violation), "%s: %u of %u cycles", what, (unsigned)got, (unsigned)wanted);
+}
+
+void SimDS1302::pinChanged(uint8_t pin, uint8_t level) {
+  uint64_t now = hostCycles();
+
+  if (pin == _pinRst) {
+    if (level && !_ce) {
+      if (_ceAt && (now - _ceAt < SIM_CYCLES(SIM_T_CWH)))
+        _violate("tCWH", now - _ceAt, SIM_CYCLES(SIM_T_CWH));
+      if (_clk)
+        _violate("CLK high at CE", 0, 0);
+      _ce = true;
+      _ceAt = now;
+      _clkAt = 0;
+      _inCommand = true;
+      _reading = false;
+      _cmd = 0;
+      _bit = 0;
+      _stats.sessions++;
+    } else if (!level && _ce) {
+      _ce = false;
+      _stats.busCycles += now - _ceAt;
+      _ceAt = now;
+      if (_driving)
+        hostDrivePin(_pinDat, HOST_FLOAT);
+      _driving = false;
+    }
+  } else if (pin == _pinClk) {
+    if (_ce && level && !_clk) {
+      if (!_clkAt && (now - _ceAt < SIM_CYCLES(SIM_T_CC)))
+        _violate("tCC", now - _ceAt, SIM_CYCLES(SIM_T_CC));
+      if (_clkAt && (now - _clkAt < SIM_CYCLES(SIM_T_CL)))
+        _violate("tCL", now - _clkAt, SIM_CYCLES(SIM_T_CL));
+      _rise();
+    } else if (_ce && !level && _clk) {
+      if (now - _clkAt < SIM_CYCLES(SIM_T_CH))
+        _violate("tCH", now - _clkAt, SIM_CYCLES(SIM_T_CH));
+      _fall();
+    }
+    _clk = level;
+    _clkAt = now;
+  } else if (pin == _pinDat) {
+    _datAt = now;
+  }
+}
+
+void SimDS1302::pinSampled(uint8_t pin) {
+  uint64_t now = hostCycles();
+
+  if ((pin == _pinDat) && _driving && (now - _fallAt < SIM_CYCLES(SIM_T_CDD)))
+    _violate("tCDD", now - _fallAt, SIM_CYCLES(SIM_T_CDD));
+}
+
+void SimDS1302::_rise() {
+  uint64_t now = hostCycles();
+  uint8_t level = hostPinLevel(_pinDat);
+
+  _stats.bits++;
+  if (_reading)
+    return;
+  if (now - _datAt < SIM_CYCLES(SIM_T_DC))
+    _violate("tDC", now - _datAt, SIM_CYCLES(SIM_T_DC));
+  if (_inCommand) {
+    _cmd |= level << _bit;
+    if (++_bit == 8)
+      _command();
+    return;
+  }
+  _value |= level << _bit;
+  if (++_bit == 8) {
+    _store(_value);
+    _bit = 0;
+    _value = 0;
+  }
+}
+
+void SimDS1302::_fall() {
+  uint8_t address = (_cmd >> 1) & 0x1F;
+  bool ram = _cmd & 0x40;
+  uint8_t value;
+
+  if (!_reading)
+    return;
+  if (address == 31)
+    value = ram ? _ram[_byte % 31] : _buf[_byte % 8];
+  else
+    value = ram ? _ram[address % 31] : (address < 8 ? _buf[address] : 0);
+  hostDrivePin(_pinDat, (value >> _bit) & 1);
+  _driving = true;
+  _fallAt = hostCycles();
+  if (++_bit == 8) {
+    _bit = 0;
+    _byte++;
+  }
+}
+
+void SimDS1302::_command() {
+  _inCommand = false;
+  _bit = 0;
+  _byte = 0;
+  _value = 0;
+  if (!(_cmd & 0x80))
+    return;
+  _reading = _cmd & 1;
+  if (_reading) {
+    _stats.reads++;
+    // Read commands take a snapshot, a burst can not tear
+    if (!(_cmd & 0x40))
+      _latch();
+  } else {
+    _stats.writes++;
+  }
+}
+
+void SimDS1302::_store(uint8_t value) {
+  uint8_t address = (_cmd >> 1) & 0x1F;
+  bool ram = _cmd & 0x40;
+
+  if (!(_cmd & 0x80))
+    return;
+  // Write protect blocks everything but the control register
+  if (_wp && (ram || (address != 7)))
+    return;
+  if (ram) {
+    if (address == 31) {
+      if (_byte < 31)
+        _ram[_byte] = value;
+      _byte++;
+    } else if (address < 31) {
+      _ram[address] = value;
+    }
+  } else if (address == 31) {
+    // The clock burst takes effect only with all 8 bytes
+    if (_byte < 8)
+      _buf[_byte] = value;
+    if (++_byte == 8) {
+      _apply();
+      _wp = _buf[7] & 0x80;
+    }
+  } else if (address == 7) {
+    _wp = value & 0x80;
+  } else if (address < 7) {
+    _latch();
+    _buf[address] = value;
+    _apply();
+  }
+}
+
+void SimDS1302::_latch() {
+  time_t t = SIM_EPOCH + time();
+  struct tm tm;
+
+  gmtime_r(&t, &tm);
+  _buf[0] = bcd(tm.tm_sec) | (_halted ? 0x80 : 0);
+  _buf[1] = bcd(tm.tm_min);
+  _buf[2] = bcd(tm.tm_hour);
+  _buf[3] = bcd(tm.tm_mday);
+  _buf[4] = bcd(tm.tm_mon + 1);
+  _buf[5] = tm.tm_wday + 1;
+  _buf[6] = bcd(tm.tm_year - 100);
+  _buf[7] = _wp ? 0x80 : 0;
+}
+
+void SimDS1302::_apply() {
+  struct tm tm;
+
+  memset(&tm, 0, sizeof(tm));
+  tm.tm_sec = unbcd(_buf[0] & 0x7F);
+  tm.tm_min = unbcd(_buf[1] & 0x7F);
+  tm.tm_hour = unbcd(_buf[2] & 0x3F);
+  tm.tm_mday = unbcd(_buf[3] & 0x3F);
+  tm.tm_mon = unbcd(_buf[4] & 0x1F) - 1;
+  tm.tm_year = unbcd(_buf[6]) + 100;
+  setTime(timegm(&tm) - SIM_EPOCH);
+  _halted = _buf[0] & 0x80;
+  _haltedAt = _base;
+}
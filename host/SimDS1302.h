@@ -0,0 +1,64 @@
+#ifndef __HOST_SIMDS1302_H
+#define __HOST_SIMDS1302_H
+
+#include "Host.h"
+
+// A DS1302 on three pins of the simulated board. It decodes the
+// commands the firmware clocks in, keeps the clock and the 31 bytes
+// of ram, and drives the I/O line on the falling CLK edges of a read.
+// Every bus phase is checked against the datasheet timing, a phase
+// that is too short is counted as a violation and the chip behaves
+// as if it was long enough.
+class SimDS1302 : public HostPinDevice {
+public:
+  struct Stats {
+    uint32_t sessions;   // CE high ... CE low
+    uint32_t bits;       // Rising CLK edges with CE high
+    uint32_t reads;      // Read commands
+    uint32_t writes;     // Write commands
+    uint32_t violations; // Timing violations, see lastViolation()
+    uint64_t busCycles;  // CPU cycles with CE high
+  };
+
+  SimDS1302(uint8_t pinRst, uint8_t pinDat, uint8_t pinClk);
+  ~SimDS1302();
+  void setTime(uint32_t secondsSince2000); // As if set when the test started, the second just began
+  uint32_t time();                         // Seconds since 2000 now
+  uint8_t ram(uint8_t address) { return _ram[address % 31]; }
+  bool writeProtected() { return _wp; }
+  bool halted() { return _halted; }
+  const Stats& stats() { return _stats; }
+  void resetStats();
+  const char *lastViolation() { return _violation; }
+
+  void pinChanged(uint8_t pin, uint8_t level);
+  void pinSampled(uint8_t pin);
+protected:
+  void _violate(const char *what, uint64_t got, uint64_t wanted);
+  void _rise();
+  void _fall();
+  void _command();
+  void _store(uint8_t value);
+  void _latch(); // Clock registers into the burst buffer
+  void _apply(); // Burst buffer into the clock
+
+  uint8_t _pinRst, _pinDat, _pinClk;
+  bool _ce, _clk;
+  uint64_t _ceAt, _clkAt, _datAt; // hostCycles() at the last change
+  uint64_t _fallAt;               // Falling edge that put the last bit out
+  uint8_t _cmd;
+  uint8_t _bit;                   // Bits of the command or of the current byte
+  uint8_t _byte;                  // Bytes of data so far
+  uint8_t _value;
+  bool _inCommand, _reading, _driving;
+  uint8_t _buf[31];
+  uint8_t _ram[31];
+  bool _wp, _halted;
+  uint32_t _base;                 // Clock at _baseAt
+  uint64_t _baseAt;
+  uint32_t _haltedAt;             // Clock when it was halted
+  Stats _stats;
+  char _violation[64];
+};
+
+#endif
@@ -0,0 +1,254 @@
+#include <time.h>
+#include "SimI2cRtc.h"
+
+#define SIM_EPOCH 946684800L // 2000-01-01 in UNIX time
+
+#define REG_SECONDS 0x00
+#define REG_DOW     0x03
+#define REG_DATE    0x04
+#define REG_YEAR    0x06
+
+#define DS1307_CONTROL 0x07
+#define DS1307_OUT     0x80
+#define DS1307_SQWE    0x10
+#define DS1307_RS      0x03
+
+#define DS3231_ALARM1  0x07
+#define DS3231_ALARM2  0x0B
+#define DS3231_CONTROL 0x0E
+#define DS3231_STATUS  0x0F
+#define DS3231_TEMP    0x11
+#define DS3231_A1IE    0x01
+#define DS3231_A2IE    0x02
+#define DS3231_INTCN   0x04
+#define DS3231_RS      0x18
+#define DS3231_A1F     0x01
+#define DS3231_A2F     0x02
+
+#define ALARM_MASK 0x80
+#define ALARM_DYDT 0x40
+
+static uint8_t bcd(uint8_t v) {
+  return (v / 10) << 4 | (v % 10);
+}
+
+static uint8_t unbcd(uint8_t v) {
+  return (v >> 4) * 10 + (v & 0x0F);
+}
+
+/***
+ * SimI2cRtc class implementation
+ */
+
+SimI2cRtc::SimI2cRtc(Model model, int8_t pinInt) : _event(_onTick, this) {
+  _model = model;
+  _pinInt = pinInt;
+  _size = (model == DS3231) ? 0x13 : 0x40;
+  memset(_regs, 0, sizeof(_regs));
+  if (model == DS3231) {
+    _regs[DS3231_CONTROL] = 0x1C;
+    _regs[DS3231_STATUS] = 0x08;
+    _regs[DS3231_TEMP] = 25;
+  } else {
+    _regs[DS1307_CONTROL] = 0x03;
+  }
+  _pointer = 0;
+  _ppm = 0;
+  resetStats();
+  setTime(0);
+  hostAttachI2c(SIM_RTC_ADDRESS, this);
+}
+
+SimI2cRtc::~SimI2cRtc() {
+  hostCancel(_event);
+  hostAttachI2c(SIM_RTC_ADDRESS, NULL);
+  if (_pinInt >= 0)
+    hostDrivePin(_pinInt, HOST_FLOAT);
+}
+
+void SimI2cRtc::setTime(uint32_t secondsSince2000) {
+  time_t t = SIM_EPOCH + secondsSince2000;
+  struct tm tm;
+
+  gmtime_r(&t, &tm);
+  _base = secondsSince2000;
+  _baseAt = hostCycles();
+  _ticks = 0;
+  _high = false;
+  _dow = tm.tm_wday + 1;
+  _dowDay = secondsSince2000 / 86400;
+  _schedule();
+  _pin();
+}
+
+uint32_t SimI2cRtc::time() {
+  uint64_t elapsed = hostCycles() - _baseAt;
+
+  return _base + (uint32_t)((unsigned __int128)elapsed * (1000000 + _ppm) / ((uint64_t)F_CPU * 1000000));
+}
+
+void SimI2cRtc::setDrift(int32_t ppm) {
+  // The new rate counts from the last second boundary, the phase is kept
+  uint64_t boundary = _ticks & ~(uint64_t)1;
+
+  _baseAt = _tickAt(boundary);
+  _base += boundary / 2;
+  _ticks -= boundary;
+  _ppm = ppm;
+  _schedule();
+}
+
+void SimI2cRtc::resetStats() {
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+uint64_t SimI2cRtc::_tickAt(uint64_t tick) {
+  unsigned __int128 n = (unsigned __int128)tick * (F_CPU / 2) * 1000000;
+  uint64_t rate = 1000000 + _ppm;
+
+  // Rounded up, so time() has reached the second at the tick of its boundary
+  return _baseAt + (uint64_t)((n + rate - 1) / rate);
+}
+
+void SimI2cRtc::_schedule() {
+  hostSchedule(_event, _tickAt(_ticks + 1));
+}
+
+void SimI2cRtc::_onTick(void *arg) {
+  ((SimI2cRtc *)arg)->_tick();
+}
+
+void SimI2cRtc::_tick() {
+  _ticks++;
+  _high = _ticks & 1;
+  if (!_high && (_model == DS3231))
+    _alarms();
+  _pin();
+  _schedule();
+}
+
+void SimI2cRtc::_latch() {
+  uint32_t seconds = time();
+  time_t t = SIM_EPOCH + seconds;
+  struct tm tm;
+
+  gmtime_r(&t, &tm);
+  _regs[0] = bcd(tm.tm_sec);
+  _regs[1] = bcd(tm.tm_min);
+  _regs[2] = bcd(tm.tm_hour);
+  _regs[3] = (_dow - 1 + (seconds / 86400 - _dowDay)) % 7 + 1;
+  _regs[4] = bcd(tm.tm_mday);
+  _regs[5] = bcd(tm.tm_mon + 1);
+  _regs[6] = bcd(tm.tm_year - 100);
+}
+
+void SimI2cRtc::_apply() {
+  struct tm tm;
+  uint8_t dow = _regs[REG_DOW] & 0x07;
+
+  memset(&tm, 0, sizeof(tm));
+  tm.tm_sec = unbcd(_regs[0] & 0x7F);
+  tm.tm_min = unbcd(_regs[1] & 0x7F);
+  tm.tm_hour = unbcd(_regs[2] & 0x3F);
+  tm.tm_mday = unbcd(_regs[4] & 0x3F);
+  tm.tm_mon = unbcd(_regs[5] & 0x1F) - 1;
+  tm.tm_year = unbcd(_regs[6]) + 100;
+  setTime(timegm(&tm) - SIM_EPOCH);
+  // Whatever was written, the chip counts on from it
+  _dow = dow ? dow : 7;
+}
+
+void SimI2cRtc::_alarms() {
+  static const uint8_t fields[4] = { 0x7F, 0x7F, 0x3F, 0x3F };
+  uint8_t *a1 = _regs + DS3231_ALARM1;
+  uint8_t *a2 = _regs + DS3231_ALARM2;
+  bool match1 = true;
+  bool match2 = true;
+
+  _latch();
+  for (uint8_t i = 0; i < 4; i++) {
+    uint8_t value = (i < 3) ? _regs[i] : _regs[REG_DATE];
+    if (a1[i] & ALARM_MASK)
+      continue;
+    if ((i == 3) && (a1[i] & ALARM_DYDT))
+      match1 = match1 && ((a1[i] & 0x0F) == _regs[REG_DOW]);
+    else
+      match1 = match1 && ((a1[i] & fields[i]) == (value & fields[i]));
+  }
+  // Alarm 2 has no seconds, it matches at second 00
+  match2 = (_regs[REG_SECONDS] == 0);
+  for (uint8_t i = 1; i < 4; i++) {
+    uint8_t value = (i < 3) ? _regs[i] : _regs[REG_DATE];
+    if (a2[i - 1] & ALARM_MASK)
+      continue;
+    if ((i == 3) && (a2[i - 1] & ALARM_DYDT))
+      match2 = match2 && ((a2[i - 1] & 0x0F) == _regs[REG_DOW]);
+    else
+      match2 = match2 && ((a2[i - 1] & fields[i]) == (value & fields[i]));
+  }
+  if (match1)
+    _regs[DS3231_STATUS] |= DS3231_A1F;
+  if (match2)
+    _regs[DS3231_STATUS] |= DS3231_A2F;
+}
+
+void SimI2cRtc::_pin() {
+  bool low = false;
+
+  if (_pinInt < 0)
+    return;
+  if (_model == DS3231) {
+    uint8_t control = _regs[DS3231_CONTROL];
+    uint8_t status = _regs[DS3231_STATUS];
+    if (control & DS3231_INTCN)
+      low = ((status & DS3231_A1F) && (control & DS3231_A1IE)) || ((status & DS3231_A2F) && (control & DS3231_A2IE));
+    else if (!(control & DS3231_RS))
+      low = !_high;
+  } else {
+    uint8_t control = _regs[DS1307_CONTROL];
+    if (!(control & DS1307_SQWE))
+      low = !(control & DS1307_OUT);
+    else if (!(control & DS1307_RS))
+      low = !_high;
+  }
+  hostDrivePin(_pinInt, low ? LOW : HOST_FLOAT);
+}
+
+void SimI2cRtc::i2cWrite(const uint8_t *data, size_t length) {
+  bool clock = false;
+
+  _stats.writes++;
+  _stats.busCycles += (uint64_t)HOST_I2C_US(1 + length) * HOST_CYCLES_PER_US;
+  if (!length)
+    return;
+  _pointer = data[0] % _size;
+  for (size_t i = 1; i < length; i++) {
+    uint8_t value = data[i];
+    if (_pointer <= REG_YEAR) {
+      // Fields that are not written keep counting from now
+      if (!clock)
+        _latch();
+      clock = true;
+      _regs[_pointer] = value;
+    } else if ((_model == DS3231) && (_pointer == DS3231_STATUS)) {
+      // Alarm flags can only be cleared
+      _regs[_pointer] = (value & ~(DS3231_A1F | DS3231_A2F)) | (_regs[_pointer] & value & (DS3231_A1F | DS3231_A2F));
+    } else if ((_model == DS1307) || (_pointer < DS3231_TEMP)) {
+      _regs[_pointer] = value;
+    }
+    _pointer = (_pointer + 1) % _size;
+  }
+  if (clock)
+    _apply();
+  _pin();
+}
+
+void SimI2cRtc::i2cRead(uint8_t *data, size_t length) {
+  _stats.reads++;
+  _stats.busCycles += (uint64_t)HOST_I2C_US(1 + length) * HOST_CYCLES_PER_US;
+  _latch();
+  for (size_t i = 0; i < length; i++) {
+    data[i] = _regs[_pointer];
+    _pointer = (_pointer + 1) % _size;
+  }
+}
@@ -0,0 +1,63 @@
+#ifndef __HOST_SIMI2CRTC_H
+#define __HOST_SIMI2CRTC_H
+
+#include "Host.h"
+
+#define SIM_RTC_ADDRESS 0x68
+
+// A DS1307 or DS3231 on the simulated I2C bus. The clock registers are
+// latched at the start of every read and the register pointer moves
+// on with every byte, as on the chips. A write of the time registers
+// restarts the second, the day of week counts on with the date.
+// The DS3231 has both alarms and the status flags. The INT/SQW pin of
+// either chip is driven open drain: the 1Hz square wave falls on the
+// second boundary, in interrupt mode the pin is low while an enabled
+// alarm flag is set. The faster square wave rates are not modelled,
+// neither is the CH bit of the DS1307 that would stop the clock.
+class SimI2cRtc : public HostI2cDevice {
+public:
+  enum Model { DS1307, DS3231 };
+  struct Stats {
+    uint32_t reads;     // requestFrom()
+    uint32_t writes;    // Transmissions, the ones that only set the register pointer included
+    uint64_t busCycles; // CPU cycles the transactions held the bus
+  };
+
+  SimI2cRtc(Model model, int8_t pinInt = -1);
+  ~SimI2cRtc();
+  void setTime(uint32_t secondsSince2000); // The second just began
+  uint32_t time();                         // Seconds since 2000 now
+  void setDrift(int32_t ppm);              // Chip seconds run this much fast, from now on
+  uint8_t reg(uint8_t address) { return _regs[address % _size]; }
+  const Stats& stats() { return _stats; }
+  void resetStats();
+
+  void i2cWrite(const uint8_t *data, size_t length);
+  void i2cRead(uint8_t *data, size_t length);
+protected:
+  static void _onTick(void *arg);
+  void _tick();
+  void _schedule();
+  uint64_t _tickAt(uint64_t tick); // Cycle count of half second 'tick' since _baseAt
+  void _latch();                   // Clock into registers 0..6
+  void _apply();                   // Registers 0..6 into the clock
+  void _alarms();
+  void _pin();
+
+  Model _model;
+  int8_t _pinInt;
+  uint8_t _size;
+  uint8_t _regs[64];
+  uint8_t _pointer;
+  uint32_t _base;  // Clock at _baseAt
+  uint64_t _baseAt;
+  int32_t _ppm;
+  uint8_t _dow;    // Day of week register at _dowDay
+  uint32_t _dowDay;
+  uint64_t _ticks; // Half seconds since _baseAt
+  bool _high;      // Second half of the second, the 1Hz wave is up
+  HostEvent _event;
+  Stats _stats;
+};
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef __HOST_STREAM_H
+#define __HOST_STREAM_H
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  size_t readBytes(char *buffer, size_t length);
+  String readString();
+};
+
+#endif
@@ -0,0 +1,21 @@
+#include "Ticker.h"
+
+/***
+ * Ticker class implementation
+ */
+
+void Ticker::_arm(uint32_t ms, bool repeat, callback_t callback) {
+  uint64_t cycles = (uint64_t)ms * HOST_TICKER_CYCLES_PER_MS;
+
+  _callback = callback;
+  _period = repeat ? cycles : 0;
+  hostScheduleTask(_event, hostCycles() + cycles);
+}
+
+void Ticker::_fire(void *arg) {
+  Ticker *ticker = (Ticker *)arg;
+
+  if (ticker->_period)
+    hostScheduleTask(ticker->_event, ticker->_event.at + ticker->_period);
+  ticker->_callback();
+}
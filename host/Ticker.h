@@ -0,0 +1,33 @@
+#ifndef __HOST_TICKER_H
+#define __HOST_TICKER_H
+
+#include <Arduino.h>
+#include "HostEvent.h"
+
+#define HOST_TICKER_CYCLES_PER_MS (F_CPU / 1000L)
+
+// Ticker of core 2.4.0. The callbacks run as SDK tasks, between
+// loop() passes or while the sketch is in delay(), never in the
+// middle of loop().
+class Ticker {
+public:
+  typedef void (*callback_t)(void);
+
+  Ticker() : _event(_fire, this), _callback(NULL), _period(0) {}
+  ~Ticker() { detach(); }
+  void attach(float seconds, callback_t callback) { _arm(seconds * 1000, true, callback); }
+  void attach_ms(uint32_t ms, callback_t callback) { _arm(ms, true, callback); }
+  void once(float seconds, callback_t callback) { _arm(seconds * 1000, false, callback); }
+  void once_ms(uint32_t ms, callback_t callback) { _arm(ms, false, callback); }
+  void detach() { hostCancel(_event); }
+  bool active() { return _event.armed; }
+protected:
+  void _arm(uint32_t ms, bool repeat, callback_t callback);
+  static void _fire(void *arg);
+
+  HostEvent _event;
+  callback_t _callback;
+  uint64_t _period; // Cycles, 0 for once
+};
+
+#endif
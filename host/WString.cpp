@@ -0,0 +1,282 @@
+#include <Arduino.h>
+
+/***
+ * String class implementation, after WString.cpp of core 2.4.0
+ */
+
+String::String(const char *cstr) : _buffer(NULL), _capacity(0), _len(0) {
+  if (cstr)
+    _copy(cstr, strlen(cstr));
+}
+
+String::String(const String& str) : _buffer(NULL), _capacity(0), _len(0) {
+  *this = str;
+}
+
+String::String(const __FlashStringHelper *str) : _buffer(NULL), _capacity(0), _len(0) {
+  *this = str;
+}
+
+String::String(char c) : _buffer(NULL), _capacity(0), _len(0) {
+  char buf[2] = { c, 0 };
+
+  *this = buf;
+}
+
+String::String(unsigned char value, unsigned char base) : _buffer(NULL), _capacity(0), _len(0) {
+  *this = String((unsigned long)value, base);
+}
+
+String::String(int value, unsigned char base) : _buffer(NULL), _capacity(0), _len(0) {
+  *this = String((long)value, base);
+}
+
+String::String(unsigned int value, unsigned char base) : _buffer(NULL), _capacity(0), _len(0) {
+  *this = String((unsigned long)value, base);
+}
+
+String::String(long value, unsigned char base) : _buffer(NULL), _capacity(0), _len(0) {
+  char buf[2 + 8 * sizeof(long)];
+
+  if (base == 10)
+    snprintf(buf, sizeof(buf), "%ld", value);
+  else
+    snprintf(buf, sizeof(buf), base == 16 ? "%lx" : "%lo", value);
+  *this = buf;
+}
+
+String::String(unsigned long value, unsigned char base) : _buffer(NULL), _capacity(0), _len(0) {
+  char buf[1 + 8 * sizeof(unsigned long)];
+
+  snprintf(buf, sizeof(buf), base == 16 ? "%lx" : base == 8 ? "%lo" : "%lu", value);
+  *this = buf;
+}
+
+String::~String() {
+  free(_buffer);
+}
+
+void String::_invalidate() {
+  free(_buffer);
+  _buffer = NULL;
+  _capacity = _len = 0;
+}
+
+unsigned char String::reserve(unsigned int size) {
+  if (_buffer && (_capacity >= size))
+    return 1;
+  if (_changeBuffer(size)) {
+    if (_len == 0)
+      _buffer[0] = 0;
+    return 1;
+  }
+  return 0;
+}
+
+unsigned char String::_changeBuffer(unsigned int maxStrLen) {
+  size_t newSize = (maxStrLen + 16) & ~0xF;
+  char *buffer = (char *)realloc(_buffer, newSize);
+
+  if (!buffer)
+    return 0;
+  _buffer = buffer;
+  _capacity = newSize - 1;
+  return 1;
+}
+
+String& String::_copy(const char *cstr, unsigned int length) {
+  if (!reserve(length)) {
+    _invalidate();
+    return *this;
+  }
+  _len = length;
+  memcpy(_buffer, cstr, length);
+  _buffer[length] = 0;
+  return *this;
+}
+
+String& String::operator=(const String& rhs) {
+  if (this == &rhs)
+    return *this;
+  if (rhs._buffer)
+    _copy(rhs._buffer, rhs._len);
+  else
+    _invalidate();
+  return *this;
+}
+
+String& String::operator=(const char *cstr) {
+  if (cstr)
+    _copy(cstr, strlen(cstr));
+  else
+    _invalidate();
+  return *this;
+}
+
+String& String::operator=(const __FlashStringHelper *str) {
+  return *this = reinterpret_cast<const char *>(str);
+}
+
+unsigned char String::concat(const char *cstr, unsigned int length) {
+  unsigned int newlen = _len + length;
+
+  if (!cstr)
+    return 0;
+  if (length == 0)
+    return 1;
+  if (!reserve(newlen))
+    return 0;
+  memcpy(_buffer + _len, cstr, length);
+  _len = newlen;
+  _buffer[_len] = 0;
+  return 1;
+}
+
+unsigned char String::concat(const String& str) {
+  return concat(str.c_str(), str.length());
+}
+
+unsigned char String::concat(const char *cstr) {
+  return cstr ? concat(cstr, strlen(cstr)) : 0;
+}
+
+unsigned char String::concat(char c) {
+  return concat(&c, 1);
+}
+
+unsigned char String::concat(int value) {
+  char buf[2 + 3 * sizeof(int)];
+
+  return concat(buf, snprintf(buf, sizeof(buf), "%d", value));
+}
+
+unsigned char String::concat(unsigned int value) {
+  char buf[1 + 3 * sizeof(unsigned int)];
+
+  return concat(buf, snprintf(buf, sizeof(buf), "%u", value));
+}
+
+unsigned char String::concat(long value) {
+  char buf[2 + 3 * sizeof(long)];
+
+  return concat(buf, snprintf(buf, sizeof(buf), "%ld", value));
+}
+
+unsigned char String::concat(unsigned long value) {
+  char buf[1 + 3 * sizeof(unsigned long)];
+
+  return concat(buf, snprintf(buf, sizeof(buf), "%lu", value));
+}
+
+unsigned char String::concat(const __FlashStringHelper *str) {
+  return concat(reinterpret_cast<const char *>(str));
+}
+
+int String::compareTo(const String& s) const {
+  return strcmp(c_str(), s.c_str());
+}
+
+unsigned char String::equals(const String& s) const {
+  return (length() == s.length()) && !compareTo(s);
+}
+
+unsigned char String::equals(const char *cstr) const {
+  return !strcmp(c_str(), cstr ? cstr : "");
+}
+
+unsigned char String::equalsIgnoreCase(const String& s) const {
+  return (length() == s.length()) && !strcasecmp(c_str(), s.c_str());
+}
+
+unsigned char String::startsWith(const String& prefix) const {
+  return (prefix.length() <= length()) && !strncmp(c_str(), prefix.c_str(), prefix.length());
+}
+
+unsigned char String::endsWith(const String& suffix) const {
+  return (suffix.length() <= length()) && !strcmp(c_str() + length() - suffix.length(), suffix.c_str());
+}
+
+char String::charAt(unsigned int index) const {
+  return index < length() ? _buffer[index] : 0;
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+  const char *p;
+
+  if (fromIndex >= length())
+    return -1;
+  p = strchr(_buffer + fromIndex, ch);
+  return p ? p - _buffer : -1;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+  const char *p;
+
+  if (fromIndex >= length())
+    return -1;
+  p = strstr(_buffer + fromIndex, str.c_str());
+  return p ? p - _buffer : -1;
+}
+
+int String::lastIndexOf(char ch) const {
+  const char *p = _buffer ? strrchr(_buffer, ch) : NULL;
+
+  return p ? p - _buffer : -1;
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+  String out;
+
+  if (beginIndex > endIndex)
+    std::swap(beginIndex, endIndex);
+  if (beginIndex >= length())
+    return out;
+  if (endIndex > length())
+    endIndex = length();
+  out._copy(_buffer + beginIndex, endIndex - beginIndex);
+  return out;
+}
+
+void String::toLowerCase() {
+  for (unsigned int i = 0; i < length(); i++)
+    _buffer[i] = tolower((unsigned char)_buffer[i]);
+}
+
+void String::trim() {
+  unsigned int begin = 0, end = length();
+
+  while ((begin < end) && isspace((unsigned char)_buffer[begin]))
+    begin++;
+  while ((end > begin) && isspace((unsigned char)_buffer[end - 1]))
+    end--;
+  if (!_buffer)
+    return;
+  memmove(_buffer, _buffer + begin, end - begin);
+  _len = end - begin;
+  _buffer[_len] = 0;
+}
+
+long String::toInt() const {
+  return _buffer ? atol(_buffer) : 0;
+}
+
+String operator+(const String& lhs, const String& rhs) {
+  String out(lhs);
+
+  out.concat(rhs);
+  return out;
+}
+
+String operator+(const String& lhs, const char *rhs) {
+  String out(lhs);
+
+  out.concat(rhs);
+  return out;
+}
+
+String operator+(const char *lhs, const String& rhs) {
+  String out(lhs);
+
+  out.concat(rhs);
+  return out;
+}
@@ -0,0 +1,81 @@
+#ifndef __HOST_WSTRING_H
+#define __HOST_WSTRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class __FlashStringHelper;
+#define FPSTR(pstr_pointer) (reinterpret_cast<const __FlashStringHelper *>(pstr_pointer))
+#define F(string_literal) (FPSTR(PSTR(string_literal)))
+
+// String of core 2.4.0: every string, the empty one included, lives
+// in a heap buffer rounded up to 16 bytes, so the allocations of the
+// firmware are counted as on the board.
+class String {
+public:
+  String(const char *cstr = "");
+  String(const String& str);
+  String(const __FlashStringHelper *str);
+  explicit String(char c);
+  explicit String(unsigned char value, unsigned char base = 10);
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  ~String();
+
+  unsigned char reserve(unsigned int size);
+  unsigned int length() const { return _buffer ? _len : 0; }
+  const char *c_str() const { return _buffer ? _buffer : ""; }
+
+  String& operator=(const String& rhs);
+  String& operator=(const char *cstr);
+  String& operator=(const __FlashStringHelper *str);
+
+  unsigned char concat(const String& str);
+  unsigned char concat(const char *cstr);
+  unsigned char concat(const char *cstr, unsigned int length);
+  unsigned char concat(char c);
+  unsigned char concat(int value);
+  unsigned char concat(unsigned int value);
+  unsigned char concat(long value);
+  unsigned char concat(unsigned long value);
+  unsigned char concat(const __FlashStringHelper *str);
+  template <class T> String& operator+=(T rhs) { concat(rhs); return *this; }
+
+  int compareTo(const String& s) const;
+  unsigned char equals(const String& s) const;
+  unsigned char equals(const char *cstr) const;
+  unsigned char operator==(const String& rhs) const { return equals(rhs); }
+  unsigned char operator==(const char *cstr) const { return equals(cstr); }
+  unsigned char operator!=(const String& rhs) const { return !equals(rhs); }
+  unsigned char operator!=(const char *cstr) const { return !equals(cstr); }
+  unsigned char equalsIgnoreCase(const String& s) const;
+  unsigned char startsWith(const String& prefix) const;
+  unsigned char endsWith(const String& suffix) const;
+
+  char charAt(unsigned int index) const;
+  char operator[](unsigned int index) const { return charAt(index); }
+  int indexOf(char ch, unsigned int fromIndex = 0) const;
+  int indexOf(const String& str, unsigned int fromIndex = 0) const;
+  int lastIndexOf(char ch) const;
+  String substring(unsigned int beginIndex) const { return substring(beginIndex, length()); }
+  String substring(unsigned int beginIndex, unsigned int endIndex) const;
+  void toLowerCase();
+  void trim();
+  long toInt() const;
+protected:
+  void _invalidate();
+  unsigned char _changeBuffer(unsigned int maxStrLen);
+  String& _copy(const char *cstr, unsigned int length);
+
+  char *_buffer;
+  unsigned int _capacity; // Not counting the terminating zero
+  unsigned int _len;
+};
+
+String operator+(const String& lhs, const String& rhs);
+String operator+(const String& lhs, const char *rhs);
+String operator+(const char *lhs, const String& rhs);
+
+#endif
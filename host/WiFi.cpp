@@ -0,0 +1,205 @@
+#include "ESP8266WiFi.h"
+#include "HostInternal.h"
+
+extern "C" {
+#include "lwip/tcp.h"
+}
+
+// The ClientContext of core 2.4.0, shared by the copies of a WiFiClient
+struct HostClient {
+  tcp_pcb *pcb; // NULL once lwIP dropped the connection or it was stopped
+  int refs;
+};
+
+ESP8266WiFiClass WiFi;
+
+static WiFiServer *servers = NULL;
+
+static void onError(void *arg, err_t err) {
+  (void)err;
+  ((HostClient *)arg)->pcb = NULL;
+}
+
+static void closePcb(HostClient *client) {
+  tcp_pcb *pcb = client->pcb;
+
+  if (!pcb)
+    return;
+  client->pcb = NULL;
+  tcp_arg(pcb, NULL);
+  tcp_err(pcb, NULL);
+  if (tcp_close(pcb) != ERR_OK)
+    tcp_abort(pcb);
+}
+
+bool hostWiFiAccept(uint16_t port, struct tcp_pcb *pcb) {
+  for (WiFiServer *server = servers; server; server = server->_next) {
+    HostClient *client;
+    if (!server->_listening || (server->_port != port))
+      continue;
+    if (server->_unclaimedCount >= WIFISERVER_BACKLOG)
+      return false;
+    client = new HostClient;
+    client->pcb = pcb;
+    client->refs = 0;
+    tcp_arg(pcb, client);
+    tcp_err(pcb, onError);
+    server->_unclaimed[server->_unclaimedCount++] = client;
+    return true;
+  }
+  return false;
+}
+
+/***
+ * WiFiServer class implementation
+ */
+
+WiFiServer::WiFiServer(uint16_t port) : _port(port), _listening(false), _unclaimedCount(0) {
+  _next = servers;
+  servers = this;
+}
+
+WiFiServer::~WiFiServer() {
+  close();
+  for (WiFiServer **p = &servers; *p; p = &(*p)->_next) {
+    if (*p == this) {
+      *p = _next;
+      break;
+    }
+  }
+}
+
+void WiFiServer::begin() {
+  _listening = true;
+}
+
+WiFiClient WiFiServer::available() {
+  HostClient *client;
+
+  if (!_unclaimedCount)
+    return WiFiClient();
+  client = _unclaimed[0];
+  _unclaimedCount--;
+  memmove(_unclaimed, _unclaimed + 1, _unclaimedCount * sizeof(_unclaimed[0]));
+  return WiFiClient(client);
+}
+
+void WiFiServer::close() {
+  _listening = false;
+  while (_unclaimedCount) {
+    // Taken and dropped, the last reference closes it
+    WiFiClient client = available();
+  }
+}
+
+/***
+ * WiFiClient class implementation
+ */
+
+WiFiClient::WiFiClient(HostClient *client) : _client(client) {
+  if (_client)
+    _client->refs++;
+}
+
+WiFiClient::WiFiClient(const WiFiClient& other) : _client(other._client) {
+  if (_client)
+    _client->refs++;
+}
+
+WiFiClient& WiFiClient::operator=(const WiFiClient& other) {
+  if (other._client)
+    other._client->refs++;
+  _unref();
+  _client = other._client;
+  return *this;
+}
+
+WiFiClient::~WiFiClient() {
+  _unref();
+}
+
+void WiFiClient::_unref() {
+  if (_client && !--_client->refs) {
+    closePcb(_client);
+    delete _client;
+  }
+  _client = NULL;
+}
+
+uint8_t WiFiClient::connected() {
+  tcp_pcb *pcb = _client ? _client->pcb : NULL;
+
+  // ESTABLISHED, or data left to read after the peer closed
+  return (pcb && (pcb->state == HOST_TCP_OPEN) && !pcb->fin) || available();
+}
+
+int WiFiClient::available() {
+  return (_client && _client->pcb) ? _client->pcb->in_len : 0;
+}
+
+int WiFiClient::read() {
+  uint8_t c;
+
+  return (read(&c, 1) == 1) ? c : -1;
+}
+
+int WiFiClient::read(uint8_t *buffer, size_t size) {
+  tcp_pcb *pcb;
+  size_t n;
+
+  if (!available())
+    return 0;
+  pcb = _client->pcb;
+  n = min(size, (size_t)pcb->in_len);
+  memcpy(buffer, pcb->in, n);
+  memmove(pcb->in, pcb->in + n, pcb->in_len - n);
+  pcb->in_len -= n;
+  return n;
+}
+
+int WiFiClient::peek() {
+  return available() ? _client->pcb->in[0] : -1;
+}
+
+size_t WiFiClient::write(const uint8_t *buffer, size_t size) {
+  size_t written = 0;
+  bool waited = false;
+
+  while (written < size) {
+    tcp_pcb *pcb = _client ? _client->pcb : NULL;
+    u16_t n;
+    if (!pcb || (pcb->state != HOST_TCP_OPEN))
+      break;
+    n = min((size_t)tcp_sndbuf(pcb), size - written);
+    if (!n) {
+      // Waits for the peer to ack, the loop stands still meanwhile
+      if (waited)
+        break;
+      delay(WIFICLIENT_TIMEOUT);
+      waited = true;
+      continue;
+    }
+    tcp_write(pcb, buffer + written, n, TCP_WRITE_FLAG_COPY);
+    written += n;
+  }
+  return written;
+}
+
+size_t WiFiClient::availableForWrite() {
+  return (_client && _client->pcb) ? tcp_sndbuf(_client->pcb) : 0;
+}
+
+void WiFiClient::setNoDelay(bool nodelay) {
+  if (!_client || !_client->pcb)
+    return;
+  if (nodelay)
+    tcp_nagle_disable(_client->pcb);
+  else
+    tcp_nagle_enable(_client->pcb);
+}
+
+void WiFiClient::stop() {
+  if (_client)
+    closePcb(_client);
+  _unref();
+}
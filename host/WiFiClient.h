@@ -0,0 +1,40 @@
+#ifndef __HOST_WIFICLIENT_H
+#define __HOST_WIFICLIENT_H
+
+#include <Arduino.h>
+
+#define WIFICLIENT_TIMEOUT 5000 // ms write() waits for room in the send buffer, as ClientContext of 2.4.0
+
+struct HostClient;
+
+// WiFiClient of core 2.4.0 on a pcb of the simulated lwIP. Copies
+// share the connection, the last one closes it. A write() that does
+// not fit the send buffer blocks for up to WIFICLIENT_TIMEOUT and then
+// returns what was taken.
+class WiFiClient : public Stream {
+public:
+  WiFiClient() : _client(NULL) {}
+  WiFiClient(HostClient *client);
+  WiFiClient(const WiFiClient& other);
+  WiFiClient& operator=(const WiFiClient& other);
+  ~WiFiClient();
+  uint8_t connected();
+  int available();
+  int read();
+  int read(uint8_t *buffer, size_t size);
+  int peek();
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size);
+  size_t write_P(PGM_P buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+  using Print::write;
+  size_t availableForWrite(); // Bytes write() takes without blocking
+  void setNoDelay(bool nodelay);
+  void stop();
+  operator bool() const { return _client != NULL; }
+protected:
+  void _unref();
+
+  HostClient *_client;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef __HOST_WIFISERVER_H
+#define __HOST_WIFISERVER_H
+
+#include "WiFiClient.h"
+
+#define WIFISERVER_BACKLOG 5 // Accepted connections not taken by available() yet
+
+// WiFiServer of core 2.4.0. The connections come from HostPeer and
+// take pcbs of the simulated lwIP.
+class WiFiServer {
+public:
+  WiFiServer(uint16_t port);
+  ~WiFiServer();
+  void begin();
+  WiFiClient available();
+  void setNoDelay(bool nodelay) { (void)nodelay; }
+  void close();
+  void stop() { close(); }
+protected:
+  friend bool hostWiFiAccept(uint16_t port, struct tcp_pcb *pcb);
+
+  uint16_t _port;
+  bool _listening;
+  HostClient *_unclaimed[WIFISERVER_BACKLOG];
+  uint8_t _unclaimedCount;
+  WiFiServer *_next; // All servers, for hostWiFiAccept()
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "Wire.h"
+#include "Host.h"
+
+TwoWire Wire;
+
+static HostI2cDevice *devices[128];
+static HostI2cStats stats;
+
+void hostAttachI2c(uint8_t address, HostI2cDevice *device) {
+  devices[address & 0x7F] = device;
+}
+
+HostI2cStats hostI2cStats() {
+  return stats;
+}
+
+static void busTime(size_t bytes) {
+  stats.transactions++;
+  stats.bytes += bytes;
+  hostAdvanceMicros(HOST_I2C_US(bytes));
+}
+
+/***
+ * TwoWire class implementation
+ */
+
+void TwoWire::beginTransmission(uint8_t address) {
+  _address = address;
+  _txLen = 0;
+  _transmitting = true;
+}
+
+// 0: success, 2: address NACK
+uint8_t TwoWire::endTransmission(uint8_t sendStop) {
+  HostI2cDevice *device = devices[_address & 0x7F];
+
+  (void)sendStop;
+  _transmitting = false;
+  busTime(1 + (device ? _txLen : 0));
+  if (!device)
+    return 2;
+  device->i2cWrite(_tx, _txLen);
+  _txLen = 0;
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, size_t size, bool sendStop) {
+  HostI2cDevice *device = devices[address & 0x7F];
+
+  (void)sendStop;
+  if (size > BUFFER_LENGTH)
+    size = BUFFER_LENGTH;
+  _rxPos = 0;
+  _rxLen = 0;
+  busTime(1 + (device ? size : 0));
+  if (!device)
+    return 0;
+  device->i2cRead(_rx, size);
+  _rxLen = size;
+  return size;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (!_transmitting || (_txLen >= BUFFER_LENGTH))
+    return 0;
+  _tx[_txLen++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+  size_t n = 0;
+
+  while ((n < quantity) && write(data[n]))
+    n++;
+  return n;
+}
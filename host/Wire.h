@@ -0,0 +1,42 @@
+#ifndef __HOST_WIRE_H
+#define __HOST_WIRE_H
+
+#include <Arduino.h>
+
+#define BUFFER_LENGTH 32
+
+// Wire of core 2.4.0 on the simulated I2C bus of Host.h.
+// Every transaction takes its bus time at 100 kHz.
+class TwoWire : public Stream {
+public:
+  TwoWire() : _address(0), _txLen(0), _rxLen(0), _rxPos(0), _transmitting(false) {}
+  void begin() {}
+  void begin(int sda, int scl) { (void)sda; (void)scl; }
+  void setClock(uint32_t frequency) { (void)frequency; }
+  void beginTransmission(uint8_t address);
+  void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+  uint8_t endTransmission(uint8_t sendStop);
+  uint8_t endTransmission() { return endTransmission(true); }
+  uint8_t requestFrom(uint8_t address, size_t size, bool sendStop);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity) { return requestFrom(address, (size_t)quantity, true); }
+  uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t)address, (size_t)quantity, true); }
+  size_t write(uint8_t data);
+  size_t write(const uint8_t *data, size_t quantity);
+  using Print::write;
+  int available() { return _rxLen - _rxPos; }
+  int read() { return _rxPos < _rxLen ? _rx[_rxPos++] : -1; }
+  int peek() { return _rxPos < _rxLen ? _rx[_rxPos] : -1; }
+  void flush() { _txLen = _rxLen = _rxPos = 0; }
+protected:
+  uint8_t _address;
+  uint8_t _tx[BUFFER_LENGTH];
+  uint8_t _txLen;
+  uint8_t _rx[BUFFER_LENGTH];
+  uint8_t _rxLen;
+  uint8_t _rxPos;
+  bool _transmitting;
+};
+
+extern TwoWire Wire;
+
+#endif
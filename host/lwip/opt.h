@@ -0,0 +1,12 @@
+#ifndef __HOST_LWIP_OPT_H
+#define __HOST_LWIP_OPT_H
+
+// lwIP 2 options of the ESP8266 core 2.4.0 ("v2 Lower Memory")
+
+#define MEMP_NUM_TCP_PCB        5            // Connections, listeners not counted
+#define MEMP_NUM_TCP_PCB_LISTEN 4
+#define TCP_MSS                 536
+#define TCP_SND_BUF             (2 * TCP_MSS)
+#define TCP_WND                 (4 * TCP_MSS)
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef __HOST_LWIP_PBUF_H
+#define __HOST_LWIP_PBUF_H
+
+#include "lwip/err.h"
+
+// PBUF_RAM only: header and payload in one heap block
+struct pbuf {
+  struct pbuf *next;
+  void *payload;
+  u16_t tot_len; // This and the rest of the chain
+  u16_t len;
+  u16_t ref;
+};
+
+struct pbuf *pbuf_alloc_ram(u16_t length); // Host only, stands for pbuf_alloc(PBUF_RAW, length, PBUF_RAM)
+u8_t pbuf_free(struct pbuf *p);             // Frees the chain, returns the number of pbufs freed
+void pbuf_ref(struct pbuf *p);
+void pbuf_cat(struct pbuf *head, struct pbuf *tail);
+
+#endif
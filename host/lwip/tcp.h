@@ -0,0 +1,93 @@
+#ifndef __HOST_LWIP_TCP_H
+#define __HOST_LWIP_TCP_H
+
+// The raw TCP API of lwIP 2 on the simulated board, see HostTcp.cpp.
+// The fields after the callbacks are the host's own.
+
+#include "lwip/opt.h"
+#include "lwip/err.h"
+#include "lwip/pbuf.h"
+
+typedef struct ip_addr {
+  u32_t addr;
+} ip_addr_t;
+
+extern const ip_addr_t ip_addr_any;
+#define IP_ADDR_ANY (&ip_addr_any)
+
+#define TCP_PRIO_MIN    1
+#define TCP_PRIO_NORMAL 64
+#define TCP_PRIO_MAX    127
+
+#define TCP_WRITE_FLAG_COPY 0x01
+#define TCP_WRITE_FLAG_MORE 0x02
+
+#define TF_NODELAY 0x40
+
+// tcp_pcb::state
+#define HOST_TCP_FREE    0
+#define HOST_TCP_NEW     1 // tcp_new(), not listening
+#define HOST_TCP_LISTEN  2
+#define HOST_TCP_OPEN    3
+#define HOST_TCP_CLOSING 4 // tcp_close(), the send buffer still drains
+
+struct tcp_pcb;
+
+typedef err_t (*tcp_accept_fn)(void *arg, struct tcp_pcb *newpcb, err_t err);
+typedef err_t (*tcp_recv_fn)(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
+typedef err_t (*tcp_sent_fn)(void *arg, struct tcp_pcb *tpcb, u16_t len);
+typedef err_t (*tcp_poll_fn)(void *arg, struct tcp_pcb *tpcb);
+typedef void (*tcp_err_fn)(void *arg, err_t err);
+
+class HostPeer;
+
+struct tcp_pcb {
+  u8_t state;            // HOST_TCP_*
+  u8_t prio;
+  u8_t flags;
+  u8_t pollinterval;     // Half seconds
+  u16_t local_port;
+  void *callback_arg;
+  tcp_accept_fn accept;
+  tcp_recv_fn recv;
+  tcp_sent_fn sent;
+  tcp_poll_fn poll;
+  tcp_err_fn errf;
+  int fd;                // Socket, -1 for a WiFiServer connection
+  u32_t active;          // millis() of the last segment, tcp_kill_prio() takes the oldest
+  u32_t polled;          // millis() of the last poll callback
+  u16_t rcv_wnd;
+  u16_t acked;           // Sent and not yet told to the sent callback
+  u16_t snd_len;         // Queued in snd and not taken by the other end
+  u8_t snd[TCP_SND_BUF];
+  struct pbuf *refused;  // Data the recv callback did not take, offered again
+  bool fin;              // The other end closed, recv(NULL) is due or done
+  bool finTold;
+  HostPeer *peer;        // Far end of a WiFiServer connection
+  u16_t in_len;          // From the peer, not read by the firmware yet
+  u8_t in[TCP_WND];
+};
+
+#define tcp_sndbuf(pcb)         ((u16_t)(TCP_SND_BUF - (pcb)->snd_len))
+#define tcp_nagle_disable(pcb)  ((pcb)->flags |= TF_NODELAY)
+#define tcp_nagle_enable(pcb)   ((pcb)->flags &= ~TF_NODELAY)
+#define tcp_accepted(pcb)       do { (void)(pcb); } while (0)
+#define tcp_listen(pcb)         tcp_listen_with_backlog(pcb, 255)
+
+struct tcp_pcb *tcp_new(void);
+err_t tcp_bind(struct tcp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port);
+struct tcp_pcb *tcp_listen_with_backlog(struct tcp_pcb *pcb, u8_t backlog);
+void tcp_setprio(struct tcp_pcb *pcb, u8_t prio);
+void tcp_arg(struct tcp_pcb *pcb, void *arg);
+void tcp_accept(struct tcp_pcb *pcb, tcp_accept_fn accept);
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv);
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent);
+void tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval);
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err);
+void tcp_recved(struct tcp_pcb *pcb, u16_t len);
+err_t tcp_write(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags);
+err_t tcp_output(struct tcp_pcb *pcb);
+err_t tcp_close(struct tcp_pcb *pcb);
+void tcp_abort(struct tcp_pcb *pcb);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef __HOST_PGMSPACE_H
+#define __HOST_PGMSPACE_H
+
+// Flash and RAM are one address space on the host
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+
+#define memcpy_P memcpy
+#define memcmp_P memcmp
+#define memccpy_P memccpy
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strcasecmp_P strcasecmp
+#define sprintf_P sprintf
+#define snprintf_P snprintf
+
+#endif
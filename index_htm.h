@@ -0,0 +1,241 @@
+// Generated by tools/embed_web.py from data/index.htm, do not edit.
+// 15361 bytes, 15337 minified, 3631 gzipped.
+#ifndef __INDEX_HTM_H
+#define __INDEX_HTM_H
+
+#include <Arduino.h>
+
+#define INDEX_HTM_ETAG "\"cd0beed8\""
+#define INDEX_HTM_GZ_LEN 3631
+
+static const uint8_t INDEX_HTM_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xed, 0x5b, 0x5f, 0x6f, 0xdb, 0x46,
+  0x12, 0x7f, 0xd7, 0xa7, 0xd8, 0xb2, 0xb8, 0x40, 0x82, 0x2d, 0x4a, 0x76, 0x9a, 0x36, 0x17, 0x4b,
+  0x0e, 0xd0, 0x36, 0x77, 0xed, 0x21, 0x6e, 0x8b, 0xc6, 0xc0, 0x1d, 0x10, 0xf8, 0x81, 0x16, 0x57,
+  0xd6, 0x5e, 0x28, 0x52, 0xe5, 0x1f, 0x3b, 0x46, 0x2f, 0x40, 0x1c, 0xf7, 0x2f, 0x12, 0x24, 0x68,
+  0x9a, 0x87, 0x7b, 0xb8, 0x36, 0x97, 0xeb, 0x43, 0x5f, 0x6d, 0x37, 0x6e, 0xdc, 0x26, 0x76, 0xbe,
+  0x02, 0xf9, 0x8d, 0x6e, 0x66, 0x96, 0xa4, 0x96, 0x14, 0x45, 0xcb, 0xb1, 0xe3, 0xcb, 0x15, 0xc5,
+  0xa1, 0x91, 0xb9, 0x3b, 0x3b, 0x3b, 0x33, 0x3b, 0xfb, 0x9b, 0xd9, 0xd9, 0xbd, 0xd6, 0x6b, 0xa6,
+  0xd3, 0xf1, 0xd7, 0x07, 0x9c, 0xf5, 0xfc, 0xbe, 0x35, 0x5f, 0x69, 0x25, 0x3f, 0xdc, 0x30, 0xe1,
+  0xa7, 0xcf, 0x7d, 0x83, 0x75, 0x7a, 0x86, 0xeb, 0x71, 0xbf, 0xad, 0x05, 0x7e, 0xb7, 0x7e, 0x5e,
+  0x4b, 0x9a, 0x6d, 0xa3, 0xcf, 0xdb, 0xda, 0xaa, 0xe0, 0x6b, 0x03, 0xc7, 0xf5, 0x35, 0xd6, 0x71,
+  0x6c, 0x9f, 0xdb, 0x40, 0xb6, 0x26, 0x4c, 0xbf, 0xd7, 0x36, 0xf9, 0xaa, 0xe8, 0xf0, 0x3a, 0x7d,
+  0xcc, 0x31, 0x61, 0x0b, 0x5f, 0x18, 0x56, 0xdd, 0xeb, 0x18, 0x16, 0x6f, 0xcf, 0xe8, 0xcd, 0x39,
+  0xd6, 0x37, 0xae, 0x8b, 0x7e, 0xd0, 0x57, 0x9a, 0x90, 0xb5, 0x2f, 0x7c, 0x8b, 0xcf, 0x57, 0xc2,
+  0x1f, 0xc2, 0x67, 0xe1, 0x7e, 0xb8, 0x15, 0xdd, 0x63, 0x7f, 0x15, 0xf5, 0x3f, 0x09, 0x16, 0xdd,
+  0x0c, 0xb7, 0xc2, 0x27, 0xe1, 0x6e, 0x74, 0x2b, 0xfc, 0x35, 0xdc, 0xaa, 0xb4, 0x1a, 0x31, 0x61,
+  0xcb, 0xf3, 0xd7, 0xf1, 0xf7, 0x75, 0xaf, 0xd3, 0xe3, 0x66, 0x60, 0x71, 0xb7, 0x0e, 0x82, 0x74,
+  0xc5, 0x4a, 0xe0, 0x1a, 0xbe, 0x70, 0x6c, 0xf6, 0x69, 0xc5, 0x14, 0xde, 0xc0, 0x32, 0xd6, 0x2f,
+  0x30, 0xdb, 0xb1, 0xf9, 0x5c, 0xe5, 0x46, 0xe5, 0x75, 0x5f, 0xf4, 0xf9, 0x04, 0x64, 0x2e, 0xb0,
+  0xf3, 0x0e, 0xa7, 0xb3, 0x04, 0xb4, 0x5a, 0xc2, 0xf3, 0xeb, 0x24, 0x4b, 0x1d, 0xcd, 0x39, 0xec,
+  0x0d, 0x2c, 0xe8, 0xed, 0x1b, 0xee, 0x8a, 0xb0, 0xeb, 0x16, 0xef, 0xfa, 0x17, 0x58, 0x73, 0xae,
+  0x32, 0x30, 0x4c, 0x53, 0xd8, 0x2b, 0xc3, 0x86, 0x1b, 0xa0, 0x51, 0xac, 0x49, 0xcb, 0xeb, 0xb8,
+  0x62, 0xe0, 0xcf, 0x57, 0xba, 0x81, 0xdd, 0xa1, 0x39, 0x7b, 0xc2, 0xe4, 0x6f, 0x5b, 0xce, 0x35,
+  0xaf, 0x5a, 0x03, 0x5e, 0xab, 0x86, 0xcb, 0x96, 0xf1, 0x8b, 0xb5, 0x19, 0x2c, 0x5e, 0xd0, 0x07,
+  0xa3, 0xeb, 0x2b, 0xdc, 0xbf, 0x64, 0x71, 0xfc, 0xd3, 0x7b, 0x7b, 0x7d, 0xd1, 0x58, 0xf9, 0x00,
+  0x16, 0xa7, 0xaa, 0x99, 0x62, 0x55, 0xab, 0xcd, 0x55, 0xba, 0x8e, 0x5b, 0xc5, 0x51, 0x82, 0xb5,
+  0xc1, 0xee, 0x82, 0xb5, 0xda, 0x92, 0x81, 0x6e, 0x71, 0x7b, 0x85, 0x56, 0x67, 0x6a, 0x0a, 0x39,
+  0x8b, 0x2e, 0xab, 0x52, 0xc7, 0x55, 0xb1, 0xc4, 0x5e, 0x6b, 0xb3, 0xc0, 0x36, 0x79, 0x57, 0xd8,
+  0xdc, 0xcc, 0x77, 0xea, 0xc2, 0xd4, 0x05, 0x74, 0x5e, 0xff, 0xb0, 0x5b, 0xd5, 0x32, 0xf6, 0xd1,
+  0x6a, 0x38, 0xb0, 0x3e, 0x53, 0x63, 0x29, 0x2d, 0xa9, 0xa5, 0xc7, 0x56, 0x03, 0x99, 0x35, 0xb4,
+  0x8c, 0x86, 0x2a, 0xe3, 0xff, 0x52, 0x25, 0x25, 0x9b, 0x45, 0x58, 0x19, 0xd2, 0x92, 0xaf, 0xa2,
+  0x5a, 0x03, 0x97, 0x7e, 0xdf, 0xe5, 0x5d, 0x23, 0xb0, 0xfc, 0x2a, 0xe8, 0x82, 0x7a, 0xac, 0x73,
+  0xf8, 0x47, 0x51, 0x1e, 0xf4, 0xeb, 0x7b, 0x57, 0x67, 0x96, 0x74, 0xec, 0xd0, 0x57, 0x0d, 0x2b,
+  0xe0, 0x92, 0xb0, 0x0f, 0x2e, 0xd9, 0x2b, 0xa4, 0xa4, 0x1e, 0x95, 0xd4, 0x24, 0xd9, 0x46, 0x09,
+  0xa1, 0x5d, 0x25, 0xeb, 0x39, 0x41, 0xf1, 0xd4, 0xd8, 0x91, 0x99, 0x5a, 0xd8, 0x81, 0xcf, 0x8b,
+  0xe7, 0xa6, 0x2e, 0x95, 0x38, 0x70, 0x2d, 0x34, 0x4c, 0x03, 0xfd, 0xb2, 0x01, 0x5b, 0xed, 0x22,
+  0x2a, 0xd2, 0xd6, 0xa6, 0xf0, 0x67, 0x4a, 0x3b, 0x43, 0xc2, 0xc2, 0x27, 0xfd, 0xc2, 0x37, 0xc8,
+  0x04, 0x5f, 0xf0, 0x2f, 0xfc, 0x8d, 0xf3, 0xc2, 0x07, 0xfe, 0x20, 0x25, 0xb1, 0x46, 0x52, 0xfa,
+  0x43, 0x72, 0x77, 0xf9, 0x27, 0x01, 0xf7, 0x7c, 0x98, 0xc1, 0xe6, 0x6b, 0xec, 0x6f, 0x0b, 0x97,
+  0xdf, 0xf3, 0xfd, 0xc1, 0xc7, 0xb2, 0x11, 0x4d, 0x1a, 0xf7, 0xeb, 0xce, 0x2a, 0x77, 0x5d, 0x70,
+  0xb5, 0x05, 0x90, 0x62, 0x11, 0x7c, 0xb8, 0xaa, 0xf9, 0xfc, 0xba, 0xdf, 0xb8, 0xde, 0xb7, 0x34,
+  0x95, 0x6a, 0xc0, 0xed, 0xaa, 0xf6, 0xe7, 0x4b, 0x8b, 0xda, 0x34, 0xca, 0x3d, 0xcd, 0x7c, 0x37,
+  0xe0, 0x6a, 0xbf, 0xed, 0x02, 0x76, 0xac, 0x7b, 0xbe, 0xe1, 0x73, 0x40, 0x0e, 0x7b, 0x05, 0x8d,
+  0x90, 0xac, 0x72, 0x35, 0xf1, 0xa4, 0x84, 0x9a, 0x68, 0xaf, 0x20, 0x2d, 0x6b, 0xb7, 0xd9, 0x1b,
+  0xf9, 0x6e, 0xe4, 0x12, 0x78, 0xd8, 0x35, 0xdb, 0x6c, 0x62, 0x27, 0x40, 0x85, 0xeb, 0x57, 0xb5,
+  0xf0, 0x3e, 0xe0, 0xc1, 0x6e, 0xf8, 0x0c, 0xe0, 0x21, 0xdc, 0x8e, 0x6e, 0x87, 0x4f, 0xc3, 0x03,
+  0x16, 0x6d, 0x46, 0x1b, 0xe1, 0x73, 0x40, 0x88, 0xaf, 0x00, 0x38, 0xe0, 0x73, 0x03, 0x80, 0xe2,
+  0x20, 0xdc, 0x8f, 0x3e, 0x0b, 0xf7, 0xc2, 0x9f, 0xa0, 0xf3, 0x66, 0xb8, 0x07, 0xff, 0x1d, 0x84,
+  0x3b, 0x00, 0x24, 0x40, 0x80, 0x3a, 0x8d, 0xae, 0x8d, 0xcb, 0xc1, 0xfc, 0x68, 0x94, 0x1b, 0x15,
+  0x6e, 0x79, 0x9c, 0x25, 0xf3, 0x3d, 0xa4, 0xa1, 0x7b, 0x80, 0x40, 0x07, 0xc0, 0xff, 0x69, 0xb8,
+  0xc5, 0xe8, 0x8f, 0xbd, 0x70, 0x1b, 0xe1, 0x88, 0x85, 0xcf, 0x91, 0x3d, 0x2b, 0x9d, 0x71, 0x0f,
+  0x09, 0x76, 0xa4, 0xdc, 0xf0, 0x1f, 0x34, 0xe8, 0x2c, 0xe6, 0xbb, 0x03, 0x52, 0xdf, 0x8c, 0xee,
+  0x00, 0xb6, 0xed, 0xa2, 0xdc, 0x07, 0xd0, 0xfd, 0x18, 0xe8, 0xf7, 0x25, 0x19, 0x35, 0x32, 0xfc,
+  0x46, 0x02, 0x18, 0xb0, 0x4f, 0x30, 0x78, 0x10, 0x3e, 0x63, 0xc8, 0xf2, 0x39, 0x32, 0xc0, 0x6f,
+  0x9a, 0x0f, 0x59, 0x50, 0xd3, 0xf3, 0xe8, 0x36, 0x62, 0x65, 0xb4, 0xa9, 0xd5, 0xe4, 0x5e, 0x4b,
+  0x6d, 0xca, 0x6d, 0xb3, 0x6a, 0x07, 0x96, 0x45, 0xed, 0xe9, 0xfe, 0x03, 0x04, 0xb9, 0x92, 0x40,
+  0xe8, 0x3b, 0xea, 0x96, 0x4e, 0x41, 0xe7, 0xe5, 0xf9, 0x91, 0xd6, 0x30, 0x06, 0xa2, 0x21, 0x17,
+  0x5b, 0x3b, 0x65, 0x8f, 0x42, 0xcd, 0x10, 0x7b, 0x80, 0xe7, 0x5f, 0xae, 0x7c, 0xf8, 0x81, 0x3e,
+  0xc0, 0x60, 0xa7, 0x70, 0xf3, 0x06, 0x8e, 0xed, 0xf1, 0x45, 0xd0, 0xa0, 0xa6, 0xa7, 0x31, 0x66,
+  0x8e, 0x78, 0xe2, 0x30, 0x1d, 0xc3, 0x9e, 0xeb, 0x58, 0xfc, 0x4a, 0xd0, 0xef, 0x23, 0xf6, 0xcd,
+  0x9e, 0x3b, 0x97, 0xb0, 0xf5, 0x0d, 0xef, 0xda, 0x65, 0x41, 0x16, 0x4b, 0x3d, 0xad, 0x03, 0xf2,
+  0xf9, 0x3c, 0xc6, 0xea, 0xaa, 0xe6, 0x90, 0x4d, 0x12, 0xe2, 0x12, 0x42, 0x4b, 0x20, 0x21, 0x12,
+  0x01, 0xf2, 0xda, 0xdc, 0x45, 0x81, 0x10, 0x33, 0xc2, 0xef, 0xc1, 0x61, 0xd0, 0x7f, 0xbe, 0x1e,
+  0x3a, 0xcb, 0x17, 0xd4, 0x80, 0x1e, 0xb2, 0xa3, 0x6b, 0x43, 0xee, 0x1f, 0x19, 0x2e, 0x44, 0x05,
+  0x9f, 0xbb, 0xde, 0x44, 0x02, 0x81, 0xa5, 0x5c, 0x1f, 0xf1, 0xf8, 0x50, 0xa9, 0x90, 0x1a, 0x9c,
+  0x6a, 0x22, 0xda, 0x94, 0x6b, 0x4e, 0x0d, 0x65, 0x43, 0x3f, 0x81, 0xed, 0xf2, 0x9c, 0x76, 0x33,
+  0x6c, 0xad, 0x0b, 0x4c, 0x9b, 0x22, 0x3b, 0xd3, 0xc0, 0xf7, 0x08, 0xe6, 0x2e, 0xa8, 0x4d, 0x0b,
+  0x31, 0xd2, 0xc5, 0x02, 0x8c, 0x67, 0xbb, 0x03, 0x38, 0xf1, 0x6b, 0xf8, 0x34, 0xba, 0x1b, 0x7d,
+  0x29, 0x4d, 0x15, 0xdd, 0x4b, 0x99, 0xc3, 0xe0, 0x2c, 0x6b, 0x68, 0x48, 0x18, 0x27, 0xab, 0xa8,
+  0x1b, 0x03, 0x70, 0x59, 0xf3, 0x9d, 0x9e, 0xb0, 0xcc, 0x2a, 0x36, 0x26, 0xeb, 0x91, 0x6f, 0x1f,
+  0xda, 0x39, 0xa6, 0x18, 0x36, 0x64, 0x68, 0x53, 0x53, 0x94, 0x93, 0xc5, 0x8a, 0xa9, 0x70, 0x35,
+  0x8c, 0xf6, 0x6f, 0xaf, 0xbf, 0x6f, 0x56, 0x35, 0xaf, 0xe7, 0xac, 0xd5, 0x91, 0x85, 0xa7, 0xd5,
+  0x72, 0x06, 0xf8, 0x81, 0x21, 0xfc, 0x20, 0x7e, 0xec, 0x46, 0x1b, 0xd1, 0xad, 0xe8, 0x0e, 0x02,
+  0xcc, 0x53, 0x04, 0x18, 0xb0, 0xf0, 0x5d, 0xf0, 0x1a, 0xf4, 0x18, 0x32, 0xf9, 0x63, 0x20, 0xfb,
+  0x32, 0xdc, 0x03, 0x9b, 0x4c, 0x3a, 0x53, 0x5e, 0x71, 0xb4, 0x52, 0x0c, 0x36, 0x19, 0xf0, 0xfc,
+  0x0e, 0x9d, 0x72, 0x13, 0x27, 0x40, 0xa0, 0x06, 0x31, 0xee, 0x48, 0x88, 0x7a, 0x0a, 0x22, 0x7c,
+  0x89, 0x98, 0x25, 0xa5, 0x7a, 0x0e, 0x7f, 0x22, 0xf8, 0xfd, 0xaa, 0xc8, 0x73, 0x3a, 0x10, 0xa9,
+  0x4f, 0x88, 0x91, 0x32, 0x47, 0x49, 0x61, 0xf2, 0xd0, 0x44, 0xe5, 0x64, 0x10, 0x53, 0xcd, 0x10,
+  0xa4, 0x04, 0x8d, 0x14, 0x88, 0x2e, 0xa6, 0xdb, 0x02, 0x33, 0x82, 0x6c, 0x38, 0x6b, 0x2e, 0x0d,
+  0x37, 0x8d, 0xcc, 0x36, 0x20, 0x43, 0x50, 0xf6, 0xcc, 0xf8, 0x11, 0x0b, 0x4a, 0x86, 0x02, 0x63,
+  0xe2, 0xdd, 0x51, 0x48, 0x1f, 0xf7, 0xa9, 0xb4, 0x25, 0xdc, 0xd3, 0xde, 0x24, 0xfb, 0x79, 0xb5,
+  0xb2, 0x8a, 0x87, 0x18, 0xd9, 0x09, 0x1a, 0xc8, 0xe5, 0x68, 0x77, 0xa8, 0xde, 0x78, 0xb4, 0x1c,
+  0xa3, 0x20, 0xc3, 0x68, 0x8e, 0xcf, 0x30, 0x0a, 0x36, 0x49, 0x19, 0x7b, 0xda, 0x34, 0x20, 0x4a,
+  0xb9, 0xc0, 0xaf, 0x54, 0x86, 0x81, 0xd8, 0x41, 0x8b, 0x52, 0x4d, 0xa2, 0xea, 0x70, 0x61, 0xe4,
+  0x37, 0xad, 0x0c, 0xb5, 0x8e, 0x07, 0x20, 0xa4, 0x18, 0x41, 0xb9, 0xef, 0x40, 0xe1, 0x9f, 0x40,
+  0xc1, 0x4d, 0x50, 0x9d, 0xf2, 0xb1, 0x9d, 0x0c, 0xd4, 0x6f, 0x95, 0x42, 0xda, 0x9a, 0xf0, 0x3b,
+  0xbd, 0x11, 0x96, 0xf7, 0x95, 0x70, 0x41, 0x10, 0xa5, 0xa5, 0x4b, 0x76, 0x02, 0xe2, 0xe5, 0x62,
+  0xd1, 0x0b, 0x09, 0x58, 0x20, 0xde, 0x8d, 0x4a, 0xa3, 0xc1, 0x3e, 0xe6, 0x78, 0xd0, 0x22, 0x49,
+  0x98, 0x61, 0x9b, 0x0c, 0x4f, 0x15, 0x70, 0x00, 0x67, 0x70, 0xec, 0x4a, 0x10, 0x09, 0xf6, 0x57,
+  0x8f, 0x33, 0x79, 0x44, 0x07, 0x1a, 0x6f, 0x0d, 0x93, 0x02, 0xe1, 0xb3, 0xae, 0xeb, 0xf4, 0x19,
+  0x9c, 0xf8, 0x0d, 0xc0, 0x97, 0x6c, 0x6a, 0x48, 0x5b, 0xe6, 0xff, 0x3b, 0x15, 0x64, 0x67, 0xce,
+  0xb0, 0xd2, 0x34, 0x30, 0x69, 0x3c, 0x34, 0x11, 0x84, 0x34, 0x26, 0xf5, 0x65, 0x39, 0xa8, 0x2c,
+  0x3a, 0xa3, 0xfd, 0x73, 0xab, 0x27, 0x07, 0xe9, 0xd8, 0x53, 0xb6, 0x75, 0x50, 0xa8, 0x81, 0x63,
+  0x59, 0x18, 0xff, 0xf1, 0xd8, 0x89, 0x1d, 0x73, 0xca, 0x86, 0x42, 0xac, 0xfe, 0x08, 0xfa, 0x85,
+  0xbd, 0x92, 0x2a, 0x9f, 0xd2, 0xd7, 0x40, 0x59, 0x3f, 0x70, 0xed, 0xb9, 0x8a, 0xca, 0x02, 0xc0,
+  0xe7, 0x7d, 0x1b, 0x72, 0x0c, 0xc0, 0xdf, 0x6a, 0xba, 0xae, 0xd3, 0xec, 0x1c, 0x58, 0x61, 0xae,
+  0xa2, 0x2c, 0x74, 0x76, 0xe7, 0xfa, 0xce, 0x20, 0x3f, 0xcf, 0x6b, 0x05, 0x13, 0x75, 0x2c, 0x38,
+  0xb0, 0xa6, 0xec, 0x87, 0x04, 0x59, 0x11, 0xa4, 0x16, 0xe4, 0xaa, 0x8b, 0x43, 0x2f, 0x1c, 0x04,
+  0x5e, 0x8f, 0x7b, 0xe4, 0x97, 0x6e, 0xde, 0x81, 0xa1, 0x8d, 0x9c, 0x18, 0x44, 0xc1, 0x5a, 0x13,
+  0x3b, 0x3f, 0xa3, 0xe3, 0xe8, 0x58, 0x24, 0x68, 0xb6, 0xd6, 0x99, 0x1b, 0xd8, 0x1e, 0x5b, 0x83,
+  0x5c, 0x84, 0x13, 0x3d, 0x85, 0x63, 0xe0, 0x01, 0x3e, 0xd0, 0x67, 0xc2, 0x83, 0xac, 0x74, 0xcd,
+  0xd6, 0x15, 0x8d, 0x82, 0x65, 0x2c, 0xb3, 0x2c, 0xf3, 0xa1, 0x3e, 0x6b, 0xc2, 0x06, 0x22, 0xfd,
+  0x12, 0x0e, 0xbc, 0x02, 0x21, 0xad, 0x43, 0x40, 0x94, 0xb5, 0x31, 0x7a, 0xa2, 0x54, 0x55, 0x2e,
+  0x8e, 0x47, 0x74, 0xf1, 0x36, 0x50, 0x46, 0x56, 0xb5, 0x1e, 0x6c, 0x88, 0x0b, 0x8d, 0x86, 0xc6,
+  0xa6, 0x98, 0xe5, 0x74, 0xe8, 0x20, 0xa5, 0xf7, 0x1c, 0xcf, 0xc7, 0xaa, 0x19, 0xb4, 0x69, 0x17,
+  0xce, 0xcf, 0x34, 0x48, 0x46, 0x8f, 0xb2, 0x62, 0x1a, 0xa5, 0x1b, 0xa6, 0x49, 0x4c, 0x30, 0x91,
+  0xe2, 0xe0, 0x2d, 0x09, 0x9e, 0x4c, 0x0f, 0x7d, 0x5c, 0x0a, 0x95, 0x7a, 0x9f, 0xe2, 0xa9, 0x5c,
+  0x37, 0x0d, 0xdf, 0xa8, 0xe1, 0xca, 0x95, 0x71, 0x24, 0x6f, 0xcc, 0x33, 0x3c, 0x8a, 0xef, 0xca,
+  0x79, 0x32, 0xb3, 0x38, 0x36, 0x6e, 0x61, 0xf2, 0xeb, 0xd4, 0x51, 0x94, 0x4e, 0xc0, 0x00, 0xc7,
+  0x95, 0x5e, 0x9f, 0xda, 0x32, 0xeb, 0x5f, 0x84, 0x70, 0x84, 0x5b, 0xa7, 0x02, 0x31, 0x09, 0xa2,
+  0xce, 0x95, 0xec, 0xbb, 0x35, 0xce, 0xaf, 0x99, 0xc6, 0x3a, 0xc2, 0xc1, 0x55, 0x8c, 0x06, 0x1b,
+  0x38, 0x12, 0x32, 0x84, 0x7d, 0xfa, 0xbd, 0x1f, 0xdd, 0xa2, 0xdf, 0x47, 0xd1, 0x4d, 0xfa, 0xfd,
+  0x31, 0xfe, 0x7e, 0x98, 0xb4, 0x87, 0xdb, 0xda, 0x92, 0xb2, 0x55, 0x65, 0x3d, 0xc6, 0x5b, 0x74,
+  0xa8, 0xc0, 0x15, 0x7f, 0x25, 0xaa, 0xa6, 0xb5, 0xa2, 0xb8, 0x9d, 0xfd, 0x81, 0xbd, 0xd9, 0x4c,
+  0x5c, 0x8d, 0x2d, 0x18, 0x7e, 0x4f, 0xef, 0x5a, 0x8e, 0xe3, 0x26, 0xe3, 0x58, 0x03, 0xfa, 0x6b,
+  0x74, 0x58, 0x89, 0x9b, 0x58, 0x8b, 0xcd, 0x34, 0xd9, 0x45, 0xa6, 0x35, 0x35, 0x06, 0x09, 0xbc,
+  0x56, 0x4b, 0x0b, 0x40, 0x8a, 0x95, 0x5d, 0xde, 0x07, 0x63, 0x7d, 0x0c, 0x69, 0x63, 0x15, 0x52,
+  0xac, 0x97, 0x6f, 0xe7, 0xd3, 0xce, 0xe3, 0xc0, 0x77, 0x51, 0x39, 0x02, 0xaf, 0x43, 0x53, 0xab,
+  0xe4, 0x73, 0x2f, 0x4e, 0xa4, 0xa8, 0xbe, 0xbc, 0x03, 0x29, 0x10, 0x50, 0xbc, 0x72, 0x59, 0x13,
+  0xad, 0x19, 0x56, 0x98, 0xc1, 0x9e, 0x60, 0x74, 0x32, 0x6d, 0xb2, 0x7e, 0xc2, 0xe7, 0xfd, 0x89,
+  0x4e, 0xe8, 0x72, 0xf9, 0x4b, 0x48, 0x97, 0x03, 0xdf, 0xc7, 0x0a, 0xee, 0x5c, 0x05, 0x79, 0x66,
+  0xf6, 0x3c, 0xce, 0x3a, 0xa5, 0xe1, 0xc9, 0x50, 0x72, 0xc9, 0x1f, 0x32, 0x55, 0x63, 0x0e, 0x89,
+  0x46, 0xc1, 0xa7, 0x63, 0x89, 0xce, 0x35, 0x15, 0x7d, 0x50, 0x8b, 0x9c, 0x5f, 0xa2, 0xf6, 0x89,
+  0x0c, 0xea, 0x09, 0x53, 0x92, 0x41, 0x8f, 0x95, 0x3f, 0x8c, 0x23, 0xe9, 0x48, 0x31, 0x2b, 0x76,
+  0x85, 0x53, 0x4a, 0x58, 0xe8, 0xaa, 0xe0, 0x15, 0x2e, 0x5d, 0xc5, 0x2e, 0x00, 0x52, 0xe6, 0x0b,
+  0x52, 0x79, 0xc4, 0x47, 0x9a, 0x3a, 0x9a, 0x38, 0xad, 0xec, 0x5c, 0xef, 0xf0, 0x01, 0xca, 0x7b,
+  0xd8, 0xc8, 0x94, 0x30, 0x1d, 0x9e, 0xcc, 0x27, 0xdd, 0xe5, 0xbd, 0xc5, 0x85, 0xcb, 0xe8, 0x2e,
+  0xe0, 0x20, 0x19, 0x9e, 0x23, 0xbd, 0x54, 0x81, 0x21, 0x8b, 0xe2, 0xb1, 0xe9, 0x12, 0x24, 0xa3,
+  0xd5, 0xd4, 0x66, 0xd8, 0x3c, 0xcd, 0x44, 0xa2, 0x7e, 0x8c, 0xd0, 0x09, 0x58, 0xeb, 0x5d, 0x61,
+  0x41, 0xf6, 0x31, 0x24, 0x87, 0xc6, 0x69, 0x66, 0x4a, 0x2f, 0x23, 0x34, 0xc5, 0xf1, 0x3a, 0x8d,
+  0x3a, 0xc3, 0xaa, 0x33, 0xac, 0xd5, 0x82, 0xde, 0xd8, 0xe3, 0xd2, 0x9d, 0x96, 0x88, 0x3d, 0x4d,
+  0xec, 0xf5, 0xbf, 0x3b, 0x02, 0x56, 0x1b, 0x56, 0x1a, 0x21, 0x97, 0x25, 0xb5, 0xf5, 0x04, 0xcb,
+  0x89, 0x21, 0x45, 0x36, 0xe8, 0x66, 0xf5, 0xe2, 0x7e, 0x70, 0xd5, 0x5a, 0xc6, 0x55, 0x1a, 0xd2,
+  0x9b, 0x2f, 0xd2, 0x2d, 0x0a, 0x1c, 0x95, 0x45, 0x22, 0x84, 0xac, 0x3e, 0x25, 0xe6, 0x29, 0x30,
+  0x40, 0xda, 0xa7, 0x58, 0xc1, 0x8f, 0x23, 0x73, 0xd2, 0x25, 0xe5, 0x41, 0x4f, 0x19, 0x36, 0x81,
+  0x08, 0x18, 0x20, 0x46, 0x8e, 0x1e, 0x07, 0x8c, 0x60, 0x8e, 0x8a, 0x32, 0x8f, 0xb1, 0x05, 0x76,
+  0x30, 0xc4, 0x90, 0xac, 0x12, 0x39, 0xce, 0xc5, 0x9a, 0x66, 0xe6, 0x52, 0xed, 0x99, 0x59, 0xed,
+  0x69, 0x45, 0x26, 0x48, 0x24, 0xb8, 0xb4, 0xa9, 0x84, 0x35, 0x69, 0xa0, 0xa1, 0xf6, 0x63, 0xad,
+  0x74, 0xec, 0x02, 0x93, 0x82, 0xf7, 0xaf, 0x56, 0x89, 0x09, 0x30, 0x33, 0x41, 0x42, 0x80, 0x49,
+  0xc7, 0xed, 0x83, 0xbd, 0x30, 0x7d, 0xfa, 0xed, 0x85, 0xeb, 0x4f, 0xf1, 0x5e, 0xb2, 0x3f, 0xac,
+  0x87, 0xa8, 0xe1, 0x3b, 0x5e, 0xdf, 0xe2, 0xd1, 0xe7, 0x9a, 0x6f, 0xd5, 0xd2, 0xa5, 0xff, 0x86,
+  0x96, 0xf9, 0x4e, 0xf4, 0x15, 0x59, 0x7c, 0xb8, 0xaa, 0xb4, 0x82, 0xd1, 0xe7, 0xd4, 0xb0, 0x9f,
+  0x44, 0x79, 0x5c, 0x4a, 0x20, 0x0e, 0x9f, 0x44, 0xf7, 0x60, 0xd5, 0x95, 0xa8, 0x85, 0x83, 0x69,
+  0x9d, 0xc1, 0x8b, 0x7e, 0x86, 0x7f, 0x6f, 0x63, 0xc3, 0x84, 0x31, 0xbc, 0x44, 0xd2, 0x37, 0x50,
+  0xcf, 0xec, 0x15, 0x92, 0xea, 0x64, 0xf0, 0xb1, 0x43, 0x95, 0xd8, 0x6f, 0x60, 0xf2, 0x78, 0xd2,
+  0x27, 0x74, 0xeb, 0x9d, 0x56, 0xa8, 0xb5, 0x6c, 0x2e, 0x23, 0x5d, 0xe1, 0x08, 0xb5, 0x4a, 0xf2,
+  0xa5, 0xc3, 0xca, 0x94, 0xb8, 0x0e, 0xa3, 0x37, 0x95, 0xb3, 0x4b, 0x73, 0x2a, 0xc4, 0x36, 0xe9,
+  0x1e, 0x99, 0x25, 0x17, 0xc9, 0x4c, 0xde, 0x24, 0xd3, 0x58, 0xba, 0x24, 0x2d, 0xb8, 0x4b, 0x4e,
+  0xfa, 0xf0, 0x16, 0xb8, 0xd3, 0xe3, 0x9d, 0x6b, 0x78, 0x93, 0x4c, 0xec, 0xfe, 0xd1, 0x66, 0x84,
+  0xbd, 0x2a, 0x45, 0x5c, 0x11, 0xbc, 0x91, 0xa9, 0x77, 0x0e, 0x01, 0x13, 0x36, 0xc6, 0x45, 0x1c,
+  0x2b, 0x6f, 0x3e, 0xbd, 0xa4, 0x94, 0x19, 0x17, 0x26, 0x89, 0xd1, 0x61, 0xd5, 0xce, 0x21, 0xd1,
+  0xd8, 0x02, 0x27, 0x91, 0x94, 0xd5, 0x34, 0x13, 0x82, 0x6c, 0x19, 0xb3, 0x60, 0xd7, 0x8e, 0xab,
+  0xe8, 0x8d, 0x38, 0xe5, 0xff, 0x2c, 0xf5, 0xcc, 0xb9, 0xca, 0xa5, 0x04, 0x76, 0x5f, 0xd0, 0x5f,
+  0xce, 0xa6, 0xfe, 0x42, 0x67, 0x99, 0x78, 0x69, 0x13, 0x1b, 0xe9, 0xde, 0xc0, 0x12, 0xb0, 0x0d,
+  0xea, 0xf9, 0x8a, 0x76, 0x0e, 0xf1, 0x71, 0x99, 0xe3, 0xdb, 0x6f, 0x1c, 0x7c, 0xb5, 0xb9, 0xa4,
+  0x5c, 0x80, 0x7f, 0x10, 0xf4, 0x97, 0x21, 0xba, 0x53, 0xc7, 0xcc, 0x52, 0x2d, 0xbd, 0x0a, 0x57,
+  0xdb, 0x67, 0x97, 0x6a, 0x73, 0x43, 0xef, 0xcb, 0xb9, 0x04, 0x5e, 0xd0, 0xc1, 0xe9, 0x88, 0x26,
+  0x9f, 0x82, 0x3f, 0x7f, 0x2b, 0x3e, 0xb4, 0x47, 0xa5, 0x62, 0xe5, 0x6e, 0x2b, 0xdc, 0x3d, 0x4d,
+  0x4f, 0x4a, 0x3d, 0x61, 0x34, 0xe3, 0x7f, 0xf7, 0xc3, 0x85, 0x77, 0xe4, 0xc3, 0xa0, 0xcb, 0x8e,
+  0x61, 0x72, 0x33, 0x9f, 0xfc, 0x1f, 0x5e, 0xf5, 0x1c, 0x7f, 0x8a, 0x50, 0xca, 0x06, 0x98, 0x6e,
+  0x0c, 0x4b, 0x3a, 0x45, 0x75, 0xf7, 0x82, 0xda, 0x4a, 0xb0, 0xdc, 0x17, 0x7e, 0x5e, 0xa0, 0x91,
+  0x3b, 0x1e, 0x59, 0x16, 0x1b, 0x73, 0x35, 0x1e, 0xe7, 0x23, 0x63, 0xb5, 0x90, 0xdc, 0xea, 0xe9,
+  0x7d, 0x4d, 0xa9, 0x3e, 0x19, 0x39, 0x94, 0x47, 0x3f, 0x65, 0xb5, 0xe1, 0xe2, 0x57, 0x4f, 0x30,
+  0xcd, 0xc8, 0xb3, 0x1b, 0x61, 0x5b, 0x82, 0x1e, 0xde, 0x1c, 0x5f, 0x9d, 0xb8, 0x2a, 0x74, 0xa2,
+  0x9a, 0x8c, 0xbe, 0xc9, 0x2a, 0x55, 0x62, 0x22, 0x39, 0xe5, 0xa9, 0xec, 0x84, 0x05, 0x2d, 0x78,
+  0x15, 0x76, 0x98, 0xb9, 0x95, 0xbc, 0xa6, 0xf0, 0xd5, 0x49, 0x89, 0x6f, 0x0e, 0x9f, 0x45, 0x8d,
+  0x8e, 0x9c, 0x9d, 0x60, 0x24, 0x4e, 0x3d, 0x3a, 0xf2, 0xec, 0x04, 0x23, 0xd3, 0x78, 0x90, 0xc8,
+  0xdd, 0x6a, 0x24, 0x2f, 0xd3, 0x5a, 0x8d, 0xf8, 0x7d, 0xe0, 0xb2, 0x63, 0xae, 0xe3, 0x6b, 0xc1,
+  0x99, 0x79, 0x76, 0xc8, 0x8b, 0x3d, 0x06, 0x63, 0x66, 0x90, 0x74, 0x16, 0x48, 0xbf, 0x0f, 0xb7,
+  0xa3, 0xaf, 0x89, 0x94, 0x80, 0xe7, 0x33, 0x82, 0x97, 0x67, 0xd0, 0xf0, 0x05, 0xe6, 0x3c, 0x48,
+  0x3a, 0x3b, 0x5f, 0x09, 0xff, 0x03, 0x08, 0x05, 0x10, 0x43, 0x2f, 0x1b, 0x76, 0xd3, 0xa7, 0x33,
+  0x78, 0x6b, 0xdf, 0xf2, 0x06, 0x86, 0xcd, 0x84, 0xd9, 0x96, 0xf5, 0xc9, 0x79, 0x18, 0x81, 0x2d,
+  0xf0, 0xbb, 0xec, 0xe2, 0x03, 0xba, 0xa4, 0x57, 0x56, 0x4f, 0x99, 0xe1, 0x0a, 0x03, 0xce, 0xa4,
+  0xab, 0x80, 0xbd, 0x03, 0x07, 0xa2, 0xd0, 0xe8, 0x08, 0x59, 0xfa, 0x90, 0x63, 0x24, 0xee, 0x80,
+  0x94, 0x0f, 0x09, 0x0f, 0x77, 0x53, 0x60, 0xdd, 0x42, 0xfc, 0xc3, 0xfc, 0x11, 0x06, 0xcb, 0x01,
+  0x30, 0xd2, 0x36, 0x56, 0x13, 0xad, 0xbe, 0xa5, 0xcb, 0xb8, 0x1d, 0x3c, 0x53, 0xa1, 0xbc, 0xf4,
+  0xc8, 0x27, 0xba, 0x1b, 0x6b, 0xd3, 0x0a, 0x2c, 0x86, 0xcf, 0x44, 0xda, 0x1a, 0x2c, 0x43, 0x80,
+  0x2f, 0x1d, 0x2d, 0xa1, 0x34, 0x60, 0x09, 0x03, 0xa5, 0x32, 0x58, 0xcf, 0xe5, 0xdd, 0xb6, 0x36,
+  0xee, 0x39, 0xa3, 0x46, 0x32, 0x8e, 0xa0, 0x0a, 0x49, 0x7b, 0xc8, 0xdd, 0x65, 0xab, 0x61, 0xa0,
+  0xda, 0x96, 0x38, 0x74, 0xee, 0x82, 0xad, 0xa8, 0x4e, 0x1b, 0xdb, 0x1c, 0x6f, 0xb5, 0xe8, 0x49,
+  0x01, 0xce, 0xf7, 0x8b, 0xbc, 0xd7, 0x7a, 0x4c, 0x17, 0x93, 0xb7, 0xd9, 0xc8, 0x53, 0xa7, 0x23,
+  0xcc, 0x5e, 0xb4, 0xbf, 0xd4, 0xe9, 0xe5, 0xa6, 0x86, 0xf9, 0xff, 0x8d, 0xf3, 0xc7, 0x87, 0xba,
+  0xad, 0x38, 0x96, 0x61, 0x74, 0x42, 0x31, 0xf6, 0xa3, 0x7b, 0x18, 0xc1, 0xf6, 0x29, 0xd8, 0xed,
+  0x62, 0x92, 0x9f, 0x91, 0xa0, 0x11, 0xe0, 0x23, 0xd7, 0x86, 0x5c, 0x3c, 0x53, 0xac, 0xca, 0x95,
+  0x1f, 0x63, 0x72, 0x5a, 0x5f, 0x88, 0xc8, 0x9d, 0xc0, 0x9b, 0xcc, 0xce, 0xb4, 0xde, 0x29, 0xd7,
+  0xe1, 0x8b, 0x09, 0x64, 0x74, 0x16, 0x58, 0x3c, 0x82, 0x81, 0x4f, 0x28, 0xa6, 0x2b, 0x69, 0x7f,
+  0xfa, 0x00, 0x03, 0x19, 0x9c, 0xc5, 0x17, 0xb0, 0xe9, 0xcb, 0x0d, 0x0a, 0xc9, 0x32, 0x76, 0x2b,
+  0xc3, 0xa2, 0xcf, 0xb3, 0x17, 0xbd, 0x0f, 0xc0, 0x35, 0xef, 0x65, 0xa9, 0xf6, 0x92, 0xe7, 0x34,
+  0x31, 0xeb, 0xe9, 0xf8, 0x71, 0x0d, 0x9e, 0x99, 0x64, 0xf2, 0x80, 0xe1, 0x3f, 0xde, 0x7e, 0xd1,
+  0x26, 0x23, 0x23, 0xfe, 0x0c, 0xb9, 0x03, 0xd8, 0x06, 0xe4, 0x07, 0x79, 0x29, 0xd5, 0xeb, 0x73,
+  0xbf, 0xe7, 0x80, 0x2a, 0x80, 0x64, 0xb0, 0x99, 0x08, 0x2f, 0xdb, 0xa3, 0x4f, 0x11, 0x50, 0xbd,
+  0xae, 0xe0, 0x96, 0x09, 0xe7, 0xb9, 0x78, 0x13, 0x82, 0xae, 0xe3, 0xde, 0xf5, 0xe4, 0x36, 0xa0,
+  0x65, 0x2c, 0x73, 0x0b, 0xc8, 0x7f, 0x24, 0x9f, 0xba, 0x8d, 0xeb, 0x44, 0x2d, 0x95, 0x96, 0xb0,
+  0x07, 0x81, 0xcf, 0xf0, 0x4d, 0x6d, 0x9b, 0x8e, 0xb0, 0x5a, 0xfc, 0xf0, 0x38, 0x4d, 0xd4, 0x34,
+  0x06, 0x90, 0xdb, 0xe1, 0x3d, 0xc7, 0x32, 0x39, 0xa4, 0x5f, 0x09, 0x0b, 0x2d, 0xcf, 0xfa, 0x5f,
+  0x84, 0x35, 0x9b, 0xe4, 0x9f, 0x63, 0xd9, 0x9b, 0x59, 0xfe, 0x32, 0x43, 0xcb, 0xcf, 0xa0, 0x70,
+  0x4a, 0x67, 0x69, 0x28, 0xaa, 0x97, 0x5a, 0xe1, 0x80, 0xf0, 0x30, 0xf3, 0x0c, 0xe9, 0xd8, 0xb6,
+  0x88, 0x93, 0xcd, 0x13, 0xb5, 0x84, 0xca, 0xfc, 0xc5, 0xcc, 0xa0, 0x32, 0x8c, 0x63, 0x0b, 0xa3,
+  0x5c, 0xb7, 0x8d, 0xf7, 0x23, 0xb9, 0x1c, 0x56, 0xa3, 0xc1, 0xe0, 0x6d, 0xf3, 0xa9, 0xef, 0x25,
+  0x3b, 0xa8, 0x00, 0x8e, 0xb2, 0x5b, 0xf2, 0x88, 0x40, 0x44, 0xdb, 0xb3, 0xc4, 0xb1, 0x93, 0x57,
+  0xb8, 0x9a, 0x62, 0xb2, 0x6f, 0x81, 0xf5, 0xe3, 0x09, 0x8c, 0x85, 0x47, 0x97, 0xbc, 0x9d, 0x68,
+  0x6c, 0xc1, 0x22, 0x60, 0xd1, 0xed, 0x5e, 0xf4, 0x85, 0xc2, 0xd5, 0xe3, 0x16, 0xef, 0xf8, 0x31,
+  0x2b, 0x3a, 0xf4, 0x8c, 0xda, 0x3c, 0x1e, 0x85, 0xc2, 0x39, 0x14, 0x9e, 0x13, 0x9b, 0xce, 0xc0,
+  0x14, 0x80, 0x7a, 0xfb, 0x84, 0x1a, 0x37, 0x29, 0x4a, 0x49, 0x82, 0x11, 0xca, 0x59, 0xa4, 0xfc,
+  0x0c, 0xec, 0xb1, 0x43, 0x2b, 0xf0, 0xb4, 0x8c, 0xf6, 0x2c, 0x22, 0xed, 0x33, 0xe2, 0x78, 0x6b,
+  0x3c, 0xd5, 0x1b, 0x48, 0xb5, 0x45, 0x47, 0xd9, 0xdd, 0x72, 0x7e, 0xe7, 0x62, 0x7e, 0xe1, 0x2f,
+  0xe3, 0x69, 0xde, 0x44, 0x9a, 0xbd, 0xe8, 0x2e, 0xd6, 0x22, 0xc7, 0x53, 0xbd, 0x95, 0x50, 0x95,
+  0xce, 0x77, 0x5e, 0x4a, 0xb6, 0x43, 0xef, 0x67, 0x36, 0xca, 0x74, 0xf8, 0x23, 0x5a, 0x65, 0x83,
+  0x82, 0xf6, 0x2d, 0xb0, 0xe3, 0x76, 0xb9, 0x0d, 0x67, 0x9a, 0xc8, 0xf8, 0x00, 0x12, 0x94, 0x49,
+  0x88, 0x71, 0x6d, 0x30, 0x2f, 0x98, 0x80, 0x14, 0x17, 0x87, 0x62, 0x16, 0xf8, 0xf1, 0x28, 0x71,
+  0x43, 0xba, 0x48, 0xde, 0x99, 0x1e, 0xc8, 0xc2, 0xed, 0x04, 0x0e, 0x0a, 0x07, 0xe6, 0xbc, 0x4f,
+  0xc5, 0x83, 0xb5, 0x17, 0xc7, 0x9f, 0xde, 0x4b, 0x03, 0x9f, 0xfe, 0xc4, 0xc8, 0x73, 0x52, 0x68,
+  0x53, 0x94, 0x7e, 0x64, 0xe1, 0xe6, 0xc8, 0x79, 0x07, 0x01, 0x0e, 0x45, 0xfe, 0x87, 0x4a, 0xad,
+  0x67, 0x2b, 0x0e, 0xf4, 0x98, 0x19, 0x26, 0x13, 0xcb, 0x9b, 0x13, 0x4c, 0x53, 0x28, 0x41, 0x29,
+  0x01, 0xa9, 0x4c, 0x61, 0xac, 0x38, 0xf4, 0x3e, 0x20, 0xbc, 0xcb, 0xc9, 0x52, 0x10, 0x68, 0x32,
+  0xa6, 0xa3, 0x3a, 0xdd, 0xb2, 0x73, 0x3d, 0xe3, 0x2f, 0x0a, 0xc2, 0xe0, 0x0d, 0xb8, 0xb2, 0x6e,
+  0x47, 0x65, 0x41, 0xde, 0x7d, 0x9f, 0xb6, 0xe1, 0x8b, 0xb2, 0x20, 0x44, 0x7a, 0x14, 0xdd, 0x3c,
+  0x06, 0x0b, 0x82, 0xab, 0x1f, 0x8f, 0x25, 0x05, 0xe1, 0xd8, 0xc3, 0x63, 0xb1, 0x20, 0x98, 0x7b,
+  0x14, 0x6e, 0x1f, 0x83, 0x45, 0x53, 0x9a, 0x73, 0x43, 0x61, 0x31, 0x71, 0x22, 0xb2, 0x73, 0xe2,
+  0x69, 0xc8, 0xcb, 0x49, 0xc9, 0x7e, 0xcf, 0xc8, 0x4e, 0x25, 0x23, 0x7b, 0x00, 0xc1, 0x6c, 0x5b,
+  0x82, 0x53, 0x41, 0x5d, 0x5a, 0x05, 0x4c, 0x42, 0xb2, 0x7f, 0xe6, 0x2b, 0x8e, 0xf2, 0xdc, 0x8e,
+  0x07, 0x97, 0xfb, 0x49, 0xfa, 0xb5, 0x59, 0x50, 0x98, 0x44, 0x83, 0x3f, 0xcf, 0xa0, 0x20, 0x02,
+  0x94, 0x8c, 0x78, 0xbf, 0x60, 0x80, 0x86, 0xa4, 0x04, 0x1f, 0xa6, 0xdf, 0x82, 0x13, 0xcd, 0x37,
+  0xd0, 0xf6, 0x24, 0x9f, 0xbf, 0x51, 0x96, 0x37, 0x2c, 0x2b, 0x8c, 0x3e, 0xa5, 0x1c, 0xbd, 0xcf,
+  0xd4, 0x53, 0x8c, 0xcd, 0x5d, 0x51, 0x4f, 0x0a, 0xb4, 0xd9, 0xfa, 0xb4, 0x96, 0x09, 0xbc, 0x58,
+  0x15, 0xd8, 0x1a, 0xb3, 0x68, 0x26, 0x95, 0x1f, 0x92, 0x6d, 0x2b, 0xeb, 0x0e, 0xb4, 0x28, 0xbf,
+  0x6f, 0xcc, 0xdf, 0x37, 0xe6, 0x0b, 0x6f, 0xcc, 0x82, 0x62, 0x7f, 0x41, 0x3e, 0xd3, 0x88, 0x6b,
+  0x73, 0x0d, 0xf9, 0xff, 0xe8, 0xfd, 0x2f, 0x64, 0x3a, 0x33, 0x7e, 0xe9, 0x3b, 0x00, 0x00,
+};
+
+#endif
@@ -0,0 +1,26 @@
+# Code size of two builds of the same program, run by ctest:
+#
+#     cmake -DSIZE=size -DNAME=... -DBASE=<program> -DNEW=<program> -P code_size.cmake
+#
+# Prints the text size of both and fails if NEW is larger than BASE.
+# The sizes are of the host build, x86-64, not of the board.
+
+function(text_size program result)
+  execute_process(COMMAND ${SIZE} ${program} OUTPUT_VARIABLE out RESULT_VARIABLE status)
+  if(NOT status EQUAL 0)
+    message(FATAL_ERROR "${SIZE} ${program} failed")
+  endif()
+  # Berkeley format: text data bss dec hex filename
+  string(REGEX MATCH "\n *([0-9]+)" line "${out}")
+  set(${result} ${CMAKE_MATCH_1} PARENT_SCOPE)
+endfunction()
+
+text_size(${BASE} base)
+text_size(${NEW} new)
+math(EXPR saved "${base} - ${new}")
+message("  ${NAME}, base text: ${base} bytes")
+message("  ${NAME}, new text:  ${new} bytes")
+message("  ${NAME}, saved:     ${saved} bytes")
+if(new GREATER base)
+  message(FATAL_ERROR "${NAME}: the new build is larger")
+endif()
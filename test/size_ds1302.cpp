@@ -0,0 +1,29 @@
+#include "RtcDS1302.h"
+
+// The calls the sketch makes on its DS1302, once with the pins fixed at
+// compile time and once with the pins at run time. CMakeLists.txt links
+// it twice with -Os and --gc-sections, test/code_size.cmake compares the
+// code size of the two programs. Nothing here is run by the tests.
+
+#ifdef DS1302_STATIC_PINS
+static RtcDS1302T<D7, D6, D5> rtc;
+#else
+static RtcDS1302 rtc(D7, D6, D5);
+#endif
+
+int main() {
+  uint8_t ram[DS1302_RAM_SIZE];
+  DateTime dt;
+
+  rtc.begin();
+  rtc.now(dt);
+  rtc.set(dt.hour, dt.minute, dt.second, dt.year, dt.month, dt.day, dt.dow);
+  rtc.beginNow();
+  while (!rtc.poll())
+    ;
+  rtc.result(dt);
+  rtc.readRam(ram, sizeof(ram));
+  rtc.writeRam(ram, sizeof(ram));
+  rtc.writeRam((uint8_t)0, rtc.readRam(1));
+  return dt.second;
+}
@@ -0,0 +1,34 @@
+#include "RtcDS1302.h"
+#include "CachedRtc.h"
+
+// The clock calls of the sketch, once statically bound through RtcCore
+// and once the way the baseline bound them: CachedRtc behind RtcBase,
+// on top of a driver behind RtcBase. CMakeLists.txt links it twice with
+// -Os and --gc-sections, test/code_size.cmake compares the code size.
+// Nothing here is run by the tests.
+
+typedef RtcDS1302T<D7, D6, D5> RtcChip;
+
+static RtcChip chip;
+#ifdef RTC_VIRTUAL
+static RtcAdapter<RtcChip> chipBase(chip);
+static CachedRtc<RtcBase> cached(chipBase);
+static RtcAdapter<CachedRtc<RtcBase> > cachedBase(cached);
+static RtcBase& rtc = cachedBase;
+#else
+static CachedRtc<RtcChip> rtc(chip);
+#endif
+
+int main() {
+  char str[20];
+  RtcUpdate update;
+  DateTime dt;
+
+  rtc.begin();
+  rtc.now(dt);
+  update.setHour(dt.hour).setMinute(dt.minute);
+  rtc.commit(update);
+  rtc.setSecondsSince2000(rtc.getSecondsSince2000() + 1);
+  rtc.dateTimeToStr(str);
+  return str[0] + rtc.getHour();
+}
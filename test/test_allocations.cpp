@@ -0,0 +1,132 @@
+#include "HostTest.h"
+#include "SimDS1302.h"
+#include <ESP8266WebServer.h>
+#include <EEPROM.h>
+#include "RtcDS1302.h"
+#include "CachedRtc.h"
+
+// Heap allocations per request of the default build. The handlers of
+// the sketch against the String handlers of the baseline and against
+// a handler that sends a constant body, which is what send() itself
+// allocates. Counted inside the handler, the request parsing of the
+// server around it does not depend on the handler. A realloc() that
+// moves the block is not counted: whether it moves depends on the
+// heap of the host, not on the code.
+
+void setup();
+void loop();
+void getState();
+void getTime();
+void getSchedulerConfiguration();
+void getStatus();
+extern ESP8266WebServer server;
+extern CachedRtc<RtcDS1302T<D7, D6, D5> > rtc;
+
+static SimDS1302 chip(D7, D6, D5);
+
+/***
+ * Handlers of the baseline
+ */
+
+static void baselineState() {
+  if (digitalRead(D4) == LOW) server.send(200, "application/json", "{\"state\":1}");
+  else server.send(200, "application/json", "{\"state\":0}");
+}
+
+static void baselineTime() {
+  String reply = String(rtc.getHour());
+  reply += ":";
+  if (rtc.getMinute() < 10) reply += "0";
+  reply += String(rtc.getMinute());
+  server.send(200, "text", reply);
+}
+
+static void baselineScheduler() {
+  uint8_t data[5];
+  for (int i = 0; i <= 4; i++) {
+    data[i] = EEPROM.read(i);
+  }
+  String reply = "{\"startHour\":";
+  reply += String(data[0]);
+  reply += ",";
+  reply += "\"startMinute\":";
+  reply += String(data[1]);
+  reply += ",";
+  reply += "\"endHour\":";
+  reply += String(data[2]);
+  reply += ",";
+  reply += "\"endMinute\":";
+  reply += String(data[3]);
+  reply += ",";
+  reply += "\"controleSumm\":";
+  reply += String(data[4]);
+  reply += "}";
+  server.send(200, "application/json", reply);
+}
+
+static void constantBody() {
+  server.send_P(200, "application/json", "{}", 2);
+}
+
+static uint64_t handlerAllocations;
+
+static uint64_t newBlocks() {
+  HostHeapStats heap = hostHeap();
+
+  return heap.allocations - heap.moves;
+}
+
+// Runs a handler and counts its allocations, send() included
+#define COUNTED(handler) [] { \
+  uint64_t before = newBlocks(); \
+  handler(); \
+  handlerAllocations = newBlocks() - before; \
+}
+
+static uint64_t allocations(const char *target) {
+  hostHttpRequest(target);
+  loop();
+  CHECK_EQ(hostHttpResponse().code, 200);
+  return handlerAllocations;
+}
+
+static uint64_t floorAllocations;
+
+TEST(boots) {
+  chip.setTime(26 * 365 * 86400); // Some day in 2025
+  setup();
+  server.on("/new/state", COUNTED(getState));
+  server.on("/new/time/get", COUNTED(getTime));
+  server.on("/new/scheduler", COUNTED(getSchedulerConfiguration));
+  server.on("/new/api/status", COUNTED(getStatus));
+  server.on("/old/state", COUNTED(baselineState));
+  server.on("/old/time/get", COUNTED(baselineTime));
+  server.on("/old/scheduler", COUNTED(baselineScheduler));
+  server.on("/constant", COUNTED(constantBody));
+  allocations("/new/state"); // Clock sync and first-time work out of the way
+  floorAllocations = allocations("/constant");
+  MEASURE("send() of a constant body", floorAllocations, "allocations");
+}
+
+TEST(allocations_per_request) {
+  static const char *routes[] = { "/state", "/time/get", "/scheduler" };
+  char label[64];
+
+  for (uint8_t i = 0; i < 3; i++) {
+    uint64_t old = allocations((String("/old") + routes[i]).c_str());
+    uint64_t now = allocations((String("/new") + routes[i]).c_str());
+    snprintf(label, sizeof(label), "%s, baseline handler", routes[i]);
+    MEASURE(label, old, "allocations");
+    snprintf(label, sizeof(label), "%s, JsonWriter handler", routes[i]);
+    MEASURE(label, now, "allocations");
+    // The handler adds nothing to what send() allocates
+    CHECK_EQ(now, floorAllocations);
+    CHECK(old > now);
+  }
+  MEASURE("/api/status", allocations("/new/api/status"), "allocations");
+  CHECK_EQ(allocations("/new/api/status"), floorAllocations);
+  // All of it, the server's request parsing included
+  hostHttpRequest("/state");
+  loop();
+  MEASURE("/state, whole request", hostHttpResponse().allocations, "allocations");
+}
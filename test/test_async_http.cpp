@@ -0,0 +1,240 @@
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include "HostTest.h"
+#include "AsyncHttpServer.h"
+
+// AsyncHttpServer under load: 1, 4 and 8 clients on real sockets, each
+// sends its requests one after the other, while the event streams keep
+// their pcbs. The wait of a request is counted in loop() passes of 1 ms,
+// the handlers and the parsing take no time on the host.
+
+#define PORT     80
+#define SSE_PORT 81
+#define REQUESTS 20 // Per client
+#define REQUEST  "GET /state HTTP/1.1\r\nHost: esp\r\n\r\n"
+#define BODY     "{\"state\":1}"
+
+static AsyncHttpServer server(PORT);
+static SseServer events(SSE_PORT);
+
+static void handleState() {
+  server.send(200, "application/json", BODY);
+}
+
+struct Client {
+  int fd;
+  uint32_t done;    // Complete responses
+  bool waiting;     // For a response
+  uint32_t sent;    // millis() the request went out
+  char buf[512];
+  size_t len;
+};
+
+struct Load {
+  uint32_t requests;
+  uint32_t resets;  // Connections reset or closed before the response
+  uint32_t connects;
+  uint32_t worstMs; // Longest wait for a response
+  uint64_t totalMs;
+  uint32_t elapsedMs;
+  uint8_t maxServed;
+  uint8_t maxPending;
+};
+
+static void disconnect(Client& c) {
+  close(c.fd);
+  c.fd = -1;
+  c.waiting = false;
+  c.len = 0;
+}
+
+// One step of a client: connect, send the next request or read the response
+static void step(Client& c, Load& load) {
+  ssize_t n;
+  char *end;
+
+  if (c.fd < 0) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(hostTcpPort(PORT));
+    c.fd = socket(AF_INET, SOCK_STREAM, 0);
+    // The kernel completes the handshake, lwIP takes the connection when it has a pcb
+    CHECK(connect(c.fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+    fcntl(c.fd, F_SETFL, fcntl(c.fd, F_GETFL) | O_NONBLOCK);
+    load.connects++;
+  }
+  if (!c.waiting) {
+    CHECK_EQ(send(c.fd, REQUEST, strlen(REQUEST), MSG_NOSIGNAL), strlen(REQUEST));
+    c.waiting = true;
+    c.sent = millis();
+    return;
+  }
+  n = recv(c.fd, c.buf + c.len, sizeof(c.buf) - 1 - c.len, 0);
+  if ((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+    return;
+  if (n <= 0) {
+    load.resets++;
+    disconnect(c);
+    return;
+  }
+  c.len += n;
+  c.buf[c.len] = 0;
+  end = strstr(c.buf, "\r\n\r\n");
+  if (!end || (strlen(end + 4) < strlen(BODY)))
+    return;
+  CHECK(!strncmp(c.buf, "HTTP/1.1 200 OK\r\n", 17));
+  CHECK_STR(end + 4, BODY);
+  load.requests++;
+  load.totalMs += millis() - c.sent;
+  load.worstMs = max(load.worstMs, (uint32_t)(millis() - c.sent));
+  // Done, or the server asked to connect again
+  if ((++c.done == REQUESTS) || strstr(c.buf, "Connection: close"))
+    disconnect(c);
+  c.waiting = false;
+  c.len = 0;
+}
+
+static Load run(uint8_t clients) {
+  Client c[8];
+  Load load;
+  uint32_t start = millis();
+  uint32_t killed = hostTcpKilled();
+  bool busy = true;
+
+  memset(&load, 0, sizeof(load));
+  for (uint8_t i = 0; i < clients; i++) {
+    c[i].fd = -1;
+    c[i].done = 0;
+    c[i].waiting = false;
+    c[i].len = 0;
+  }
+  while (busy && (millis() - start < 60000UL)) {
+    busy = false;
+    for (uint8_t i = 0; i < clients; i++) {
+      if (c[i].done < REQUESTS) {
+        step(c[i], load);
+        busy = true;
+      }
+    }
+    // One loop() pass
+    hostYield();
+    load.maxServed = max(load.maxServed, server.count());
+    load.maxPending = max(load.maxPending, server.pending());
+    server.handleClient();
+    events.handle();
+    hostAdvanceMillis(1);
+  }
+  load.elapsedMs = millis() - start;
+  // Closed clients leave the server within a few passes
+  for (uint8_t i = 0; i < 10; i++) {
+    hostYield();
+    server.handleClient();
+    hostAdvanceMillis(1);
+  }
+  CHECK_EQ(hostTcpKilled(), killed);
+  return load;
+}
+
+static void report(const char *name, const Load& load) {
+  char label[64];
+
+  snprintf(label, sizeof(label), "%s, requests per second", name);
+  MEASURE(label, 1000.0 * load.requests / load.elapsedMs, "");
+  snprintf(label, sizeof(label), "%s, mean wait", name);
+  MEASURE(label, (double)load.totalMs / load.requests, "ms");
+  snprintf(label, sizeof(label), "%s, worst wait", name);
+  MEASURE(label, load.worstMs, "ms");
+  snprintf(label, sizeof(label), "%s, connections", name);
+  MEASURE(label, load.connects, "");
+  snprintf(label, sizeof(label), "%s, most parked", name);
+  MEASURE(label, load.maxPending, "");
+}
+
+TEST(one_four_and_eight_clients) {
+  static const uint8_t clients[] = { 1, 4, 8 };
+
+  server.on("/state", handleState);
+  server.begin();
+  for (uint8_t i = 0; i < sizeof(clients); i++) {
+    char name[16];
+    Load load = run(clients[i]);
+    snprintf(name, sizeof(name), "%u clients", clients[i]);
+    report(name, load);
+    CHECK_EQ(load.requests, clients[i] * REQUESTS);
+    CHECK_EQ(load.resets, 0);
+    CHECK(load.maxServed <= ASYNC_HTTP_MAX_CONNECTIONS);
+    CHECK(load.maxPending <= ASYNC_HTTP_MAX_PENDING);
+    CHECK_EQ(server.count() + server.pending(), 0);
+    // Below the connections a client keeps its connection
+    if (clients[i] <= ASYNC_HTTP_MAX_CONNECTIONS)
+      CHECK_EQ(load.connects, clients[i]);
+  }
+}
+
+TEST(event_streams_keep_their_pcbs) {
+  HostPeer streams[SSE_MAX_CLIENTS];
+
+  events.begin();
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    CHECK(streams[i].connect(SSE_PORT));
+    streams[i].send("GET /events HTTP/1.1\r\n\r\n");
+    events.handle();
+    events.handle();
+  }
+  CHECK_EQ(events.count(), SSE_MAX_CLIENTS);
+  // The pool is full with the HTTP connections, no client is parked
+  // and a new SYN does not kill a stream
+  Load load = run(8);
+  report("8 clients, 2 streams", load);
+  CHECK_EQ(load.requests, 8 * REQUESTS);
+  CHECK_EQ(load.resets, 0);
+  CHECK_EQ(load.maxPending, 0);
+  CHECK_EQ(load.maxServed, ASYNC_HTTP_MAX_CONNECTIONS);
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++)
+    CHECK(streams[i].connected());
+  CHECK_EQ(events.count(), SSE_MAX_CLIENTS);
+}
+
+// A client that sends its requests and closes its side at once, as
+// "printf ... | nc" does, gets every response before the close
+TEST(half_close_gets_its_responses) {
+  const char *pipelined = REQUEST REQUEST;
+  char buf[512];
+  size_t len = 0;
+  ssize_t n = 1;
+  struct sockaddr_in addr;
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(hostTcpPort(PORT));
+  CHECK(connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  CHECK_EQ(send(fd, pipelined, strlen(pipelined), MSG_NOSIGNAL), strlen(pipelined));
+  CHECK(shutdown(fd, SHUT_WR) == 0);
+  for (uint16_t i = 0; (i < 1000) && n; i++) {
+    hostYield();
+    server.handleClient();
+    hostAdvanceMillis(1);
+    n = recv(fd, buf + len, sizeof(buf) - 1 - len, 0);
+    if (n > 0)
+      len += n;
+    else if ((n < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
+      break;
+  }
+  close(fd);
+  buf[len] = 0;
+  // Both answered, then the server closed
+  CHECK_EQ(n, 0);
+  CHECK(!strncmp(buf, "HTTP/1.1 200 OK\r\n", 17));
+  CHECK(strstr(buf, BODY "HTTP/1.1 200 OK\r\n"));
+  CHECK(!strcmp(buf + len - strlen(BODY), BODY));
+  CHECK_EQ(server.count(), 0);
+}
@@ -0,0 +1,127 @@
+#include "HostTest.h"
+#include "SimDS1302.h"
+#include "SimI2cRtc.h"
+#include "RtcDS1302.h"
+#include "RtcDS3231.h"
+#include "CachedRtc.h"
+
+// CachedRtc against reading the chip for every query: chip
+// transactions and time per query for the pattern of the sketch,
+// a clock query on every loop() pass
+
+#define QUERY_MS      10  // loop() pass
+#define QUERY_MINUTES 10
+#define START         (26 * 365 * SECONDS_PER_DAY) // Some day in 2025
+
+struct Run {
+  uint32_t queries;
+  uint32_t transactions;
+  uint64_t cycles;  // Spent in the queries
+  uint32_t maxLag;  // Largest chip time before the query minus the answer, s
+  uint32_t ahead;   // Answers ahead of the chip after the query
+};
+
+// Queries every QUERY_MS for QUERY_MINUTES, 'transactions' reads the chip's counter
+template <class Clock, class Counter>
+static Run run(Clock& clock, Counter transactions, uint32_t (*chipTime)()) {
+  Run r;
+  uint32_t before = transactions();
+
+  memset(&r, 0, sizeof(r));
+  for (uint32_t ms = 0; ms < QUERY_MINUTES * 60000UL; ms += QUERY_MS) {
+    uint64_t start = hostCycles();
+    uint32_t before = chipTime();
+    uint32_t t = clock.getSecondsSince2000();
+    r.cycles += hostCycles() - start;
+    r.queries++;
+    if (t > chipTime())
+      r.ahead++;
+    else if (t < before)
+      r.maxLag = max(r.maxLag, before - t);
+    hostAdvanceMillis(QUERY_MS - (hostCycles() - start) / (HOST_CYCLES_PER_US * 1000));
+  }
+  r.transactions = transactions() - before;
+  return r;
+}
+
+static void report(const char *name, const Run& r) {
+  char label[64];
+
+  snprintf(label, sizeof(label), "%s transactions per 1000 queries", name);
+  MEASURE(label, 1000.0 * r.transactions / r.queries, "");
+  // Bus time only, the code around it does not take time on the host
+  snprintf(label, sizeof(label), "%s time per query", name);
+  MEASURE(label, (double)r.cycles / r.queries / HOST_CYCLES_PER_US, "us");
+}
+
+static SimDS1302 *ds1302;
+static SimI2cRtc *ds3231;
+
+static uint32_t ds1302Sessions() { return ds1302->stats().sessions; }
+static uint32_t ds1302Time() { return ds1302->time(); }
+static uint32_t i2cTransactions() { return hostI2cStats().transactions; }
+static uint32_t ds3231Time() { return ds3231->time(); }
+
+TEST(ds1302_cached_vs_direct) {
+  SimDS1302 chip(D7, D6, D5);
+  RtcDS1302T<D7, D6, D5> rtc;
+  CachedRtc<RtcDS1302T<D7, D6, D5> > cached(rtc);
+
+  ds1302 = &chip;
+  chip.setTime(START);
+  cached.begin();
+  Run direct = run(rtc, ds1302Sessions, ds1302Time);
+  Run soft = run(cached, ds1302Sessions, ds1302Time);
+  report("DS1302 direct", direct);
+  report("DS1302 cached", soft);
+  CHECK_EQ(direct.transactions, direct.queries);
+  CHECK_EQ(direct.maxLag, 0);
+  CHECK_EQ(direct.ahead, 0);
+  // One burst read a minute, the first query included
+  CHECK(soft.transactions <= QUERY_MINUTES + 1);
+  CHECK(soft.maxLag <= CACHEDRTC_MAX_DRIFT);
+  CHECK_EQ(soft.ahead, 0);
+  CHECK(soft.cycles * 100 < direct.cycles);
+  CHECK_EQ(chip.stats().violations, 0);
+}
+
+TEST(ds3231_cached_vs_direct) {
+  SimI2cRtc chip(SimI2cRtc::DS3231);
+  RtcDS3231 rtc;
+  CachedRtc<RtcDS3231> cached(rtc);
+
+  ds3231 = &chip;
+  chip.setTime(START);
+  cached.begin();
+  Run direct = run(rtc, i2cTransactions, ds3231Time);
+  Run soft = run(cached, i2cTransactions, ds3231Time);
+  report("DS3231 direct", direct);
+  report("DS3231 cached", soft);
+  // Register pointer, then the 7 clock registers
+  CHECK_EQ(direct.transactions, 2 * direct.queries);
+  CHECK_EQ(direct.maxLag, 0);
+  CHECK(soft.transactions <= 2 * (QUERY_MINUTES + 1));
+  CHECK(soft.maxLag <= CACHEDRTC_MAX_DRIFT);
+  CHECK_EQ(soft.ahead, 0);
+  CHECK(soft.cycles * 100 < direct.cycles);
+}
+
+TEST(fast_chip_shortens_the_interval) {
+  SimI2cRtc chip(SimI2cRtc::DS3231);
+  RtcDS3231 rtc;
+  CachedRtc<RtcDS3231> cached(rtc);
+
+  ds3231 = &chip;
+  chip.setTime(START);
+  chip.setDrift(50000); // 3 s a minute
+  cached.begin();
+  Run soft = run(cached, i2cTransactions, ds3231Time);
+  report("DS3231 5% fast, cached", soft);
+  MEASURE("DS3231 5% fast, largest lag", soft.maxLag, "s");
+  // The interval halves until the drift stays within CACHEDRTC_MAX_DRIFT,
+  // the worst lag is at the end of the first, full interval
+  CHECK(soft.transactions > 2 * (QUERY_MINUTES + 1));
+  CHECK(soft.transactions <= 2 * (QUERY_MINUTES * 60000UL / CACHEDRTC_MIN_INTERVAL + 1));
+  CHECK(soft.maxLag <= CACHEDRTC_SYNC_INTERVAL / 1000 * 5 / 100 + 1);
+  CHECK_EQ(soft.ahead, 0);
+}
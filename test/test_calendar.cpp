@@ -0,0 +1,132 @@
+#include <time.h>
+#include <chrono>
+#include "HostTest.h"
+#include "Rtc.h"
+
+// daysFromCivil()/civilFromDays() against gmtime() over the whole
+// uint32_t seconds range, and against the loops they replaced
+
+#define LAST_DAY (0xFFFFFFFFUL / SECONDS_PER_DAY) // 2136-02-07
+
+/***
+ * The conversions of the baseline Rtc.cpp, the reference for the benchmark
+ */
+
+static const uint8_t daysInMonth[] PROGMEM = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+static uint16_t date2days(uint16_t y, uint8_t m, uint8_t d) {
+  if (y >= 2000)
+    y -= 2000;
+  uint16_t days = d;
+  for (uint8_t i = 1; i < m; ++i)
+    days += pgm_read_byte(daysInMonth + i - 1);
+  if ((m > 2) && (y % 4 == 0))
+    ++days;
+
+  return days + 365 * y + (y + 3) / 4 - 1;
+}
+
+static void days2date(uint16_t days, uint16_t& year, uint8_t& month, uint8_t& day) {
+  uint8_t leap;
+  for (year = 2000; ; ++year) {
+    leap = year % 4 == 0;
+    if (days < 365 + leap)
+      break;
+    days -= 365 + leap;
+  }
+  for (month = 1; ; ++month) {
+    uint8_t daysPerMonth = pgm_read_byte(daysInMonth + month - 1);
+    if (leap && (month == 2))
+      ++daysPerMonth;
+    if (days < daysPerMonth)
+      break;
+    days -= daysPerMonth;
+  }
+  day = days + 1;
+}
+
+static double nsSince(std::chrono::steady_clock::time_point start, uint32_t n) {
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+}
+
+TEST(every_day_matches_gmtime) {
+  for (uint32_t days = 0; days <= LAST_DAY; days++) {
+    time_t t = EPOCH_TIME_OFF + (time_t)days * SECONDS_PER_DAY;
+    struct tm tm;
+    DateTime dt = civilFromDays(days);
+    gmtime_r(&t, &tm);
+    CHECK_EQ(dt.year, tm.tm_year + 1900);
+    CHECK_EQ(dt.month, tm.tm_mon + 1);
+    CHECK_EQ(dt.day, tm.tm_mday);
+    CHECK_EQ(dt.dow, tm.tm_wday + 1);
+    CHECK_EQ(daysFromCivil(dt.year, dt.month, dt.day), days);
+  }
+}
+
+TEST(seconds_round_trip) {
+  // A prime step walks through every second of the day over the range
+  for (uint64_t t = 0; t <= 0xFFFFFFFFUL; t += 3607) {
+    DateTime dt;
+    time_t epoch = EPOCH_TIME_OFF + t;
+    struct tm tm;
+    fromSecondsSince2000(t, dt);
+    gmtime_r(&epoch, &tm);
+    CHECK_EQ(dt.hour, tm.tm_hour);
+    CHECK_EQ(dt.minute, tm.tm_min);
+    CHECK_EQ(dt.second, tm.tm_sec);
+    CHECK_EQ(toSecondsSince2000(dt), t);
+  }
+}
+
+TEST(same_as_the_old_loops) {
+  // The loops knew no 100 year rule, they were right up to 2099
+  for (uint16_t days = 0; days < daysFromCivil(2100, 1, 1); days++) {
+    uint16_t year;
+    uint8_t month, day;
+    DateTime dt = civilFromDays(days);
+    days2date(days, year, month, day);
+    CHECK_EQ(dt.year, year);
+    CHECK_EQ(dt.month, month);
+    CHECK_EQ(dt.day, day);
+    CHECK_EQ(daysFromCivil(year, month, day), date2days(year, month, day));
+  }
+}
+
+TEST(benchmark) {
+  const uint32_t n = 2000000;
+  const uint16_t span = daysFromCivil(2100, 1, 1);
+  volatile uint32_t sink = 0;
+  std::chrono::steady_clock::time_point start;
+  double oldTo, newTo, oldFrom, newFrom;
+
+  // Host CPU time, the ratio is what carries over to the board
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++) {
+    uint16_t year;
+    uint8_t month, day;
+    days2date(i * 7919 % span, year, month, day);
+    sink = sink + year + month + day;
+  }
+  oldFrom = nsSince(start, n);
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++) {
+    DateTime dt = civilFromDays(i * 7919 % span);
+    sink = sink + dt.year + dt.month + dt.day;
+  }
+  newFrom = nsSince(start, n);
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++)
+    sink = sink + date2days(2000 + i % 100, i % 12 + 1, i % 28 + 1);
+  oldTo = nsSince(start, n);
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++)
+    sink = sink + daysFromCivil(2000 + i % 100, i % 12 + 1, i % 28 + 1);
+  newTo = nsSince(start, n);
+  (void)sink;
+
+  MEASURE("days to date, year and month loops", oldFrom, "ns");
+  MEASURE("days to date, civilFromDays()", newFrom, "ns");
+  MEASURE("date to days, month loop", oldTo, "ns");
+  MEASURE("date to days, daysFromCivil()", newTo, "ns");
+  CHECK(newFrom < oldFrom);
+}
@@ -0,0 +1,125 @@
+#include "HostTest.h"
+#include "DayPlan.h"
+
+// DayPlan against plain references, minute by minute: intervals, the
+// weekly table on every day of the week, both or-ed as the sketch does,
+// and next() at every minute of each plan
+
+static uint32_t seed = 1;
+
+static uint32_t random32() {
+  seed = seed * 1103515245UL + 12345;
+  return seed >> 8;
+}
+
+// The interval of setInterval(), over midnight if to < from
+static bool inInterval(uint16_t from, uint16_t to, uint16_t minute) {
+  if ((from >= MINUTES_PER_DAY) || (to > MINUTES_PER_DAY))
+    return false;
+  if (to >= from)
+    return (minute >= from) && (minute < to);
+  return (minute >= from) || (minute < to);
+}
+
+// The action of the last entry at or before the minute of the week,
+// before the first one that of the last entry, off without entries
+static bool tableState(Schedule& table, uint16_t minute) {
+  bool on = table.count() && (table[table.count() - 1] & SCHEDULE_ON);
+
+  for (uint16_t i = 0; i < table.count(); i++) {
+    if ((table[i] & SCHEDULE_MINUTE) <= minute)
+      on = table[i] & SCHEDULE_ON;
+  }
+  return on;
+}
+
+// next() against a scan of get()
+static void checkNext(DayPlan& plan) {
+  uint16_t change = MINUTES_PER_DAY;
+
+  for (int m = MINUTES_PER_DAY - 1; m >= 0; m--) {
+    CHECK_EQ(plan.next(m), change);
+    if (m && (plan.get(m - 1) != plan.get(m)))
+      change = m;
+  }
+}
+
+TEST(every_interval_near_the_byte_edges) {
+  // All pairs of a set of minutes around byte edges, midnight and the end of the day
+  static const uint16_t edges[] = { 0, 1, 6, 7, 8, 9, 15, 16, 17, 23, 24, 25, 63, 64, 65, 719, 720, 721, 1431, 1432, 1433, 1438, 1439, 1440, 1441 };
+  const uint8_t n = sizeof(edges) / sizeof(edges[0]);
+  DayPlan plan;
+
+  for (uint8_t a = 0; a < n; a++) {
+    for (uint8_t b = 0; b < n; b++) {
+      plan.clear();
+      plan.setInterval(edges[a], edges[b]);
+      for (uint16_t m = 0; m < MINUTES_PER_DAY; m++)
+        CHECK_EQ(plan.get(m), inInterval(edges[a], edges[b], m));
+      checkNext(plan);
+    }
+  }
+}
+
+TEST(random_interval_lists) {
+  uint16_t intervals[6][2];
+  DayPlan plan;
+
+  for (uint16_t run = 0; run < 2000; run++) {
+    uint8_t count = random32() % 7;
+    for (uint8_t i = 0; i < count; i++) {
+      intervals[i][0] = random32() % (MINUTES_PER_DAY + 1);
+      intervals[i][1] = random32() % (MINUTES_PER_DAY + 1);
+    }
+    plan.setInterval(0, MINUTES_PER_DAY); // compile() clears it first
+    plan.compile(intervals, count);
+    for (uint16_t m = 0; m < MINUTES_PER_DAY; m++) {
+      bool on = false;
+      for (uint8_t i = 0; i < count; i++)
+        on = on || inInterval(intervals[i][0], intervals[i][1], m);
+      CHECK_EQ(plan.get(m), on);
+    }
+    checkNext(plan);
+  }
+}
+
+// Every minute of the week: the plan of its day, the table and the on/off pair or-ed
+static void checkWeek(Schedule& table, uint16_t from, uint16_t to) {
+  DayPlan plan;
+
+  for (uint8_t day = 0; day < 7; day++) {
+    plan.clear();
+    plan.compile(table, day);
+    plan.setInterval(from, to);
+    for (uint16_t m = 0; m < MINUTES_PER_DAY; m++)
+      CHECK_EQ(plan.get(m), tableState(table, day * MINUTES_PER_DAY + m) || inInterval(from, to, m));
+    checkNext(plan);
+  }
+}
+
+TEST(every_minute_of_the_week) {
+  Schedule table;
+
+  // Empty, one entry, entries on the edges of days and of the week
+  checkWeek(table, 0, 0);
+  checkWeek(table, 22 * 60, 6 * 60);
+  table.add(Schedule::minuteOfWeek(3, 12, 0), true);
+  checkWeek(table, 0, 0);
+  table.add(0, false);
+  table.add(MINUTES_PER_WEEK - 1, true);
+  table.add(Schedule::minuteOfWeek(1, 0, 0), true);
+  table.add(Schedule::minuteOfWeek(1, 23, 59), false);
+  checkWeek(table, 0, 0);
+  checkWeek(table, 23 * 60, 60);
+  // Random tables up to 40 entries, with and without a pair
+  for (uint16_t run = 0; run < 300; run++) {
+    uint8_t count = random32() % 41;
+    table.clear();
+    for (uint8_t i = 0; i < count; i++)
+      table.add(random32() % MINUTES_PER_WEEK, random32() & 1);
+    if (run & 1)
+      checkWeek(table, random32() % MINUTES_PER_DAY, random32() % MINUTES_PER_DAY);
+    else
+      checkWeek(table, 0, 0);
+  }
+}
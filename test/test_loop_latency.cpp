@@ -0,0 +1,114 @@
+#include "HostTest.h"
+#include "SimDS1302.h"
+#include "RtcDS1302.h"
+#include "CachedRtc.h"
+
+// Worst loop() pass of the default build while the software clock
+// resyncs from the DS1302, with the incremental reads of pollClock()
+// and with CachedRtc reading the whole burst inside a clock query.
+// Only bus time is simulated, the code of a pass takes no time here,
+// so a pass is as long as the chip transactions in it.
+
+#define PASS_MS 1 // Time between loop() passes
+#define MINUTES 10
+// Clock burst read, see test_ds1302.cpp
+#define DATASHEET_BURST_US (8 * 2.2 - 1.0 + 64 * 2.0 + 4.0 + 4.0)
+
+void setup();
+void loop();
+extern CachedRtc<RtcDS1302T<D7, D6, D5> > rtc;
+extern uint32_t timerDue, timerLateMs, timerLateMaxMs;
+
+static SimDS1302 chip(D7, D6, D5);
+
+struct Passes {
+  uint32_t passes;
+  uint32_t syncs;
+  double maxUs;
+  double meanUs;
+};
+
+static Passes run() {
+  uint32_t syncs = rtc.getSyncCount();
+  uint64_t total = 0, worst = 0;
+  Passes p;
+
+  memset(&p, 0, sizeof(p));
+  for (uint32_t ms = 0; ms < MINUTES * 60000UL; ms += PASS_MS) {
+    uint64_t start = hostCycles();
+    loop();
+    uint64_t cycles = hostCycles() - start;
+    total += cycles;
+    worst = max(worst, cycles);
+    p.passes++;
+    hostAdvanceMillis(PASS_MS);
+  }
+  p.syncs = rtc.getSyncCount() - syncs;
+  p.maxUs = (double)worst / HOST_CYCLES_PER_US;
+  p.meanUs = (double)total / p.passes / HOST_CYCLES_PER_US;
+  return p;
+}
+
+static Passes async, blocking;
+
+TEST(boots) {
+  chip.setTime(26 * 365 * 86400); // Some day in 2025
+  setup();
+  loop(); // The first sync and the scheduler run of the boot
+  CHECK(strstr(hostSerialOutput(), "HTTP server started"));
+}
+
+TEST(incremental_reads) {
+  async = run();
+  MEASURE("incremental reads, worst pass", async.maxUs, "us");
+  MEASURE("incremental reads, mean pass", async.meanUs, "us");
+  MEASURE("incremental reads, syncs", async.syncs, "");
+  CHECK(async.syncs >= MINUTES - 1); // The boot may have taken the first one
+  // One slice of DS1302_ASYNC_BITS bits, never the whole burst
+  CHECK(async.maxUs < DATASHEET_BURST_US / 2);
+  CHECK_EQ(chip.stats().violations, 0);
+}
+
+TEST(blocking_reads) {
+  // CachedRtc resyncs by itself in the first clock query after the
+  // interval. pollClock() still opens its read in the same pass, the
+  // blocking burst cancels it after the first slice.
+  rtc.setAutoSync(true);
+  blocking = run();
+  rtc.setAutoSync(false);
+  MEASURE("blocking reads, worst pass", blocking.maxUs, "us");
+  MEASURE("blocking reads, mean pass", blocking.meanUs, "us");
+  MEASURE("blocking reads, syncs", blocking.syncs, "");
+  MEASURE("worst pass, blocking / incremental", blocking.maxUs / async.maxUs, "");
+  CHECK(blocking.syncs >= MINUTES);
+  CHECK(blocking.maxUs >= DATASHEET_BURST_US);
+  CHECK(async.maxUs * 3 < blocking.maxUs);
+  CHECK_EQ(chip.stats().violations, 0);
+}
+
+// The pass before the transition timer falls due runs for stallMs,
+// the next one takes the timer. Returns timerLateMs.
+static uint32_t takeTimer(uint32_t stallMs) {
+  hostYield();
+  loop();
+  hostAdvanceMillis(timerDue - millis() - 1);
+  loop();
+  hostAdvanceMillis(stallMs);
+  hostYield(); // Ticker fires
+  loop();
+  return timerLateMs;
+}
+
+TEST(timer_lateness) {
+  CHECK_EQ(takeTimer(1), 0);
+  CHECK_EQ(takeTimer(51), 50);
+  CHECK_EQ(takeTimer(1), 0);
+  CHECK_EQ(timerLateMaxMs, 50);
+  hostSerialClear();
+  hostSerialInput("loop\n");
+  loop();
+  CHECK(strstr(hostSerialOutput(), "timer late 0 ms, max 50 ms"));
+  hostSerialInput("loop reset\n");
+  loop();
+  CHECK_EQ(timerLateMaxMs, 0);
+}
@@ -0,0 +1,173 @@
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include "HostTest.h"
+#include "SimDS1302.h"
+#include "Metrics.h"
+#include "AsyncHttpServer.h"
+
+// /metrics of the USE_ASYNC_HTTP build, scraped on a real socket after
+// every route has been hit. The histograms go out one per loop() pass
+// as chunks, the body must end with the last gauge.
+
+void setup();
+void loop();
+extern Metrics metrics;
+
+static SimDS1302 chip(D7, D6, D5);
+static int fd = -1;
+
+// Every route of setup(), with arguments where it takes them
+static const char *const routes[] = {
+  "/",
+  "/switch",
+  "/state",
+  "/config/scheduler?startHour=8&startMinute=0&endHour=9&endMinute=0",
+  "/scheduler",
+  "/time/get",
+  "/time/set?year=2026&month=10&day=16&hour=12&minute=0",
+  "/api/status",
+  "/metrics",
+  "/api/loop",
+  "/api/schedule",
+  "/api/schedule/add?day=1&hour=7&minute=30&on=1",
+  "/api/schedule/remove?day=1&hour=7&minute=30",
+  "/api/schedule/clear",
+  "/api/rules",
+  "/api/rules/add?days=62&startHour=8&startMinute=0&endHour=18&endMinute=0",
+  "/api/rules/remove?index=0",
+  "/api/exceptions/add?year=2026&month=12&day=31",
+  "/api/exceptions/remove?index=0",
+};
+
+struct Response {
+  int code;
+  bool chunked;
+  uint32_t chunks;
+  uint32_t largest; // chunk
+  String body;
+};
+
+// Takes what the socket has, false once it is closed
+static bool receive(String& in) {
+  char buf[512];
+  ssize_t n = recv(fd, buf, sizeof(buf), 0);
+
+  if ((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+    return true;
+  if (n <= 0)
+    return false;
+  in.concat(buf, n); // the gzipped page has NULs
+  return true;
+}
+
+// The body of a complete response at the start of 'in', chunks decoded.
+// False while it is not all there.
+static bool parse(const String& in, Response& r) {
+  const char *start = in.c_str();
+  const char *end = strstr(start, "\r\n\r\n");
+  const char *stop = start + in.length();
+  const char *p;
+
+  if (!end)
+    return false;
+  r.code = atoi(start + 9);
+  r.chunked = strstr(start, "Transfer-Encoding: chunked\r\n") && (strstr(start, "Transfer-Encoding") < end);
+  r.chunks = 0;
+  r.largest = 0;
+  r.body = "";
+  p = end + 4;
+  if (!r.chunked) {
+    const char *length = strstr(start, "Content-Length: ");
+    if (!length || (length > end) || (stop - p < atoi(length + 16)))
+      return false;
+    r.body = in.substring(p - start, p - start + atoi(length + 16));
+    return true;
+  }
+  for (;;) {
+    char *text;
+    unsigned long size = strtoul(p, &text, 16);
+    if ((text == p) || strncmp(text, "\r\n", 2) || ((unsigned long)(stop - text - 2) < size + 2))
+      return false;
+    if (!size)
+      return true;
+    r.body += in.substring(text + 2 - start, text + 2 - start + size);
+    r.chunks++;
+    r.largest = max(r.largest, (uint32_t)size);
+    p = text + 2 + size + 2;
+  }
+}
+
+// One request on the kept connection
+static Response get(const char *target) {
+  String request = String("GET ") + target + " HTTP/1.1\r\nHost: esp\r\n\r\n";
+  String in;
+  Response r;
+
+  CHECK_EQ(send(fd, request.c_str(), request.length(), MSG_NOSIGNAL), request.length());
+  r.code = 0;
+  for (uint16_t i = 0; i < 1000; i++) {
+    hostYield();
+    loop();
+    hostAdvanceMillis(1);
+    CHECK(receive(in));
+    if (parse(in, r))
+      return r;
+  }
+  r.code = 0;
+  return r;
+}
+
+TEST(boots) {
+  struct sockaddr_in addr;
+
+  chip.setTime(26 * 365 * 86400); // Some day in 2025
+  setup();
+  CHECK(strstr(hostSerialOutput(), "HTTP server started"));
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(hostTcpPort(80));
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  CHECK(connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+TEST(every_route_answers) {
+  for (uint8_t pass = 0; pass < 3; pass++) {
+    for (uint8_t i = 0; i < sizeof(routes) / sizeof(routes[0]); i++) {
+      Response r = get(routes[i]);
+      CHECK(r.code >= 200);
+    }
+  }
+}
+
+TEST(scrape_ends_with_the_last_gauge) {
+  Response r;
+  int end;
+
+  r = get("/metrics");
+  CHECK_EQ(r.code, 200);
+  CHECK(r.chunked);
+  MEASURE("/metrics body", r.body.length(), "bytes");
+  MEASURE("/metrics chunks", r.chunks, "");
+  MEASURE("/metrics largest chunk", r.largest, "bytes");
+  // One histogram per chunk, then the counters and gauges
+  CHECK_EQ(r.chunks, metrics.count() + 1);
+  CHECK(r.largest < ASYNC_HTTP_MAX_BODY);
+  CHECK(r.largest * 4 < r.body.length());
+  // Every hot route has its histogram
+  CHECK(r.body.indexOf("wifipower_http_handler_seconds_count{route=\"/\"} ") >= 0);
+  CHECK(r.body.indexOf("wifipower_http_handler_seconds_count{route=\"/api/status\"} 3\n") >= 0);
+  CHECK(r.body.indexOf("wifipower_handle_client_seconds_count ") >= 0);
+  // The last line is the last gauge, whole
+  CHECK(r.body.endsWith("\n"));
+  end = r.body.substring(0, r.body.length() - 1).lastIndexOf('\n');
+  CHECK(r.body.substring(end + 1).startsWith("wifipower_uptime_seconds "));
+  // The connection is still good
+  CHECK_EQ(get("/state").code, 200);
+  close(fd);
+}
@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include "HostTest.h"
+#include "SimDS1302.h"
+#include <ESP8266WebServer.h>
+#include <FS.h>
+#include "index_htm.h"
+
+// Peak heap of a main page request in the USE_SPIFFS_PAGE build:
+// the baseline handler, which read the file into a String, against
+// streamFile() for the plain and the gzipped file and the 304
+
+void setup();
+void loop();
+extern ESP8266WebServer server;
+
+static SimDS1302 chip(D7, D6, D5);
+static size_t pageSize;
+
+static void baselineRoot() { // handleRoot() of the baseline
+  String mainPage;
+  File f = SPIFFS.open("/index.htm", "r");
+  mainPage = f.readString();
+  server.send(200, "text/html", mainPage);
+}
+
+static const HostHttpResponse& get(const char *target, const char *headers = NULL) {
+  hostHttpRequest(target, headers);
+  loop();
+  return hostHttpResponse();
+}
+
+TEST(boots_with_the_page_in_spiffs) {
+  static char page[32768];
+  FILE *f = fopen(DATA_DIR "/index.htm", "rb");
+
+  CHECK(f != NULL);
+  pageSize = fread(page, 1, sizeof(page), f);
+  fclose(f);
+  hostFsWrite("/index.htm", page, pageSize);
+  hostFsWrite("/index.htm.gz", INDEX_HTM_GZ, INDEX_HTM_GZ_LEN);
+  chip.setTime(26 * 365 * 86400); // Some day in 2025
+  setup();
+  server.on("/baseline", baselineRoot);
+  MEASURE("page size", pageSize, "bytes");
+}
+
+TEST(peak_heap_per_request) {
+  const HostHttpResponse& r = get("/baseline");
+  int64_t baseline = r.heapPeak;
+  CHECK_EQ(r.bodyLength, pageSize);
+  int64_t plain = get("/").heapPeak;
+  CHECK_EQ(hostHttpResponse().bodyLength, pageSize);
+  int64_t gzip = get("/", "Accept-Encoding: gzip\r\n").heapPeak;
+  CHECK_EQ(hostHttpResponse().bodyLength, INDEX_HTM_GZ_LEN);
+  String match = String("Accept-Encoding: gzip\r\nIf-None-Match: ") + hostHttpHeader("ETag") + "\r\n";
+  int64_t cached = get("/", match.c_str()).heapPeak;
+  CHECK_EQ(hostHttpResponse().code, 304);
+
+  MEASURE("baseline, String of the file", baseline, "bytes");
+  MEASURE("streamFile(), plain", plain, "bytes");
+  MEASURE("streamFile(), gzip", gzip, "bytes");
+  MEASURE("304", cached, "bytes");
+  // The baseline holds the page, the String grows while it is read
+  CHECK(baseline > (int64_t)pageSize);
+  // streamFile() holds one HTTP_DOWNLOAD_UNIT_SIZE buffer plus the headers
+  CHECK(plain < HTTP_DOWNLOAD_UNIT_SIZE + 1024);
+  CHECK(gzip < HTTP_DOWNLOAD_UNIT_SIZE + 1024);
+  CHECK(cached < plain);
+}
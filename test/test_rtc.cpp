@@ -0,0 +1,145 @@
+#include <chrono>
+#include "HostTest.h"
+#include "SimDS1302.h"
+#include "SimI2cRtc.h"
+#include "RtcDS1302.h"
+#include "RtcDS1307.h"
+#include "RtcDS3231.h"
+#include "CachedRtc.h"
+
+// The RtcCore front end against the RtcBase virtual interface: the
+// cost of a clock query of the sketch, bound at compile time and
+// through two virtual calls as in the baseline. RtcUpdate commits:
+// bus transactions and the time the chip ends up with.
+
+#define START (26 * 365 * SECONDS_PER_DAY) // Some day in 2025
+
+typedef RtcDS1302T<D7, D6, D5> RtcChip;
+
+// Host CPU time per call, the best of a few runs
+template <class Call>
+static double bestNs(Call call) {
+  const uint32_t n = 2000000;
+  double best = 1e9;
+
+  for (uint8_t run = 0; run < 5; run++) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++)
+      call();
+    best = min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n);
+  }
+  return best;
+}
+
+TEST(static_vs_virtual_calls) {
+  SimDS1302 sim(D7, D6, D5);
+  RtcChip chip;
+  CachedRtc<RtcChip> direct(chip);
+  RtcAdapter<RtcChip> chipBase(chip);
+  CachedRtc<RtcBase> cached(chipBase);
+  RtcAdapter<CachedRtc<RtcBase> > cachedBase(cached);
+  // Through a volatile pointer, so the compiler can not see the type
+  RtcBase *volatile virt = &cachedBase;
+  volatile uint32_t sink = 0;
+  uint64_t cycles;
+  double ns[2], hourNs[2];
+
+  sim.setTime(START);
+  // Both read the chip once, the queries below are answered from millis(),
+  // which does not move without a wait
+  CHECK_EQ(direct.getSecondsSince2000(), START);
+  CHECK_EQ(virt->getSecondsSince2000(), START);
+  CHECK_EQ(sim.stats().sessions, 2);
+
+  cycles = hostCycles();
+  ns[0] = bestNs([&]() { sink = sink + direct.getSecondsSince2000(); });
+  ns[1] = bestNs([&]() { sink = sink + virt->getSecondsSince2000(); });
+  hourNs[0] = bestNs([&]() { sink = sink + direct.getHour(); });
+  hourNs[1] = bestNs([&]() { sink = sink + virt->getHour(); });
+  (void)sink;
+
+  // Host CPU time. Two indirect calls per query are close to free on a
+  // host with branch prediction, so no order is checked; what carries
+  // over to the board is the code size, see size_rtc.
+  MEASURE("getSecondsSince2000(), RtcCore", ns[0], "ns");
+  MEASURE("getSecondsSince2000(), RtcBase", ns[1], "ns");
+  MEASURE("getHour(), RtcCore", hourNs[0], "ns");
+  MEASURE("getHour(), RtcBase", hourNs[1], "ns");
+  CHECK_EQ(hostCycles() - cycles, 0);
+  CHECK_EQ(sim.stats().sessions, 2);
+}
+
+// The update of /time/set: date, hour and minute, the seconds keep counting
+static RtcUpdate timeSet() {
+  RtcUpdate update;
+
+  update.setYear(2028).setMonth(2).setDay(29).setHour(23).setMinute(59);
+  return update;
+}
+
+template <class Rtc>
+static void i2cCommit(SimI2cRtc::Model model) {
+  SimI2cRtc chip(model);
+  Rtc rtc;
+  RtcAdapter<Rtc> base(rtc);
+  RtcUpdate update;
+  DateTime dt;
+
+  chip.setTime(START + 37); // Second 37 of some minute
+  chip.resetStats();
+  rtc.commit(timeSet());
+  // The run is minute..year, all covered with the recomputed day of week
+  CHECK_EQ(chip.stats().reads, 0);
+  CHECK_EQ(chip.stats().writes, 1);
+  rtc.now(dt);
+  CHECK_EQ(dt.second, 37);
+  CHECK_EQ(toSecondsSince2000(dt), toSecondsSince2000({ 37, 59, 23, 0, 29, 2, 2028 }));
+  CHECK_EQ(dt.dow, 3); // Tuesday
+
+  // Seconds and year, the registers in between come from one read
+  chip.resetStats();
+  update.setSecond(5).setYear(2032);
+  rtc.commit(update);
+  CHECK_EQ(chip.stats().reads, 1);
+  CHECK_EQ(chip.stats().writes, 2); // Register pointer, the run
+  rtc.now(dt);
+  CHECK_EQ(dt.second, 5);
+  CHECK_EQ(dt.minute, 59);
+  CHECK_EQ(dt.day, 29);
+  CHECK_EQ(dt.year, 2032);
+  CHECK_EQ(dt.dow, 1); // Sunday, recomputed for the new year
+
+  // Through RtcBase the driver's commit runs, not a read and a full set()
+  chip.resetStats();
+  base.commit(timeSet());
+  CHECK_EQ(chip.stats().reads, 0);
+  CHECK_EQ(chip.stats().writes, 1);
+  chip.resetStats();
+  base.commit(RtcUpdate());
+  CHECK_EQ(chip.stats().writes, 0);
+}
+
+TEST(ds3231_commit) {
+  i2cCommit<RtcDS3231>(SimI2cRtc::DS3231);
+}
+
+TEST(ds1307_commit) {
+  i2cCommit<RtcDS1307>(SimI2cRtc::DS1307);
+}
+
+TEST(ds1302_commit) {
+  SimDS1302 sim(D7, D6, D5);
+  RtcChip chip;
+  DateTime dt;
+
+  sim.setTime(START + 37);
+  chip.begin();
+  sim.resetStats();
+  chip.commit(timeSet());
+  // The default of RtcCore: a burst read, the write protect, a burst write
+  CHECK_EQ(sim.stats().sessions, 3);
+  chip.now(dt);
+  CHECK_EQ(toSecondsSince2000(dt), toSecondsSince2000({ 37, 59, 23, 0, 29, 2, 2028 }));
+  CHECK_EQ(dt.dow, 3);
+  CHECK_EQ(sim.stats().violations, 0);
+}
@@ -0,0 +1,128 @@
+#include <chrono>
+#include "HostTest.h"
+#include "Schedule.h"
+
+// Lookups of the weekly table with 1, 64 and 1024 entries: find() and
+// next() against a scan of the whole table. Built with
+// SCHEDULE_MAX_ENTRIES 1024, more than the EEPROM of the board holds,
+// and SCHEDULE_COUNT_PROBES, so the entries read are counted.
+
+static Schedule table;
+uint32_t scheduleProbes;
+static uint32_t scanProbes;
+
+// The scan the binary searches replace
+static int16_t scanFind(uint16_t minute) {
+  int16_t found = -1;
+
+  for (uint16_t i = 0; i < table.count(); i++) {
+    scanProbes++;
+    if ((table[i] & SCHEDULE_MINUTE) <= minute)
+      found = i;
+  }
+  return ((found < 0) && table.count()) ? table.count() - 1 : found;
+}
+
+static uint16_t scanNext(uint16_t minute) {
+  for (uint16_t i = 0; i < table.count(); i++) {
+    scanProbes++;
+    if ((table[i] & SCHEDULE_MINUTE) > minute)
+      return i;
+  }
+  return 0;
+}
+
+// Host CPU time per lookup, the best of a few runs
+template <class Lookup>
+static double bestNs(Lookup lookup) {
+  const uint32_t n = 200000;
+  double best = 1e9;
+
+  for (uint8_t run = 0; run < 5; run++) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++)
+      lookup(i * 7919 % MINUTES_PER_WEEK);
+    best = min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n);
+  }
+  return best;
+}
+
+static void fill(uint16_t entries) {
+  table.clear();
+  for (uint16_t i = 0; i < entries; i++)
+    CHECK(table.add((uint32_t)i * MINUTES_PER_WEEK / entries + 3, i & 1));
+  CHECK_EQ(table.count(), entries);
+}
+
+TEST(same_as_a_scan) {
+  static const uint16_t sizes[] = { 1, 2, 64, 1024 };
+
+  for (uint8_t s = 0; s < 4; s++) {
+    fill(sizes[s]);
+    for (uint16_t m = 0; m < MINUTES_PER_WEEK; m++) {
+      CHECK_EQ(table.find(m), scanFind(m));
+      CHECK_EQ(table.next(m), scanNext(m));
+      CHECK_EQ(table.contains(m), (table[table.find(m)] & SCHEDULE_MINUTE) == m);
+    }
+  }
+}
+
+// A search of n entries reads at most floor(log2 n) + 1 of them
+static uint8_t maxProbes(uint16_t entries) {
+  uint8_t bits = 0;
+
+  while (entries >> bits)
+    bits++;
+  return bits;
+}
+
+TEST(probes) {
+  static const uint16_t sizes[] = { 1, 64, 1024 };
+  char label[64];
+
+  for (uint8_t s = 0; s < 3; s++) {
+    uint32_t probes = 0, scans = 0;
+    fill(sizes[s]);
+    for (uint16_t m = 0; m < MINUTES_PER_WEEK; m++) {
+      scheduleProbes = 0;
+      table.find(m);
+      CHECK(scheduleProbes <= maxProbes(sizes[s]));
+      probes += scheduleProbes;
+      scheduleProbes = 0;
+      table.next(m);
+      CHECK(scheduleProbes <= maxProbes(sizes[s]));
+      probes += scheduleProbes;
+      scanProbes = 0;
+      scanFind(m);
+      scanNext(m);
+      scans += scanProbes;
+    }
+    snprintf(label, sizeof(label), "%u entries, find() and next()", sizes[s]);
+    MEASURE(label, (double)probes / MINUTES_PER_WEEK, "entries read");
+    snprintf(label, sizeof(label), "%u entries, scan", sizes[s]);
+    MEASURE(label, (double)scans / MINUTES_PER_WEEK, "entries read");
+    // 11 reads each against a full pass and half of one
+    if (sizes[s] == 1024)
+      CHECK(probes * 50 < scans);
+  }
+}
+
+TEST(benchmark) {
+  static const uint16_t sizes[] = { 1, 64, 1024 };
+  volatile uint32_t sink = 0;
+  double ns, scanNs;
+  char label[64];
+
+  for (uint8_t s = 0; s < 3; s++) {
+    fill(sizes[s]);
+    ns = bestNs([&](uint16_t m) { sink = sink + table.find(m) + table.next(m); });
+    scanNs = bestNs([&](uint16_t m) { sink = sink + scanFind(m) + scanNext(m); });
+    // Host CPU time, the growth with the table is what carries over to the board
+    snprintf(label, sizeof(label), "%u entries, find() and next()", sizes[s]);
+    MEASURE(label, ns, "ns");
+    snprintf(label, sizeof(label), "%u entries, scan", sizes[s]);
+    MEASURE(label, scanNs, "ns");
+  }
+  // Wall time only, the load of the host decides it, see probes for the check
+  (void)sink;
+}
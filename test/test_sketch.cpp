@@ -0,0 +1,208 @@
+#include "HostTest.h"
+#include "SimDS1302.h"
+#include "Schedule.h"
+#include "WeekRules.h"
+#include "Rtc.h"
+#include <EEPROM.h>
+
+// The default build of the sketch boots on the simulated board and
+// answers its routes
+
+void setup();
+void loop();
+extern Schedule schedule;
+extern WeekRules rules;
+extern DayPlan plan;
+void compilePlan(uint16_t day);
+
+static SimDS1302 chip(D7, D6, D5);
+
+static const HostHttpResponse& get(const char *target, const char *headers = NULL) {
+  hostHttpRequest(target, headers);
+  loop();
+  return hostHttpResponse();
+}
+
+TEST(boots) {
+  chip.setTime(26 * 365 * 86400); // Some day in 2025
+  setup();
+  CHECK(strstr(hostSerialOutput(), "HTTP server started"));
+  CHECK(hostPinIsOutput(D4));
+  CHECK_EQ(hostPinConflicts(), 0);
+  CHECK_EQ(chip.stats().violations, 0);
+}
+
+TEST(serves_the_page) {
+  const HostHttpResponse& r = get("/", "Accept-Encoding: gzip\r\n");
+  CHECK(r.done);
+  CHECK_EQ(r.code, 200);
+  CHECK_STR(hostHttpHeader("Content-Encoding"), "gzip");
+  CHECK(r.bodyLength > 0);
+  CHECK_EQ(get("/", (String("If-None-Match: ") + hostHttpHeader("ETag") + "\r\n").c_str()).code, 304);
+}
+
+TEST(sets_and_reads_the_time) {
+  CHECK_EQ(get("/time/set?year=2026&month=3&day=14&hour=9&minute=5").code, 200);
+  CHECK_EQ(chip.time() / 60 % 1440, 9 * 60 + 5);
+  CHECK_STR(get("/time/get").body, "9:05");
+  CHECK_EQ(chip.stats().violations, 0);
+}
+
+TEST(switches_the_relay) {
+  uint8_t before = hostPinLevel(D4);
+  CHECK_EQ(get("/switch").code, 200);
+  CHECK(hostPinLevel(D4) != before);
+  CHECK_STR(get("/state").body, before ? "{\"state\":1}" : "{\"state\":0}");
+}
+
+TEST(unknown_route) {
+  CHECK_EQ(get("/nope").code, 404);
+}
+
+// Without day an entry goes to all 7 days or to none
+TEST(schedule_every_day_or_none) {
+  uint32_t commits;
+
+  schedule.clear();
+  schedule.add(Schedule::minuteOfWeek(1, 12, 0), false); // Monday has one at that time
+  for (uint16_t i = 0; schedule.count() < SCHEDULE_MAX_ENTRIES - 5; i++)
+    schedule.add(Schedule::minuteOfWeek(0, 0, 0) + i, true);
+  commits = hostEepromCommits();
+  // 6 new entries do not fit in 5
+  CHECK_EQ(get("/api/schedule/add?hour=12&minute=0&on=1").code, 507);
+  CHECK_EQ(schedule.count(), SCHEDULE_MAX_ENTRIES - 5);
+  CHECK(!(schedule[schedule.find(Schedule::minuteOfWeek(1, 12, 0))] & SCHEDULE_ON));
+  CHECK_EQ(hostEepromCommits(), commits);
+  // They fit in 6
+  schedule.remove(Schedule::minuteOfWeek(0, 0, 0));
+  CHECK_EQ(get("/api/schedule/add?hour=12&minute=0&on=1").code, 200);
+  CHECK_EQ(schedule.count(), SCHEDULE_MAX_ENTRIES);
+  CHECK(schedule[schedule.find(Schedule::minuteOfWeek(1, 12, 0))] & SCHEDULE_ON);
+  CHECK_EQ(hostEepromCommits(), commits + 1);
+  // Remove needs the entry on every day
+  CHECK_EQ(get("/api/schedule/remove?day=3&hour=12&minute=0").code, 200);
+  CHECK_EQ(get("/api/schedule/remove?hour=12&minute=0").code, 404);
+  CHECK_EQ(schedule.count(), SCHEDULE_MAX_ENTRIES - 1);
+  CHECK_EQ(hostEepromCommits(), commits + 2);
+  CHECK_EQ(get("/api/schedule/add?day=3&hour=12&minute=0&on=1").code, 200);
+  CHECK_EQ(get("/api/schedule/remove?hour=12&minute=0").code, 200);
+  CHECK_EQ(schedule.count(), SCHEDULE_MAX_ENTRIES - 7);
+  CHECK_EQ(get("/api/schedule/clear").code, 200);
+  CHECK_EQ(schedule.count(), 0);
+}
+
+// Minutes of the compiled plan that are on, as ranges "from-to "
+static const char *planRanges(uint16_t day) {
+  static String ranges;
+  uint16_t m = 0;
+
+  ranges = "";
+  compilePlan(day);
+  while (m < MINUTES_PER_DAY) {
+    uint16_t next = plan.next(m);
+    if (plan.get(m))
+      ranges += String(m) + "-" + String(next) + " ";
+    m = next;
+  }
+  return ranges.c_str();
+}
+
+TEST(an_exception_overrides_every_source) {
+  const uint16_t today = daysFromCivil(2026, 3, 14);
+
+  schedule.clear();
+  schedule.add(Schedule::minuteOfWeek(6, 8, 0), true);   // Saturday 8:00 to 20:00
+  schedule.add(Schedule::minuteOfWeek(6, 20, 0), false);
+  CHECK_EQ(get("/api/rules/add?days=127&startHour=10&startMinute=0&endHour=11&endMinute=0").code, 200);
+  CHECK_EQ(get("/config/scheduler?startHour=22&startMinute=0&endHour=6&endMinute=0").code, 200);
+  CHECK_STR(planRanges(today), "0-360 480-1200 1320-1440 ");
+
+  // Only the window of the exception, the morning of the pair included
+  CHECK_EQ(get("/api/exceptions/add?year=2026&month=3&day=14&startHour=12&startMinute=0&endHour=13&endMinute=0").code, 200);
+  CHECK_STR(planRanges(today), "720-780 ");
+  // The day after: no pair from the night before, the rest as usual
+  CHECK_STR(planRanges(today + 1), "600-660 1320-1440 ");
+  // Off all day
+  CHECK_EQ(get("/api/exceptions/add?year=2026&month=3&day=14").code, 200);
+  CHECK_EQ(rules.exceptionCount(), 1); // Replaced
+  CHECK_STR(planRanges(today), "");
+
+  // Dates that do not exist
+  CHECK_EQ(get("/api/exceptions/add?year=2026&month=2&day=29").code, 400);
+  CHECK_EQ(get("/api/exceptions/add?year=2026&month=4&day=31").code, 400);
+  CHECK_EQ(get("/api/exceptions/add?year=2026&month=12&day=32").code, 400);
+  CHECK_EQ(get("/api/exceptions/add?year=2028&month=2&day=29").code, 200);
+  CHECK_EQ(rules.exceptionCount(), 2);
+
+  // Full: a new date does not fit, the same date is replaced
+  for (uint8_t d = 1; rules.exceptionCount() < WEEKRULES_MAX_EXCEPTIONS; d++)
+    CHECK(rules.addException(daysFromCivil(2027, 1, d), 0, 0));
+  CHECK_EQ(get("/api/exceptions/add?year=2027&month=6&day=1").code, 507);
+  CHECK_EQ(get("/api/exceptions/add?year=2026&month=3&day=14&startHour=9&startMinute=0&endHour=9&endMinute=30").code, 200);
+  CHECK_EQ(rules.exceptionCount(), WEEKRULES_MAX_EXCEPTIONS);
+  CHECK_STR(planRanges(today), "540-570 ");
+
+  while (rules.exceptionCount())
+    rules.removeException(0);
+  rules.removeRule(0);
+  schedule.clear();
+  CHECK_EQ(get("/config/scheduler?startHour=99&startMinute=0&endHour=0&endMinute=0").code, 200);
+
+  // A window over midnight: the exception's morning replaces the one of the rule
+  CHECK(rules.addRule(0x7F, 23 * 60, 60));
+  CHECK(rules.addException(today, 22 * 60, 2 * 60));
+  CHECK_STR(planRanges(today), "1320-1440 ");
+  CHECK_STR(planRanges(today + 1), "0-120 1380-1440 ");
+  rules.removeException(0);
+  rules.removeRule(0);
+}
+
+TEST(a_wrong_clock_keeps_the_exceptions) {
+  uint8_t saved[WEEKRULES_EEPROM_SIZE];
+
+  CHECK_EQ(get("/api/exceptions/add?year=2025&month=1&day=1").code, 200);
+  CHECK_EQ(get("/api/exceptions/add?year=2026&month=3&day=13").code, 200);
+  for (uint16_t i = 0; i < sizeof(saved); i++)
+    saved[i] = EEPROM.read(WEEKRULES_EEPROM_ADDR + i);
+  // A date years ahead, as a chip that lost its time may read
+  compilePlan(daysFromCivil(2099, 12, 31));
+  CHECK_EQ(rules.exceptionCount(), 2);
+  for (uint16_t i = 0; i < sizeof(saved); i++)
+    CHECK_EQ(EEPROM.read(WEEKRULES_EEPROM_ADDR + i), saved[i]);
+
+  // Full: the past one makes room for the new one
+  for (uint8_t d = 1; rules.exceptionCount() < WEEKRULES_MAX_EXCEPTIONS; d++)
+    CHECK(rules.addException(daysFromCivil(2027, 1, d), 0, 0));
+  CHECK_EQ(get("/api/exceptions/add?year=2027&month=6&day=1").code, 200);
+  CHECK_EQ(rules.exceptionCount(), WEEKRULES_MAX_EXCEPTIONS);
+  CHECK(!rules.excepted(daysFromCivil(2025, 1, 1)));
+  CHECK(rules.excepted(daysFromCivil(2026, 3, 13))); // Yesterday, its window may reach into today
+  CHECK_EQ(get("/api/exceptions/add?year=2027&month=6&day=2").code, 507);
+  while (rules.exceptionCount())
+    rules.removeException(0);
+}
+
+TEST(the_first_day_has_no_yesterday) {
+  // Day 0 - 1 must not wrap to the last day a word holds
+  CHECK(rules.addException(0xFFFF, 0, 0));
+  CHECK(rules.addRule(0x7F, 23 * 60, 60));
+  CHECK_EQ(get("/config/scheduler?startHour=22&startMinute=0&endHour=6&endMinute=0").code, 200);
+  CHECK_STR(planRanges(0), "0-360 1320-1440 ");
+  CHECK_EQ(get("/config/scheduler?startHour=99&startMinute=0&endHour=0&endMinute=0").code, 200);
+  CHECK_STR(planRanges(0), "0-60 1380-1440 ");
+  rules.removeException(0);
+  rules.removeRule(0);
+}
+
+TEST(a_bad_rule_is_rejected_before_a_full_table) {
+  while (rules.ruleCount() < WEEKRULES_MAX_RULES)
+    CHECK(rules.addRule(0x7F, 60, 120));
+  CHECK_EQ(get("/api/rules/add?days=0&startHour=8&startMinute=0&endHour=9&endMinute=0").code, 400);
+  CHECK_EQ(get("/api/rules/add?days=62&startHour=8&startMinute=0&endHour=8&endMinute=0").code, 400);
+  CHECK_EQ(get("/api/rules/add?days=62&startHour=25&startMinute=0&endHour=9&endMinute=0").code, 400);
+  CHECK_EQ(get("/api/rules/add?days=62&startHour=8&startMinute=0&endHour=9&endMinute=0").code, 507);
+  rules.removeRule(0);
+  CHECK_EQ(get("/api/rules/add?days=62&startHour=8&startMinute=0&endHour=9&endMinute=0").code, 200);
+  while (rules.ruleCount())
+    rules.removeRule(0);
+}
@@ -0,0 +1,143 @@
+#include "HostTest.h"
+#include "SimI2cRtc.h"
+#include "RtcDS3231.h"
+#include "SqwClock.h"
+
+// SqwClock on the 1Hz square wave of the simulated DS3231: timestamps
+// over a long pulse train with the chip on time, fast and slow, and
+// the USE_SQW build of the sketch dating the edges again after the
+// clock was set
+
+#define PIN     D5 // RTC_INT of the sketch
+#define START   (26 * 365 * SECONDS_PER_DAY) // Some day in 2025
+#define QUERY_MS 7 // Off the second, the queries walk through every phase
+#define MINUTES 10
+
+void setup();
+void loop();
+extern SqwClock sqw;
+
+static SqwClock *clock;
+
+static void ICACHE_RAM_ATTR onEdge() {
+  clock->edge();
+}
+
+struct Train {
+  uint32_t queries;
+  uint32_t backwards; // Timestamps below the one before
+  uint32_t ahead;     // Seconds ahead of the chip
+  uint32_t behind;    // Seconds behind the chip
+  uint32_t held;      // Answers held at ms 999 waiting for the edge
+  uint32_t edges;
+  uint32_t chipSeconds;
+};
+
+static Train pulseTrain(int32_t ppm) {
+  SimI2cRtc chip(SimI2cRtc::DS3231, PIN);
+  RtcDS3231 rtc;
+  SqwClock sqwClock;
+  uint64_t last = 0;
+  uint32_t edges, start;
+  Train r;
+
+  memset(&r, 0, sizeof(r));
+  clock = &sqwClock;
+  chip.setTime(START);
+  chip.setDrift(ppm);
+  rtc.begin();
+  rtc.setPinMode(DS3231_PIN_SQW_1HZ);
+  pinMode(PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(PIN), onEdge, FALLING);
+  while (!sqwClock.sync(rtc))
+    hostAdvanceMillis(10);
+  edges = sqwClock.edgeCount();
+  start = chip.time();
+  for (uint32_t ms = 0; ms < MINUTES * 60000UL; ms += QUERY_MS) {
+    uint64_t t = sqwClock.getMillisSince2000();
+    r.queries++;
+    if (t < last)
+      r.backwards++;
+    if (t / 1000 > chip.time())
+      r.ahead++;
+    if (t / 1000 < chip.time())
+      r.behind++;
+    if (t % 1000 == 999)
+      r.held++;
+    last = t;
+    hostAdvanceMillis(QUERY_MS);
+  }
+  r.edges = sqwClock.edgeCount() - edges;
+  r.chipSeconds = chip.time() - start;
+  detachInterrupt(digitalPinToInterrupt(PIN));
+  return r;
+}
+
+static void report(const char *name, const Train& r) {
+  char label[64];
+
+  snprintf(label, sizeof(label), "%s, edges in %u minutes", name, MINUTES);
+  MEASURE(label, r.edges, "");
+  snprintf(label, sizeof(label), "%s, answers held at 999 ms", name);
+  MEASURE(label, 100.0 * r.held / r.queries, "%");
+  CHECK_EQ(r.backwards, 0);
+  CHECK_EQ(r.ahead, 0);
+  CHECK_EQ(r.behind, 0);
+  // Every chip second is an edge, however far the chip is off millis()
+  CHECK_EQ(r.edges, r.chipSeconds);
+}
+
+TEST(pulse_train_on_time) {
+  Train r = pulseTrain(0);
+  report("chip on time", r);
+  CHECK_EQ(r.edges, MINUTES * 60);
+  // Only the queries in the last ms of a second read 999
+  CHECK(r.held * QUERY_MS <= r.queries * 2);
+}
+
+TEST(pulse_train_fast_chip) {
+  Train r = pulseTrain(50000); // 5% fast, a second every 952 ms
+  report("chip 5% fast", r);
+  CHECK(r.edges > MINUTES * 60 * 104 / 100);
+  CHECK_EQ(r.held, 0);
+}
+
+TEST(pulse_train_slow_chip) {
+  Train r = pulseTrain(-50000); // 5% slow, a second every 1053 ms
+  report("chip 5% slow", r);
+  CHECK(r.edges < MINUTES * 60 * 96 / 100);
+  // About 53 ms of every second wait for the late edge
+  CHECK(r.held * QUERY_MS * 1000 > r.queries * 40);
+}
+
+static const HostHttpResponse& get(const char *target) {
+  hostHttpRequest(target, NULL);
+  loop();
+  return hostHttpResponse();
+}
+
+// loop() every 10 ms until the edges have a date, at most 3 s
+static bool runUntilSynced() {
+  for (uint16_t i = 0; i < 300 && !sqw.synced(); i++) {
+    hostAdvanceMillis(10);
+    loop();
+  }
+  return sqw.synced();
+}
+
+TEST(sketch_dates_the_edges_again_after_time_set) {
+  static SimI2cRtc chip(SimI2cRtc::DS3231, PIN);
+
+  chip.setTime(START + 30);
+  setup();
+  CHECK(runUntilSynced());
+  CHECK_EQ(sqw.getSecondsSince2000(), chip.time());
+
+  CHECK_EQ(get("/time/set?year=2030&month=1&day=2&hour=3&minute=4").code, 200);
+  // The pass of the request dates the edges again, a stale base would be years off
+  CHECK(runUntilSynced());
+  CHECK_EQ(chip.time() / 60 % 1440, 3 * 60 + 4);
+  CHECK_EQ(sqw.getSecondsSince2000(), chip.time());
+  hostAdvanceMillis(5000);
+  CHECK_EQ(sqw.getSecondsSince2000(), chip.time());
+}
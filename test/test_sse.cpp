@@ -0,0 +1,114 @@
+#include "HostTest.h"
+#include <lwip/tcp.h>
+#include "SseServer.h"
+
+// SseServer against clients on the simulated lwIP: the stream limit,
+// and a client that stops reading while events keep coming
+
+#define PORT    81
+#define REQUEST "GET /events HTTP/1.1\r\nHost: esp\r\n\r\n"
+
+static SseServer events(PORT);
+
+static void onConnect(WiFiClient& client) {
+  SseServer::send(client, "state", "{\"state\":1}");
+}
+
+// Takes everything the server sent, returns the number of events in it
+static uint32_t drain(HostPeer& peer) {
+  char buf[256];
+  uint32_t n = 0;
+  size_t len;
+
+  while ((len = peer.receive(buf, sizeof(buf) - 1)) > 0) {
+    buf[len] = 0;
+    for (char *p = buf; (p = strstr(p, "event: ")); p++)
+      n++;
+  }
+  return n;
+}
+
+static bool open(HostPeer& peer) {
+  if (!peer.connect(PORT))
+    return false;
+  peer.send(REQUEST);
+  events.handle();
+  events.handle();
+  return peer.connected();
+}
+
+TEST(streams_up_to_the_limit) {
+  HostPeer peers[SSE_MAX_CLIENTS + 1];
+
+  events.onConnect(onConnect);
+  events.begin();
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    CHECK(open(peers[i]));
+    CHECK_EQ(drain(peers[i]), 1);
+  }
+  CHECK_EQ(events.count(), SSE_MAX_CLIENTS);
+  // One more is closed at once, the browser retries later
+  peers[SSE_MAX_CLIENTS].connect(PORT);
+  events.handle();
+  CHECK(!peers[SSE_MAX_CLIENTS].connected());
+  CHECK_EQ(events.count(), SSE_MAX_CLIENTS);
+  // Streams and the web server client within the pcbs of lwIP
+  CHECK(SSE_MAX_CLIENTS + 1 < MEMP_NUM_TCP_PCB);
+  for (uint8_t i = 0; i <= SSE_MAX_CLIENTS; i++)
+    peers[i].close();
+  events.handle();
+  CHECK_EQ(events.count(), 0);
+}
+
+TEST(a_slow_client_is_dropped_without_blocking) {
+  HostPeer fast, slow;
+  uint32_t sent = 0, received = 0;
+  uint64_t worst = 0;
+
+  CHECK(open(fast));
+  CHECK(open(slow));
+  drain(fast);
+  // 'slow' stops reading, its send buffer fills up
+  for (uint32_t i = 0; i < 200; i++) {
+    uint64_t start = hostCycles();
+    events.broadcast("time", "12:34");
+    worst = max(worst, hostCycles() - start);
+    sent++;
+    received += drain(fast);
+    hostAdvanceMillis(10);
+  }
+  MEASURE("worst broadcast with a stalled client", (double)worst / HOST_CYCLES_PER_US, "us");
+  MEASURE("bytes queued for the stalled client", slow.pending(), "bytes");
+  CHECK_EQ(worst, 0); // No write waited for room
+  CHECK_EQ(received, sent);
+  CHECK_EQ(events.count(), 1);
+  CHECK(!slow.connected());
+  CHECK(fast.connected());
+}
+
+TEST(keepalive_drops_a_full_client) {
+  HostPeer slow;
+  char data[SSE_EVENT_SIZE];
+  size_t room;
+  uint64_t start;
+
+  CHECK(open(slow)); // The streams of the test before are gone
+  CHECK_EQ(events.count(), 1);
+  // Events until two bytes are left in the send buffer of 'slow',
+  // "event: x\ndata: \n\n" takes 17 bytes around the data
+  while ((room = TCP_SND_BUF - slow.pending() - 2) > 0) {
+    size_t n = room > 120 ? 80 : room;
+    memset(data, 'x', n - 17);
+    data[n - 17] = 0;
+    events.broadcast("x", data);
+  }
+  CHECK_EQ(events.count(), 1);
+  CHECK(slow.connected());
+  start = hostCycles();
+  hostAdvanceMillis(SSE_KEEPALIVE);
+  events.handle();
+  // The keep-alive does not fit, the stream goes instead of the loop waiting
+  CHECK_EQ(hostCycles() - start, (uint64_t)SSE_KEEPALIVE * 1000 * HOST_CYCLES_PER_US);
+  CHECK_EQ(events.count(), 0);
+  CHECK(!slow.connected());
+}
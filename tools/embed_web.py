@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""Embeds data/index.htm into the firmware.
+
+Minifies and gzips the page and writes it as a PROGMEM byte array to
+index_htm.h, together with its length and an ETag. Run it after every
+change of data/index.htm and commit the generated header:
+
+    python3 tools/embed_web.py
+"""
+import gzip
+import io
+import os
+import re
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, 'data', 'index.htm')
+TARGET = os.path.join(ROOT, 'index_htm.h')
+
+
+def minify(html):
+    # HTML comments go, conditional comments are not used by the page
+    html = re.sub(r'<!--(?!\[if).*?-->', '', html, flags=re.S)
+    # Indentation and empty lines go. Line breaks stay, the scripts rely
+    # on them where a semicolon is missing.
+    lines = (line.strip() for line in html.splitlines())
+    return '\n'.join(line for line in lines if line) + '\n'
+
+
+def compress(raw):
+    # mtime 0 keeps the output stable, so the header only changes with the page
+    buf = io.BytesIO()
+    with gzip.GzipFile(fileobj=buf, mode='wb', compresslevel=9, mtime=0) as f:
+        f.write(raw)
+    return buf.getvalue()
+
+
+def fnv1a(data):
+    # Same hash as tagFile() in the sketch
+    h = 2166136261
+    for b in bytearray(data):
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def main():
+    with open(SOURCE, 'rb') as f:
+        html = f.read().decode('utf-8')
+    raw = minify(html).encode('utf-8')
+    packed = compress(raw)
+    lines = []
+    for i in range(0, len(packed), 16):
+        lines.append('  ' + ', '.join('0x%02x' % b for b in bytearray(packed[i:i + 16])) + ',')
+    with open(TARGET, 'w', newline='\n') as f:
+        f.write('// Generated by tools/embed_web.py from data/index.htm, do not edit.\n')
+        f.write('// %d bytes, %d minified, %d gzipped.\n' % (len(html.encode('utf-8')), len(raw), len(packed)))
+        f.write('#ifndef __INDEX_HTM_H\n#define __INDEX_HTM_H\n\n')
+        f.write('#include <Arduino.h>\n\n')
+        f.write('#define INDEX_HTM_ETAG "\\"%08x\\""\n' % fnv1a(packed))
+        f.write('#define INDEX_HTM_GZ_LEN %d\n\n' % len(packed))
+        f.write('static const uint8_t INDEX_HTM_GZ[] PROGMEM = {\n')
+        f.write('\n'.join(lines) + '\n')
+        f.write('};\n\n#endif\n')
+    print('%s: %d -> %d -> %d bytes' % (os.path.relpath(TARGET, ROOT), len(html.encode('utf-8')), len(raw), len(packed)))
+
+
+if __name__ == '__main__':
+    main()
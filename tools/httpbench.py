@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""HTTP load generator for the device API.
+
+Drives a weighted mix of routes with a number of concurrent clients
+and reports throughput, latency percentiles and errors per route.
+Every client keeps one connection alive (--close opens one per
+request). Results can be written as JSON and compared later:
+
+    python3 tools/httpbench.py --host 192.168.4.1 --concurrency 1,4,8 \\
+        --mix /api/status:8,/state:4,/:1 --duration 20 --json new.json
+    python3 tools/httpbench.py --compare old.json new.json
+
+/switch toggles the relay on every request, so it is only driven
+when it is named in --mix. The latency measured is the HTTP round
+trip as the client sees it; the time from the request to the relay
+pin edge needs a probe on D4.
+"""
+import argparse
+import http.client
+import json
+import random
+import socket
+import sys
+import threading
+import time
+
+DEFAULT_MIX = '/api/status:8,/state:4,/time/get:2,/:1'
+
+
+def parse_mix(text):
+    mix = []
+    for item in text.split(','):
+        route, _, weight = item.strip().rpartition(':')
+        if not route:
+            route, weight = weight, '1'
+        mix.append((route, float(weight)))
+    return mix
+
+
+def percentile(values, p):
+    if not values:
+        return None
+    values = sorted(values)
+    k = (len(values) - 1) * p / 100.0
+    lo = int(k)
+    hi = min(lo + 1, len(values) - 1)
+    return values[lo] + (values[hi] - values[lo]) * (k - lo)
+
+
+class Stats:
+    def __init__(self):
+        self.latencies = []
+        self.errors = 0
+        self.bytes = 0
+        self.codes = {}
+
+    def merge(self, other):
+        self.latencies.extend(other.latencies)
+        self.errors += other.errors
+        self.bytes += other.bytes
+        for code, n in other.codes.items():
+            self.codes[code] = self.codes.get(code, 0) + n
+
+    def summary(self, duration):
+        count = len(self.latencies) + self.errors
+        ms = [v * 1000.0 for v in self.latencies]
+        return {
+            'count': count,
+            'errors': self.errors,
+            'error_rate': self.errors / count if count else 0.0,
+            'rps': len(self.latencies) / duration if duration else 0.0,
+            'bytes': self.bytes,
+            'codes': self.codes,
+            'p50_ms': percentile(ms, 50),
+            'p95_ms': percentile(ms, 95),
+            'p99_ms': percentile(ms, 99),
+            'max_ms': max(ms) if ms else None,
+        }
+
+
+def worker(args, mix, seed, deadline, budget, results, lock):
+    rng = random.Random(seed)
+    routes = [r for r, _ in mix]
+    weights = [w for _, w in mix]
+    stats = dict((r, Stats()) for r in routes)
+    headers = {'Accept-Encoding': 'gzip'}
+    if args.close:
+        headers['Connection'] = 'close'
+    conn = None
+    while time.monotonic() < deadline:
+        with lock:
+            if budget[0] <= 0:
+                break
+            budget[0] -= 1
+        route = rng.choices(routes, weights)[0]
+        s = stats[route]
+        start = time.perf_counter()
+        try:
+            if conn is None:
+                conn = http.client.HTTPConnection(args.host, args.port, timeout=args.timeout)
+            conn.request('GET', route, headers=headers)
+            response = conn.getresponse()
+            body = response.read()
+            elapsed = time.perf_counter() - start
+            s.codes[response.status] = s.codes.get(response.status, 0) + 1
+            if response.status >= 400:
+                s.errors += 1
+            else:
+                s.latencies.append(elapsed)
+                s.bytes += len(body)
+            if args.close or response.getheader('Connection', '').lower() == 'close':
+                conn.close()
+                conn = None
+        except (OSError, http.client.HTTPException, socket.timeout):
+            s.errors += 1
+            s.codes['error'] = s.codes.get('error', 0) + 1
+            if conn is not None:
+                conn.close()
+            conn = None
+    if conn is not None:
+        conn.close()
+    with lock:
+        for route, st in stats.items():
+            results.setdefault(route, Stats()).merge(st)
+
+
+def run(args, mix, concurrency):
+    results = {}
+    lock = threading.Lock()
+    budget = [args.requests if args.requests else float('inf')]
+    start = time.monotonic()
+    deadline = start + args.duration
+    threads = [threading.Thread(target=worker, args=(args, mix, args.seed + i, deadline, budget, results, lock))
+               for i in range(concurrency)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    duration = time.monotonic() - start
+    total = Stats()
+    for st in results.values():
+        total.merge(st)
+    return {
+        'concurrency': concurrency,
+        'duration_s': duration,
+        'routes': dict((route, st.summary(duration)) for route, st in sorted(results.items())),
+        'total': total.summary(duration),
+    }
+
+
+def fmt(value, spec='%.1f'):
+    return '-' if value is None else spec % value
+
+
+def print_run(result):
+    print('concurrency %d, %.1f s' % (result['concurrency'], result['duration_s']))
+    print('  %-16s %7s %8s %7s %8s %8s %8s %8s' % ('route', 'count', 'req/s', 'err%', 'p50 ms', 'p95 ms', 'p99 ms', 'max ms'))
+    rows = list(result['routes'].items()) + [('total', result['total'])]
+    for route, s in rows:
+        print('  %-16s %7d %8.1f %7.2f %8s %8s %8s %8s' % (
+            route, s['count'], s['rps'], s['error_rate'] * 100,
+            fmt(s['p50_ms']), fmt(s['p95_ms']), fmt(s['p99_ms']), fmt(s['max_ms'])))
+
+
+def compare(old_path, new_path):
+    with open(old_path) as f:
+        old = json.load(f)
+    with open(new_path) as f:
+        new = json.load(f)
+    print('%s -> %s' % (old.get('label') or old_path, new.get('label') or new_path))
+    old_runs = dict((r['concurrency'], r) for r in old['runs'])
+    for run_new in new['runs']:
+        run_old = old_runs.get(run_new['concurrency'])
+        if not run_old:
+            continue
+        print('concurrency %d' % run_new['concurrency'])
+        for route in sorted(set(run_old['routes']) & set(run_new['routes'])) + ['total']:
+            a = run_old['total'] if route == 'total' else run_old['routes'][route]
+            b = run_new['total'] if route == 'total' else run_new['routes'][route]
+            print('  %-16s req/s %8.1f -> %8.1f   p99 %8s -> %8s ms   err %.2f%% -> %.2f%%' % (
+                route, a['rps'], b['rps'], fmt(a['p99_ms']), fmt(b['p99_ms']),
+                a['error_rate'] * 100, b['error_rate'] * 100))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--host', default='192.168.4.1', help='device address (soft-AP default)')
+    parser.add_argument('--port', type=int, default=80)
+    parser.add_argument('--mix', default=DEFAULT_MIX, help='route:weight,... (default %(default)s)')
+    parser.add_argument('--concurrency', default='1,4,8', help='clients, a comma separated list runs each in turn')
+    parser.add_argument('--duration', type=float, default=10.0, help='seconds per run')
+    parser.add_argument('--requests', type=int, default=0, help='stop a run after this many requests')
+    parser.add_argument('--timeout', type=float, default=5.0, help='seconds per request')
+    parser.add_argument('--close', action='store_true', help='new connection for every request')
+    parser.add_argument('--seed', type=int, default=1, help='route choice is reproducible for a seed')
+    parser.add_argument('--label', default='', help='firmware version or note stored in the JSON')
+    parser.add_argument('--json', metavar='FILE', help='write the results as JSON')
+    parser.add_argument('--compare', nargs=2, metavar=('OLD', 'NEW'), help='compare two JSON results and exit')
+    args = parser.parse_args()
+
+    if args.compare:
+        compare(*args.compare)
+        return 0
+    mix = parse_mix(args.mix)
+    runs = []
+    for concurrency in [int(c) for c in args.concurrency.split(',')]:
+        result = run(args, mix, concurrency)
+        print_run(result)
+        runs.append(result)
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump({
+                'label': args.label,
+                'host': '%s:%d' % (args.host, args.port),
+                'mix': args.mix,
+                'keepalive': not args.close,
+                'time': time.strftime('%Y-%m-%dT%H:%M:%S'),
+                'runs': runs,
+            }, f, indent=2)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+"""Turns the sketch into a C++ file for the host build.
+
+Does what arduino-builder does before it compiles a sketch: adds
+#include <Arduino.h> and a prototype of every function in front of the
+first function, with #line directives so errors point into the .ino.
+Only functions that start at the beginning of a line are found, which
+is how the sketch is written. CMakeLists.txt runs it:
+
+    python3 tools/ino2cpp.py wifipower.ino wifipower.cpp
+"""
+import os
+import re
+import sys
+
+TYPES = r'(?:void|int|bool|boolean|byte|char|uint8_t|uint16_t|uint32_t|size_t|String|const char\s*\*)'
+FUNCTION = re.compile(r'^(' + TYPES + r')\s+(ICACHE_RAM_ATTR\s+)?(\w+)\s*\(([^)]*)\)\s*\{')
+
+
+def main():
+    source, target = sys.argv[1], sys.argv[2]
+    with open(source) as f:
+        lines = f.read().splitlines()
+    name = os.path.basename(source)
+    prototypes = []
+    first = None
+    for i, line in enumerate(lines):
+        m = FUNCTION.match(line)
+        if not m:
+            continue
+        if first is None:
+            first = i
+        prototype = '%s %s%s(%s);' % (m.group(1), m.group(2) or '', m.group(3), m.group(4))
+        # Functions defined for several #ifdef branches get one prototype
+        if prototype not in prototypes:
+            prototypes.append(prototype)
+    if first is None:
+        first = len(lines)
+    out = ['#include <Arduino.h>', '#line 1 "%s"' % name]
+    out += lines[:first]
+    out += prototypes
+    out.append('#line %d "%s"' % (first + 1, name))
+    out += lines[first:]
+    text = '\n'.join(out) + '\n'
+    # Leaves the file alone when nothing changed, so it is not rebuilt
+    if os.path.exists(target):
+        with open(target) as f:
+            if f.read() == text:
+                return
+    with open(target, 'w') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -1,93 +1,646 @@
 #include <Ticker.h>
+// #define USE_DS3231 // DS3231 module on I2C (D2 = SDA, D1 = SCL), the scheduler runs from its alarms
+// #define USE_SQW // with USE_DS3231, INT/SQW gives a 1Hz time base for millisecond timestamps instead of alarm interrupts
+#ifdef USE_DS3231
+#include <Wire.h>
+#include "RtcDS3231.h"
+#include "SqwClock.h"
+#else
 #include "RtcDS1302.h"
+#include "RtcRamStore.h"
+#endif
+#include "CachedRtc.h"
+// #define USE_SPIFFS_PAGE // serves data/index.htm from SPIFFS instead of the copy built into the firmware
+#ifdef USE_SPIFFS_PAGE
 #include <FS.h>
+#else
+#include "index_htm.h" // generated by tools/embed_web.py
+#endif
 #include <ESP8266WiFi.h>
 #include <WiFiClient.h> 
+// #define USE_ASYNC_HTTP // serves HTTP over raw lwIP callbacks, several clients at once, see AsyncHttpServer.h
+#ifdef USE_ASYNC_HTTP
+#include "AsyncHttpServer.h"
+#ifdef USE_SPIFFS_PAGE
+#error "USE_SPIFFS_PAGE needs ESP8266WebServer::streamFile(), it does not work with USE_ASYNC_HTTP"
+#endif
+#else
 #include <ESP8266WebServer.h>
+#endif
 #include <EEPROM.h>
+#include "SseServer.h"
+#include "JsonWriter.h"
+#include "Metrics.h"
+#include "LoopProfiler.h"
+#include "Schedule.h"
+#include "DayPlan.h"
+#include "WeekRules.h"
 // Data for access point
 const char *ssid = "Rele";
 const char *password = "rele2205";
 byte data[5]; // // stors data from EEPROM
-volatile boolean check = false; // This flag indecates that we need to check our RTC
+volatile boolean check = true; // This flag indecates that we need to check our RTC, set by the timer armed for the next transition
+volatile boolean alarmed = false; // DS3231 pulled its INT pin low
+volatile boolean timerFired = false; // set by ISRTimer, loop() measures how late it took the timer
+uint32_t timerDue = 0; // millis() the timer of the next transition was armed for
+uint32_t timerLateMs = 0; // the last timer, from its due time to loop() taking it
+uint32_t timerLateMaxMs = 0; // the worst since boot or "loop reset"
+#define SCHEDULER_MAX_SLEEP 3600 // the timer is armed for at most this, s, then the clock is read again
 Ticker tk;
+#ifdef USE_ASYNC_HTTP
+AsyncHttpServer server(80); // is an object for web server
+#else
 ESP8266WebServer server(80); // is an object for web server
- RtcDS1302 rtc(D7, D6, D5); // is An object for RTC
+#endif
+SseServer events(81); // pushes relay and clock changes to the page, see SseServer.h
+uint32_t statusGeneration = 1; // bumped whenever the relay, the schedule or the minute changes
+uint32_t statusCached = 0; // generation of statusBody
+char statusBody[160]; // /api/status reply, rebuilt only when the generation moved on
+size_t statusLength = 0;
+Metrics metrics; // latency histograms, served at /metrics
+Histogram *handleClientTime = NULL; // see setup()
+Histogram *rtcReadTime = NULL;
+Histogram *eepromCommitTime = NULL;
+uint32_t checksumErrors = 0;
+Schedule schedule; // weekly table of transitions, see /api/schedule
+WeekRules rules; // windows on weekdays and date exceptions, see /api/rules
+#define PLAN_NONE 0xFF
+#define DAY_NONE 0xFFFF
+DayPlan plan; // today's relay state for every minute, from the table, the rules and the on/off pair
+uint16_t planDay = DAY_NONE; // day since 1.1.2000 plan was compiled for, DAY_NONE after a change
+bool planActive = false; // plan has a source, without one the scheduler leaves the relay alone
+LoopProfiler profiler; // time of the loop() sections, see /api/loop and the "loop" serial command
+// Sections of loop(), added in this order in setup()
+#define SECTION_HTTP 0
+#define SECTION_EVENTS 1
+#define SECTION_CLOCK 2
+#define SECTION_SCHEDULER 3
+#define SECTION_SERIAL 4
+#define ROUTE(uri, handler) server.on(uri, timed<handler>(metrics.histogram("wifipower_http_handler_seconds", uri))) // hot route, its run time recorded; the rest are plain server.on()
+#ifdef USE_DS3231
+#define RTC_INT D5 // INT/SQW pin of the DS3231
+typedef RtcDS3231 RtcChip;
+#else
+typedef RtcDS1302T<D7, D6, D5> RtcChip; // pins fixed at compile time
+#endif
+RtcChip rtcChip; // is An object for RTC
+CachedRtc<RtcChip> rtc(rtcChip); // software clock, reads the chip about once per minute
+#ifdef USE_SQW
+SqwClock sqw; // millisecond timestamps from the 1Hz square wave
+#endif
 // Constants
 #define RELAY D4 // relay is connected to digital pin 4
 #define LED 13 // building led is connected to digital pin 13. (Led was connected only for debugging, in prodaction version you will not see it)
 #define ON 0
 #define OFF 1
-// http handlers
-void getSchedulerConfiguration() { // returns scheduler's configuration directly from EEPROM
+// Scheduler decisions
+#define DECISION_NONE 0
+#define DECISION_ON 1
+#define DECISION_OFF 2
+struct HotState { // changes often, so it lives in the RTC ram instead of EEPROM
+	uint8_t relay; // ON or OFF
+	uint8_t decision; // last thing the scheduler did
+	uint8_t plan; // state of the day plan that switched the relay last, ON, OFF or PLAN_NONE
+	uint8_t reserved;
+	uint32_t boots; // boot counter
+};
+HotState hot = { OFF, DECISION_NONE, PLAN_NONE, 0, 0 };
+#ifndef USE_DS3231
+RtcRamStore<RtcChip, HotState> hotStore(rtcChip); // the DS3231 has no ram
+#endif
+void setRelay(uint8_t state) { // switches the relay and remembers it in the RTC ram
+	bool changed = digitalRead(D4) != state;
+	digitalWrite(D4, state);
+	if (changed) {
+		statusGeneration++;
+		char buf[16];
+		JsonWriter json(buf, sizeof(buf));
+		printState(json);
+		events.broadcast("state", json.c_str());
+	}
+	hot.relay = state;
+#ifndef USE_DS3231
+	hotStore.save(hot);
+#endif
+#ifdef USE_SQW
+	if (sqw.synced()) { // relay events get a millisecond timestamp
+		uint64_t t = sqw.getMillisSince2000();
+		Serial.printf("Relay %s at %lu.%03u\n", state == ON ? "on" : "off", (unsigned long)(t / 1000), (unsigned)(t % 1000));
+	}
+#endif
+}
+#ifdef USE_DS3231
+void armAlarms() { // Alarm 1 switches on, alarm 2 switches off, both once a day
+	rtcChip.setAlarm1(DS3231_ALARM1_MATCH_HOUR, 0, data[0], data[1], 0);
+	rtcChip.setAlarm2(DS3231_ALARM2_MATCH_HOUR, 0, data[2], data[3]);
+	rtcChip.clearAlarms();
+	rtcChip.enableAlarms(DS3231_ALARM1 | DS3231_ALARM2);
+#ifdef USE_SQW
+	rtcChip.setPinMode(DS3231_PIN_SQW_1HZ); // the alarms still set their flags, see pollClock()
+#endif
+}
+#endif
+// http handlers, written against both server backends through these helpers
+int argInt(const char *name) { // numeric request argument, 0 if missing
+#ifdef USE_ASYNC_HTTP
+	return atoi(server.arg(name));
+#else
+	return atoi(server.arg(name).c_str());
+#endif
+}
+bool headerIs(const char *name, const char *value) { // request header equals value
+#ifdef USE_ASYNC_HTTP
+	return !strcmp(server.header(name), value);
+#else
+	return server.header(name) == value;
+#endif
+}
+void reply(int code, const char *type, const char *body, size_t length) { // sends a body from RAM, without copying it into a String
+#ifdef USE_ASYNC_HTTP
+	server.send(code, type, body, length); // copied into the connection, the buffer may go away
+#else
+	server.send_P(code, type, body, length);
+#endif
+}
+void reply(int code, const char *type, JsonWriter& body) {
+	reply(code, type, body.c_str(), body.length());
+}
+void printState(JsonWriter& json) { // {"state":1} while the relay is on
+	json.beginObject().field("state", digitalRead(D4) == ON ? 1 : 0).endObject();
+}
+uint32_t clockSeconds() { // the software clock, a resync from the chip is timed
+	uint32_t syncs = rtc.getSyncCount();
+	uint32_t start = micros();
+	uint32_t t = rtc.getSecondsSince2000();
+	if (rtcReadTime && rtc.getSyncCount() != syncs) rtcReadTime->record(micros() - start);
+	return t;
+}
+void printTime(Print& out) { // "H:MM"
+	DateTime t;
+	fromSecondsSince2000(clockSeconds(), t); // one snapshot, hour and minute can not tear
+	out.print(t.hour);
+	out.print(t.minute < 10 ? ":0" : ":");
+	out.print(t.minute);
+}
+void printScheduler(JsonWriter& json) { // scheduler's configuration directly from EEPROM
 		for (int i = 0; i <= 4; i++) {
 		data[i] = EEPROM.read(i);
 	}
-	String reply = "{\"startHour\":";
-	reply += String(data[0]);
-	reply += ",";
-	reply += "\"startMinute\":";
-	reply += String(data[1]);
-	reply += ",";
-	reply += "\"endHour\":";
-	reply += String(data[2]);
-	reply += ",";
-	reply += "\"endMinute\":";
-	reply += String(data[3]);
-	reply += ",";
-	reply += "\"controleSumm\":";
-	reply += String(data[4]);
-	reply += "}";
-	server.send(200, "application/json", reply);
+	json.beginObject();
+	json.field("startHour", data[0]);
+	json.field("startMinute", data[1]);
+	json.field("endHour", data[2]);
+	json.field("endMinute", data[3]);
+	json.field("controleSumm", data[4]);
+	json.endObject();
+}
+void getSchedulerConfiguration() { // returns scheduler's configuration
+	char buf[96];
+	JsonWriter json(buf, sizeof(buf));
+	printScheduler(json);
+	reply(200, "application/json", json);
+}
+void getStatus() { // relay, time and schedule in one reply, from the cache while nothing changed
+	if (statusCached != statusGeneration) {
+		char time[8];
+		JsonWriter text(time, sizeof(time));
+		printTime(text);
+		JsonWriter json(statusBody, sizeof(statusBody));
+		json.beginObject();
+		json.field("state", digitalRead(D4) == ON ? 1 : 0);
+		json.field("time", text.c_str());
+		json.key("scheduler");
+		printScheduler(json);
+		json.endObject();
+		statusLength = json.length();
+		statusCached = statusGeneration;
+	}
+	reply(200, "application/json", statusBody, statusLength);
 }
 
 void setTime() {
-	int year = atoi(server.arg("year").c_str());
-	int month = atoi(server.arg("month").c_str());
-	int day = atoi(server.arg("day").c_str());
-	int hour = atoi(server.arg("hour").c_str());
-	int minute = atoi(server.arg("minute").c_str());
-	rtc.setYear(year);
-	rtc.setMonth(month);
-	rtc.setDay(day);
-	rtc.setHour(hour);
-	rtc.setMinute(minute);
+	int year = argInt("year");
+	int month = argInt("month");
+	int day = argInt("day");
+	int hour = argInt("hour");
+	int minute = argInt("minute");
+	RtcUpdate update; // one I2C write, or one read and one burst write on the DS1302
+	update.setYear(year).setMonth(month).setDay(day).setHour(hour).setMinute(minute);
+	rtc.commit(update);
+#ifdef USE_SQW
+	sqw.invalidate(); // pollClock() dates the edges again
+#endif
+	statusGeneration++;
+	check = true; // the next transition moved
 	server.send(200);
 }
 void getState() { // returns state of your relay
-	if (digitalRead(D4) == ON) server.send(200, "application/json", "{\"state\":1}");
-	else server.send(200, "application/json", "{\"state\":0}");
+	char buf[16];
+	JsonWriter json(buf, sizeof(buf));
+	printState(json);
+	reply(200, "application/json", json);
 }
 
-void handleRoot() { // shows the main page
-	String mainPage; // // keeps HTML output for main page
-	File f = SPIFFS.open("/index.htm", "r");
-	mainPage = f.readString();
-	server.send(200, "text/html", mainPage);
+#ifdef USE_SPIFFS_PAGE
+char pageTag[11]; // ETags of /index.htm and /index.htm.gz, see tagFile()
+char pageGzTag[11];
+void tagFile(const char *path, char *tag) { // ETag from a hash of the file, the files only change with a new SPIFFS image
+	File f = SPIFFS.open(path, "r");
+	tag[0] = 0;
+	if (!f) return;
+	uint32_t hash = 2166136261UL; // FNV-1a
+	uint8_t buf[128];
+	int n;
+	while ((n = f.read(buf, sizeof(buf))) > 0) {
+		for (int i = 0; i < n; i++) hash = (hash ^ buf[i]) * 16777619UL;
+	}
+	f.close();
+	sprintf(tag, "\"%08x\"", hash);
+}
+void handleRoot() { // streams the main page in chunks, gzipped if the browser takes it, 304 if it has it already
+	bool gzip = pageGzTag[0] && server.header("Accept-Encoding").indexOf("gzip") >= 0;
+	const char *tag = gzip ? pageGzTag : pageTag;
+	server.sendHeader("Cache-Control", "no-cache"); // always revalidate, a new SPIFFS image changes the ETag
+	server.sendHeader("Vary", "Accept-Encoding");
+	if (tag[0]) server.sendHeader("ETag", tag);
+	if (tag[0] && headerIs("If-None-Match", tag)) {
+		server.send(304);
+		return;
+	}
+	File f = SPIFFS.open(gzip ? "/index.htm.gz" : "/index.htm", "r");
+	server.streamFile(f, "text/html"); // adds Content-Encoding: gzip for the .gz file
+	f.close();
+}
+#else
+void handleRoot() { // sends the gzipped page straight from flash, 304 if the browser has it already
+	server.sendHeader("Cache-Control", "no-cache"); // always revalidate, a new firmware changes the ETag
+	server.sendHeader("ETag", INDEX_HTM_ETAG);
+	if (headerIs("If-None-Match", INDEX_HTM_ETAG)) {
+		server.send(304);
+		return;
+	}
+	server.sendHeader("Content-Encoding", "gzip");
+	server.send_P(200, "text/html", (PGM_P)INDEX_HTM_GZ, INDEX_HTM_GZ_LEN);
 }
+#endif
 void switchRelay() {
-	digitalWrite(D4, !digitalRead(D4));
+	setRelay(!digitalRead(D4));
 	server.send(200);
 }
 void getTime() {
-	String reply = String(rtc.getHour());
-	reply += ":";
-	if (rtc.getMinute() < 10) reply += "0";
-	reply += String(rtc.getMinute());
-	server.send(200, "text", reply);
+	char buf[8];
+	JsonWriter text(buf, sizeof(buf));
+	printTime(text);
+	reply(200, "text", text);
+}
+void sendCurrentState(WiFiClient& client) { // first events of a new stream
+	char buf[16];
+	JsonWriter json(buf, sizeof(buf));
+	printState(json);
+	SseServer::send(client, "state", json.c_str());
+	json.reset();
+	printTime(json);
+	SseServer::send(client, "time", json.c_str());
+}
+void pushClock() { // once a minute drops the cached status and sends a clock event to every stream
+	static uint32_t minute = 0;
+	uint32_t now = clockSeconds() / 60;
+	if (now == minute) return;
+	minute = now;
+	statusGeneration++;
+	if (!events.count()) return;
+	char buf[8];
+	JsonWriter text(buf, sizeof(buf));
+	printTime(text);
+	events.broadcast("time", text.c_str());
+}
+class ResponseSink : public Print { // body of the current response in pieces, after setContentLength(CONTENT_LENGTH_UNKNOWN)
+public:
+	size_t write(uint8_t c) { return write(&c, 1); }
+	size_t write(const uint8_t *buffer, size_t size) {
+		server.sendContent_P((PGM_P)buffer, size);
+		return size;
+	}
+};
+void replyParts(int code, const char *type, bool (*content)(Print& out, uint16_t part)) { // a body printed part by part, content() returns false after the last
+#ifdef USE_ASYNC_HTTP
+	server.sendParts(code, type, content); // one part per pass, as the send buffer frees up
+#else
+	ResponseSink sink;
+	char buf[256];
+	JsonWriter out(buf, sizeof(buf), &sink);
+	server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+	server.send(code, type, "");
+	for (uint16_t part = 0; content(out, part); part++);
+	out.flush();
+	server.sendContent(""); // last chunk
+#endif
+}
+bool printMetrics(Print& out, uint16_t part) { // one histogram per part, then the counters and gauges
+	if (metrics.print(out, part)) return true;
+	if (part != metrics.count()) return false;
+	Metrics::printValue(out, "wifipower_checksum_errors_total", "counter", checksumErrors);
+	Metrics::printValue(out, "wifipower_rtc_syncs_total", "counter", rtc.getSyncCount());
+	Metrics::printValue(out, "wifipower_sse_clients", "gauge", events.count());
+	Metrics::printValue(out, "wifipower_free_heap_bytes", "gauge", ESP.getFreeHeap());
+	Metrics::printValue(out, "wifipower_uptime_seconds", "gauge", millis() / 1000);
+	return true;
+}
+void getMetrics() { // Prometheus text format
+	replyParts(200, "text/plain; version=0.0.4", printMetrics);
+}
+void getLoopProfile() { // loop() profile as JSON
+	ResponseSink sink;
+	char buf[128];
+	JsonWriter json(buf, sizeof(buf), &sink);
+	server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+	server.send(200, "application/json", "");
+	json.beginObject();
+	profiler.print(json);
+	json.field("timerLateMs", timerLateMs);
+	json.field("timerLateMaxMs", timerLateMaxMs);
+	json.endObject();
+	json.flush();
+	server.sendContent(""); // last chunk
+}
+void serialCommand() { // "loop" prints the loop() profile, "loop reset" clears it
+	static char line[16];
+	static uint8_t len = 0;
+	while (Serial.available()) {
+		char c = Serial.read();
+		if (c == '\r') continue;
+		if (c != '\n') {
+			if (len < sizeof(line) - 1) line[len++] = c;
+			continue;
+		}
+		line[len] = 0;
+		len = 0;
+		if (!strcmp(line, "loop")) {
+			profiler.print(Serial);
+			Serial.print("timer late ");
+			Serial.print(timerLateMs);
+			Serial.print(" ms, max ");
+			Serial.print(timerLateMaxMs);
+			Serial.println(" ms");
+		} else if (!strcmp(line, "loop reset")) {
+			profiler.reset();
+			timerLateMs = 0;
+			timerLateMaxMs = 0;
+		}
+	}
+}
+void printEntry(JsonWriter& json, uint16_t entry) { // {"day":1,"hour":7,"minute":30,"on":1}, day 0 is Sunday
+	uint16_t m = entry & SCHEDULE_MINUTE;
+	json.beginObject();
+	json.field("day", m / 1440);
+	json.field("hour", m % 1440 / 60);
+	json.field("minute", m % 60);
+	json.field("on", entry & SCHEDULE_ON ? 1 : 0);
+	json.endObject();
+}
+void getSchedule() { // the whole table and the next transition, streamed
+	ResponseSink sink;
+	char buf[128];
+	JsonWriter json(buf, sizeof(buf), &sink);
+	server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+	server.send(200, "application/json", "");
+	json.beginObject();
+	json.field("max", SCHEDULE_MAX_ENTRIES);
+	json.key("entries").beginArray();
+	for (uint16_t i = 0; i < schedule.count(); i++) printEntry(json, schedule[i]);
+	json.endArray();
+	if (schedule.count()) {
+		json.key("next");
+		printEntry(json, schedule[schedule.next(Schedule::minuteOfWeek(clockSeconds()))]);
+	}
+	json.endObject();
+	json.flush();
+	server.sendContent(""); // last chunk
+}
+void saveSchedule() {
+	schedule.save();
+	{
+		MetricTimer timer(eepromCommitTime);
+		EEPROM.commit();
+	}
+	statusGeneration++;
+	planDay = DAY_NONE;
+	check = true; // the next transition may have changed
+}
+void changeSchedule(bool add) { // adds or removes an entry, on every day if day is missing
+	int hour = argInt("hour");
+	int minute = argInt("minute");
+	bool everyDay = !server.hasArg("day");
+	int day = everyDay ? 0 : argInt("day");
+	if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || day < 0 || day > 6) {
+		server.send(400);
+		return;
+	}
+	int last = everyDay ? 6 : day;
+	uint16_t missing = 0; // days without an entry at that time
+	for (int d = day; d <= last; d++) {
+		if (!schedule.contains(Schedule::minuteOfWeek(d, hour, minute))) missing++;
+	}
+	// all days or none: checked before the table changes
+	if (add && schedule.count() + missing > SCHEDULE_MAX_ENTRIES) {
+		server.send(507); // the table is full
+		return;
+	}
+	if (!add && missing) {
+		server.send(404);
+		return;
+	}
+	for (int d = day; d <= last; d++) {
+		uint16_t m = Schedule::minuteOfWeek(d, hour, minute);
+		if (add) schedule.add(m, argInt("on"));
+		else schedule.remove(m);
+	}
+	saveSchedule();
+	server.send(200);
+}
+void addScheduleEntry() { // /api/schedule/add?day=1&hour=7&minute=30&on=1
+	changeSchedule(true);
+}
+void removeScheduleEntry() { // /api/schedule/remove?day=1&hour=7&minute=30
+	changeSchedule(false);
+}
+void clearSchedule() {
+	schedule.clear();
+	saveSchedule();
+	server.send(200);
+}
+void printWindow(JsonWriter& json, uint16_t from, uint16_t to) { // "start":420,"end":1080 in minutes of the day
+	json.field("start", from);
+	json.field("end", to);
+}
+void getRules() { // rules and exceptions, streamed
+	ResponseSink sink;
+	char buf[128];
+	JsonWriter json(buf, sizeof(buf), &sink);
+	server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+	server.send(200, "application/json", "");
+	json.beginObject();
+	json.key("rules").beginArray();
+	for (uint8_t i = 0; i < rules.ruleCount(); i++) {
+		const WeekRule& r = rules.rule(i);
+		json.beginObject();
+		json.field("days", r.days); // bit 0 is Sunday
+		printWindow(json, r.from, r.to);
+		json.endObject();
+	}
+	json.endArray();
+	json.key("exceptions").beginArray();
+	for (uint8_t i = 0; i < rules.exceptionCount(); i++) {
+		const WeekRuleException& e = rules.exception(i);
+		DateTime d = civilFromDays(e.day);
+		char date[16]; // the compiler can not bound the fields, room for their widest values
+		snprintf(date, sizeof(date), "%04u-%02u-%02u", d.year, d.month, d.day);
+		json.beginObject();
+		json.field("date", date);
+		printWindow(json, e.from, e.to); // start == end: off all day
+		json.endObject();
+	}
+	json.endArray();
+	json.endObject();
+	json.flush();
+	server.sendContent(""); // last chunk
+}
+int minuteArg(const char *hour, const char *minute) { // minute of the day from two arguments, 24:00 is the end of the day, -1 if invalid
+	int h = argInt(hour);
+	int m = argInt(minute);
+	if (h == 24 && m == 0) return MINUTES_PER_DAY;
+	if (h < 0 || h > 23 || m < 0 || m > 59) return -1;
+	return h * 60 + m;
+}
+void saveRules() {
+	rules.save();
+	{
+		MetricTimer timer(eepromCommitTime);
+		EEPROM.commit();
+	}
+	statusGeneration++;
+	planDay = DAY_NONE;
+	check = true; // the next transition may have changed
+}
+void addRule() { // /api/rules/add?days=62&startHour=7&startMinute=0&endHour=18&endMinute=0
+	int from = minuteArg("startHour", "startMinute");
+	int to = minuteArg("endHour", "endMinute");
+	int days = argInt("days");
+	if (from < 0 || to < 0 || !WeekRules::validRule(days, from, to)) { // a bad rule is a 400 even when the table is full
+		server.send(400);
+		return;
+	}
+	if (!rules.addRule(days, from, to)) {
+		server.send(507);
+		return;
+	}
+	saveRules();
+	server.send(200);
+}
+void removeRule() { // /api/rules/remove?index=0
+	if (!rules.removeRule(argInt("index"))) {
+		server.send(404);
+		return;
+	}
+	saveRules();
+	server.send(200);
+}
+void addException() { // /api/exceptions/add?year=2026&month=12&day=31[&startHour=18&startMinute=0&endHour=23&endMinute=0], without a window off all day
+	int year = argInt("year");
+	int month = argInt("month");
+	int day = argInt("day");
+	int from = server.hasArg("startHour") ? minuteArg("startHour", "startMinute") : 0;
+	int to = server.hasArg("endHour") ? minuteArg("endHour", "endMinute") : from;
+	if (year < 2000 || year > 2099 || month < 1 || month > 12 || day < 1 || day > monthLength(year, month) || from < 0 || to < 0) {
+		server.send(400);
+		return;
+	}
+	uint16_t date = daysFromCivil(year, month, day);
+	// One of the same date is replaced. Past ones go only to make room, so a wrong clock can not wipe them on its own
+	if (!rules.addException(date, from, to) && !(rules.prune(clockSeconds() / SECONDS_PER_DAY) && rules.addException(date, from, to))) {
+		server.send(507);
+		return;
+	}
+	saveRules();
+	server.send(200);
+}
+void removeException() { // /api/exceptions/remove?index=0
+	if (!rules.removeException(argInt("index"))) {
+		server.send(404);
+		return;
+	}
+	saveRules();
+	server.send(200);
+}
+void compilePlan(uint16_t day) { // the table, the rules and the on/off pair for the given day since 1.1.2000
+	plan.clear();
+	planDay = day;
+	if (rules.excepted(day)) { // the exception alone decides its date
+		rules.resolve(plan, day);
+		planActive = true;
+		return;
+	}
+	plan.compile(schedule, (day + 6) % 7);
+	rules.resolve(plan, day);
+	planActive = schedule.count() || rules.ruleCount() || rules.exceptionCount();
+#ifndef USE_DS3231 // the DS3231 runs the pair from its alarms
+	if (data[0] < 24 && data[1] < 60 && data[2] < 24 && data[3] < 60) {
+		uint16_t from = data[0] * 60 + data[1];
+		uint16_t to = data[2] * 60 + data[3];
+		if (to < from && day > 0 && rules.excepted(day - 1)) to = MINUTES_PER_DAY; // the morning went to yesterday's exception, there is none before 1.1.2000
+		plan.setInterval(from, to); // over midnight if the end is before the start
+		planActive = true;
+	}
+#endif
+}
+void runScheduler(uint32_t now) { // today's plan at the given time
+	uint16_t day = now / SECONDS_PER_DAY;
+	if (day != planDay) compilePlan(day);
+	if (!planActive) return;
+	uint8_t state = plan.get(now % SECONDS_PER_DAY / 60) ? ON : OFF;
+	// Switches only when the plan changed since it last switched, so /switch holds until the next change
+	if (state == hot.plan) return;
+	hot.plan = state;
+	hot.decision = state == ON ? DECISION_ON : DECISION_OFF;
+	setRelay(state);
+}
+uint32_t nextTransition(uint32_t now) { // seconds from now to the next change of today's plan or to midnight, at most SCHEDULER_MAX_SLEEP
+	uint16_t minute = now % SECONDS_PER_DAY / 60;
+	uint32_t wait = (uint32_t)(plan.next(minute) - minute) * 60 - now % 60;
+	return min(wait, (uint32_t)SCHEDULER_MAX_SLEEP);
+}
+void loadScheduler() { // the on/off pair from EEPROM into data[]
+	for (int i = 0; i <= 4; i++) {
+		data[i] = EEPROM.read(i);
+	}
+	if (data[0] + data[1] + data[2] + data[3] != data[4]) {
+		Serial.println("Checksumm error");
+		checksumErrors++;
+	}
 }
 void configSchaduler() {
-	int startHour = atoi(server.arg("startHour").c_str());
-	int startMinute = atoi(server.arg("startMinute").c_str());
-	int endHour = atoi(server.arg("endHour").c_str());
-	int endMinute = atoi(server.arg("endMinute").c_str());
+	int startHour = argInt("startHour");
+	int startMinute = argInt("startMinute");
+	int endHour = argInt("endHour");
+	int endMinute = argInt("endMinute");
 	EEPROM.write(0, startHour);
 	EEPROM.write(1, startMinute);
 	EEPROM.write(2, endHour);
 	EEPROM.write(3, endMinute);
 	int summ = startHour + startMinute + endHour + endMinute; // Controle summ
 	EEPROM.write(4, summ);
-	EEPROM.commit();
+	{
+		MetricTimer timer(eepromCommitTime);
+		EEPROM.commit();
+	}
+	statusGeneration++;
+	loadScheduler();
+#ifdef USE_DS3231
+	armAlarms();
+#else
+	planDay = DAY_NONE;
+	check = true; // the next transition may have changed
+#endif
 	server.send(200);
 }
 void setup() {
@@ -99,35 +652,161 @@ void setup() {
 	Serial.print("Configuring access point...");
 	/// You can remove the password parameter if you want the AP to be open.
 	WiFi.softAP(ssid, password);
-SPIFFS.begin();
-	server.on("/", handleRoot);
-	server.on("/switch", switchRelay);
-server.on("/state", getState);
+#ifdef USE_SPIFFS_PAGE
+	SPIFFS.begin();
+	tagFile("/index.htm", pageTag);
+	tagFile("/index.htm.gz", pageGzTag);
+#endif
+	const char *headers[] = { "If-None-Match", "Accept-Encoding" };
+	server.collectHeaders(headers, 2);
+	handleClientTime = metrics.histogram("wifipower_handle_client_seconds");
+	rtcReadTime = metrics.histogram("wifipower_rtc_read_seconds");
+	eepromCommitTime = metrics.histogram("wifipower_eeprom_commit_seconds");
+	ROUTE("/", handleRoot);
+	ROUTE("/switch", switchRelay);
+	ROUTE("/state", getState);
 	server.on("/config/scheduler", configSchaduler);
 	server.on("/scheduler", getSchedulerConfiguration);
-	server.on("/time/get", getTime);
+	ROUTE("/time/get", getTime);
 	server.on("/time/set", setTime);
+	ROUTE("/api/status", getStatus);
+	server.on("/metrics", getMetrics);
+	server.on("/api/loop", getLoopProfile);
+	server.on("/api/schedule", getSchedule);
+	server.on("/api/schedule/add", addScheduleEntry);
+	server.on("/api/schedule/remove", removeScheduleEntry);
+	server.on("/api/schedule/clear", clearSchedule);
+	server.on("/api/rules", getRules);
+	server.on("/api/rules/add", addRule);
+	server.on("/api/rules/remove", removeRule);
+	server.on("/api/exceptions/add", addException);
+	server.on("/api/exceptions/remove", removeException);
+	profiler.add("http");
+	profiler.add("events");
+	profiler.add("clock");
+	profiler.add("scheduler");
+	profiler.add("serial");
 	server.begin();
+	events.onConnect(sendCurrentState);
+	events.begin();
 	Serial.println("HTTP server started");
-	EEPROM.begin(512);
+	EEPROM.begin(WEEKRULES_EEPROM_ADDR + WEEKRULES_EEPROM_SIZE);
+	if (!schedule.load()) Serial.println("No schedule table");
+	if (!rules.load()) Serial.println("No weekday rules");
+	loadScheduler();
 	// Configuring RTC
+#ifdef USE_DS3231
+	Wire.begin();
+	rtc.begin();
+	armAlarms();
+	pinMode(RTC_INT, INPUT_PULLUP); // INT is open drain
+#ifdef USE_SQW
+	attachInterrupt(digitalPinToInterrupt(RTC_INT), ISRSqw, FALLING);
+#else
+	attachInterrupt(digitalPinToInterrupt(RTC_INT), ISRAlarm, FALLING);
+#endif
+#else
 	rtc.begin();
-	tk.attach(5, ISRTimer); // Every 30 seconds interruption will be generating. DSee function 'ISRTimer'
+	rtc.setAutoSync(false); // see pollClock()
+	if (hotStore.load(hot)) digitalWrite(D4, hot.relay); // restore the relay right away, before the scheduler runs
+	hot.boots++;
+	hotStore.save(hot);
+	Serial.print("Boot #");
+	Serial.println(hot.boots);
+#endif
 }
+#ifdef USE_DS3231
+#ifdef USE_SQW
+void pollClock() { // dates the SQW edges once, then polls the alarm flags once a minute without an interrupt
+	static uint32_t minute = 0;
+	if (!sqw.synced()) {
+		MetricTimer timer(rtcReadTime);
+		sqw.sync(rtcChip);
+		return;
+	}
+	uint32_t t = sqw.getSecondsSince2000() - 1; // one second after the alarm set its flag
+	if (t / 60 != minute) {
+		minute = t / 60;
+		alarmed = true;
+	}
+}
+#else
+void pollClock() { // the I2C read can not be split, CachedRtc resyncs by itself
+}
+#endif
+void checkAlarms() { // the scheduler with a DS3231, runs only when an alarm fired
+	if (!alarmed) return;
+	alarmed = false;
+	uint8_t fired = rtcChip.clearAlarms();
+	if (rules.excepted(clockSeconds() / SECONDS_PER_DAY)) return; // the exception of today decides, see compilePlan()
+	if (fired & DS3231_ALARM1) {
+		hot.decision = DECISION_ON;
+		setRelay(ON);
+	}
+	if (fired & DS3231_ALARM2) {
+		hot.decision = DECISION_OFF;
+		setRelay(OFF);
+	}
+}
+#else
+void checkAlarms() {
+}
+void pollClock() { // resyncs the software clock a few bits per pass, so handleClient() never waits for a whole burst
+	if (rtc.syncDue()) rtcChip.beginNow();
+	if (!rtcChip.busy()) return;
+	uint32_t start = micros();
+	bool done = rtcChip.poll();
+	if (rtcReadTime) rtcReadTime->record(micros() - start); // one slice of the read
+	if (done) {
+		DateTime t;
+		uint32_t at = rtcChip.startedAt();
+		rtcChip.result(t);
+		rtc.sync(t, at);
+	}
+}
+#endif
 void loop() {
-	server.handleClient();
-	if (check) {
+	profiler.start();
+	{
+		MetricTimer timer(handleClientTime);
+		server.handleClient();
+	}
+	profiler.mark(SECTION_HTTP);
+	events.handle();
+	profiler.mark(SECTION_EVENTS);
+	pollClock();
+	pushClock();
+	profiler.mark(SECTION_CLOCK);
+	checkAlarms();
+	if (timerFired) { // how long the transition waited for this pass
+		timerFired = false;
+		timerLateMs = millis() - timerDue;
+		if (timerLateMs > timerLateMaxMs) timerLateMaxMs = timerLateMs;
+	}
+	if (check) { // a transition is due, or the schedule or the clock changed
 		check = false;
-		for (int i = 0; i <= 4; i++) {
-			data[i] = EEPROM.read(i);
-		}
-		if (data[0] + data[1] + data[2] + data[3] != data[4]) Serial.println("Checksumm error");
-		if (rtc.getHour() == data[0] && rtc.getMinute() == data[1]) digitalWrite(D4, ON);
-		if (rtc.getHour() >= data[2] && rtc.getMinute() >= data[3]) digitalWrite(D4, OFF);
+		uint32_t now = clockSeconds(); // one snapshot for the decision and the next wakeup
+		runScheduler(now);
+		uint32_t sleep = nextTransition(now) * 1000;
+		tk.once_ms(sleep, ISRTimer); // replaces a timer still armed
+		timerDue = millis() + sleep;
 	}
+	profiler.mark(SECTION_SCHEDULER);
+	serialCommand();
+	profiler.mark(SECTION_SERIAL);
+	profiler.end();
 }
 
 // interruption handlers
 void ISRTimer() {
+	timerFired = true;
 	check = true;
-}
\ No newline at end of file
+}
+void ICACHE_RAM_ATTR ISRAlarm() {
+	alarmed = true;
+}
+#ifdef USE_SQW
+void ICACHE_RAM_ATTR ISRSqw() {
+	sqw.edge();
+}
+#endif
\ No newline at end of file